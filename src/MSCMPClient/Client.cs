@@ -140,14 +140,10 @@ namespace MSCMP
 		}
 
 		/// <summary>
-		/// Initializes logger.
+		/// Gets path to the mod folder in local app data, creating it if needed.
 		/// </summary>
-		/// <returns>true if logger initialization has succeeded, false otherwise</returns>
-		static private bool SetupLogger() {
-			string logPath;
-
-			// First try create clientLog in app data.
-
+		/// <returns>Path to the MSCMP app data folder or null if it cannot be created.</returns>
+		public static string GetAppDataPath() {
 			string appData = Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData);
 			string mscmpData = appData + "/MSCMP";
 			bool mscmpDataExists = Directory.Exists(mscmpData);
@@ -156,11 +152,23 @@ namespace MSCMP
 					mscmpDataExists = Directory.CreateDirectory(mscmpData).Exists;
 				}
 				catch {
-					// Nothing.. let us fallback below.
+					// Nothing.. caller has to fallback.
 				}
 			}
+			return mscmpDataExists ? mscmpData : null;
+		}
+
+		/// <summary>
+		/// Initializes logger.
+		/// </summary>
+		/// <returns>true if logger initialization has succeeded, false otherwise</returns>
+		static private bool SetupLogger() {
+			string logPath;
+
+			// First try create clientLog in app data.
 
-			if (mscmpDataExists) {
+			string mscmpData = GetAppDataPath();
+			if (mscmpData != null) {
 				logPath = mscmpData + "/clientLog.txt";
 				if (Logger.SetupLogger(logPath)) {
 					return true;
@@ -55,6 +55,18 @@ namespace MSCMP {
 				Client.ConsoleMessage($"   goto [gameObjectName]");
 				Client.ConsoleMessage($"   gotoxyz [x] [y] [z] [Optional: Rotation]");
 				Client.ConsoleMessage($"   savepos");
+				Client.ConsoleMessage($"   netstats_history [frames]");
+				Client.ConsoleMessage($"   metrics [start|stop|serve|unserve|status]");
+				Client.ConsoleMessage($"   netsim [on|off|seed|set|load|save|status]");
+				Client.ConsoleMessage($"   capture [start [file]|stop|status]");
+				Client.ConsoleMessage($"   periodicsync [period [type] [seconds]|max [count]|status]");
+				Client.ConsoleMessage($"   objsync [pos|angle|heartbeat] [value]");
+				Client.ConsoleMessage($"   bench_objectlookup [objects]");
+				Client.ConsoleMessage($"   bench_interpolation [send rate]");
+				Client.ConsoleMessage($"   bench_interpolation_batch [entities]");
+				Client.ConsoleMessage($"   bench_player_sync [budget]");
+				Client.ConsoleMessage($"   bench_anim [characters]");
+				Client.ConsoleMessage($"   sim_ownership [players] [rounds] [seed]");
 			});
 
 			//Teleports yourself to the given spot
@@ -161,6 +173,205 @@ namespace MSCMP {
 				Logger.Log($"Rot: {localPlayer.transform.eulerAngles}");
 				Client.ConsoleMessage("Saved your position!");
 			});
+
+			//Changes how many frames are kept in the network statistics history
+			UI.Console.RegisterCommand("netstats_history", (string[] args) => {
+				int frames = 0;
+				if (args.Length < 2 || !int.TryParse(args[1], out frames) || frames < 1) {
+					Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'netstats_history [frames]'.");
+					return;
+				}
+
+				if (Network.NetManager.Instance == null) {
+					Client.ConsoleMessage("ERROR: Network manager is not running.");
+					return;
+				}
+
+				Network.NetManager.Instance.Statistics.SetHistorySize(frames);
+				Client.ConsoleMessage($"Network statistics history set to {frames} frames.");
+			});
+
+			//Controls export of the network metrics for soak tests
+			UI.Console.RegisterCommand("metrics", (string[] args) => {
+				if (Network.NetManager.Instance == null) {
+					Client.ConsoleMessage("ERROR: Network manager is not running.");
+					return;
+				}
+
+				var metrics = Network.NetManager.Instance.Metrics;
+				string action = args.Length > 1 ? args[1].ToLower() : "status";
+				if (action == "start") {
+					var format = Network.MetricsExporter.Format.Prometheus;
+					float interval = Network.MetricsExporter.DEFAULT_INTERVAL;
+					if ((args.Length > 2 && !Network.MetricsExporter.ParseFormat(args[2], out format)) || (args.Length > 3 && !float.TryParse(args[3], out interval))) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'metrics start [prometheus|json] [interval seconds]'.");
+						return;
+					}
+					metrics.Start(format, interval);
+				}
+				else if (action == "stop") {
+					metrics.Stop();
+					Client.ConsoleMessage("Metrics export stopped.");
+				}
+				else if (action == "serve") {
+					int port = 9465;
+					if (args.Length > 2 && !int.TryParse(args[2], out port)) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'metrics serve [port]'.");
+						return;
+					}
+					metrics.Serve(port);
+				}
+				else if (action == "unserve") {
+					metrics.StopServing();
+					Client.ConsoleMessage("Metrics endpoint stopped.");
+				}
+				else {
+					Client.ConsoleMessage($"Metrics export: {(metrics.IsExporting ? "on" : "off")}, endpoint: {(metrics.IsServing ? "on" : "off")}");
+				}
+			});
+
+			//Controls the network condition simulator
+			UI.Console.RegisterCommand("netsim", (string[] args) => {
+				if (Network.NetManager.Instance == null) {
+					Client.ConsoleMessage("ERROR: Network manager is not running.");
+					return;
+				}
+
+				var conditioner = Network.NetManager.Instance.Conditioner;
+				string action = args.Length > 1 ? args[1].ToLower() : "status";
+				if (action == "on" || action == "off") {
+					conditioner.Enabled = action == "on";
+				}
+				else if (action == "seed") {
+					if (args.Length < 3 || !conditioner.SetParameter("seed", args[2])) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'netsim seed [number]'.");
+						return;
+					}
+				}
+				else if (action == "set") {
+					if (args.Length < 4 || !conditioner.SetParameter(args[2], args[3])) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'netsim set [in|out|both].[latency|jitter|dist|loss|burst_enter|burst_exit|burst_loss|reorder|reorder_delay|dup] [value]'.");
+						return;
+					}
+				}
+				else if (action == "load" || action == "save") {
+					string path = args.Length > 2 ? args[2] : Client.GetAppDataPath() + "/" + Network.NetManager.CONDITIONER_CONFIG_FILE;
+					bool result = action == "load" ? conditioner.LoadConfig(path) : conditioner.SaveConfig(path);
+					if (!result) {
+						return;
+					}
+					Client.ConsoleMessage($"Network conditioner config {(action == "load" ? "loaded from" : "saved to")} {path}.");
+				}
+
+				Client.ConsoleMessage($"Network conditioner: {(conditioner.Enabled ? "on" : "off")}, seed {conditioner.Seed}");
+				Client.ConsoleMessage($"  out: {Network.NetConditioner.Describe(conditioner.Outgoing)}");
+				Client.ConsoleMessage($"  in: {Network.NetConditioner.Describe(conditioner.Incoming)}");
+			});
+
+			//Controls capture of the network packets
+			UI.Console.RegisterCommand("capture", (string[] args) => {
+				var netManager = Network.NetManager.Instance;
+				if (netManager == null) {
+					Client.ConsoleMessage("ERROR: Network manager is not running.");
+					return;
+				}
+
+				string action = args.Length > 1 ? args[1].ToLower() : "status";
+				if (action == "start") {
+					netManager.StartCapture(args.Length > 2 ? args[2] : null);
+				}
+				else if (action == "stop") {
+					netManager.StopCapture();
+				}
+				else if (netManager.Capture != null) {
+					Client.ConsoleMessage($"Capturing to {netManager.Capture.FilePath}, {netManager.Capture.PacketsCaptured} packets, {netManager.Capture.BytesCaptured} bytes.");
+				}
+				else {
+					Client.ConsoleMessage("Network capture is not running.");
+				}
+			});
+
+			//Tunes the periodic object sync scheduler and shows its statistics
+			UI.Console.RegisterCommand("periodicsync", (string[] args) => {
+				if (Game.ObjectSyncManager.Instance == null) {
+					Client.ConsoleMessage("ERROR: Object sync manager is not running.");
+					return;
+				}
+
+				var scheduler = Game.ObjectSyncManager.Instance.PeriodicSync;
+				string action = args.Length > 1 ? args[1].ToLower() : "status";
+				if (action == "period") {
+					Game.ObjectSyncManager.ObjectTypes type = Game.ObjectSyncManager.ObjectTypes.Pickupable;
+					float seconds = 0.0f;
+					bool validType = args.Length > 2 && Enum.GetNames(typeof(Game.ObjectSyncManager.ObjectTypes)).Any(name => name.Equals(args[2], StringComparison.OrdinalIgnoreCase));
+					if (!validType || args.Length < 4 || !float.TryParse(args[3], out seconds) || seconds < 0.0f) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'periodicsync period [{string.Join("|", Enum.GetNames(typeof(Game.ObjectSyncManager.ObjectTypes)))}] [seconds]'.");
+						return;
+					}
+					type = (Game.ObjectSyncManager.ObjectTypes)Enum.Parse(typeof(Game.ObjectSyncManager.ObjectTypes), args[2], true);
+					scheduler.SetPeriod((int)type, seconds);
+				}
+				else if (action == "max") {
+					int count = 0;
+					if (args.Length < 3 || !int.TryParse(args[2], out count) || count < 1) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'periodicsync max [count]'.");
+						return;
+					}
+					scheduler.MaxPerFrame = count;
+				}
+
+				Client.ConsoleMessage($"Periodic sync: {scheduler.Count} objects, max {scheduler.MaxPerFrame} per frame, visited last frame {scheduler.VisitedLastFrame}");
+				Client.ConsoleMessage($"  scheduled {scheduler.Scheduled}, sent {scheduler.Sent}, skipped {scheduler.Skipped}, deferred {scheduler.Deferred}");
+				foreach (Game.ObjectSyncManager.ObjectTypes type in Enum.GetValues(typeof(Game.ObjectSyncManager.ObjectTypes))) {
+					float period = scheduler.GetPeriod((int)type);
+					Client.ConsoleMessage($"  {type}: {(period > 0.0f ? $"every {period} s" : "off")}");
+				}
+			});
+
+			//Tunes the error thresholds of the object sync system and shows its statistics
+			UI.Console.RegisterCommand("objsync", (string[] args) => {
+				if (Game.ObjectSyncManager.Instance == null) {
+					Client.ConsoleMessage("ERROR: Object sync manager is not running.");
+					return;
+				}
+
+				var syncSystem = Game.ObjectSyncManager.Instance.SyncSystem;
+				if (args.Length > 1) {
+					float value = 0.0f;
+					if (args.Length < 3 || !float.TryParse(args[2], out value) || value < 0.0f) {
+						Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'objsync [pos|angle|heartbeat] [value]'.");
+						return;
+					}
+
+					switch (args[1].ToLower()) {
+						case "pos": {
+							syncSystem.PositionErrorThreshold = value;
+							break;
+						}
+						case "angle": {
+							syncSystem.AngleErrorThreshold = value;
+							break;
+						}
+						case "heartbeat": {
+							syncSystem.HeartbeatInterval = value;
+							break;
+						}
+						default: {
+							Client.ConsoleMessage($"ERROR: Invalid syntax. Use 'objsync [pos|angle|heartbeat] [value]'.");
+							return;
+						}
+					}
+				}
+
+				Client.ConsoleMessage($"Object sync: {syncSystem.Count} objects synced locally, sent {syncSystem.SentLastFrame} in {syncSystem.SnapshotsLastFrame} snapshots last frame");
+				Client.ConsoleMessage($"  thresholds: {syncSystem.PositionErrorThreshold} m, {syncSystem.AngleErrorThreshold} deg, heartbeat {syncSystem.HeartbeatInterval} s");
+				Client.ConsoleMessage($"  sends: error {syncSystem.ErrorSends}, heartbeat {syncSystem.HeartbeatSends}, requested {syncSystem.RequestedSends}, at rest {syncSystem.AtRestSends}");
+				Client.ConsoleMessage($"  objects at rest: {syncSystem.AtRestLastFrame}");
+				Client.ConsoleMessage($"  remote objects blending: {Game.ObjectSyncManager.Instance.Receiver.ActiveCount}");
+			});
+
+			Development.Benchmarks.RegisterCommands();
+			Development.OwnershipSimulation.RegisterCommands();
 		}
 
 		public static void OnGUI() {
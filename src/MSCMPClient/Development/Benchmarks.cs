@@ -0,0 +1,584 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using MSCMP.Game;
+using MSCMP.Game.Components;
+using MSCMP.Math;
+using UnityEngine;
+
+namespace MSCMP.Development {
+#if !PUBLIC_RELEASE
+	/// <summary>
+	/// Micro benchmarks of the multiplayer hot paths. Run from the dev console.
+	/// </summary>
+	static class Benchmarks {
+
+		/// <summary>
+		/// Register benchmark console commands.
+		/// </summary>
+		public static void RegisterCommands() {
+			UI.Console.RegisterCommand("bench_objectlookup", (string[] args) => {
+				int count = 0;
+				if (args.Length > 1) {
+					if (!int.TryParse(args[1], out count) || count < 1) {
+						Client.ConsoleMessage("ERROR: Invalid syntax. Use 'bench_objectlookup [objects]'.");
+						return;
+					}
+					ObjectLookup(count);
+				}
+				else {
+					ObjectLookup(1000);
+					ObjectLookup(10000);
+				}
+			});
+
+			UI.Console.RegisterCommand("bench_interpolation", (string[] args) => {
+				int rate = 0;
+				if (args.Length > 1) {
+					if (!int.TryParse(args[1], out rate) || rate < 1 || rate > 60) {
+						Client.ConsoleMessage("ERROR: Invalid syntax. Use 'bench_interpolation [send rate 1-60]'.");
+						return;
+					}
+					InterpolationError(rate);
+				}
+				else {
+					InterpolationError(5);
+					InterpolationError(10);
+					InterpolationError(20);
+					InterpolationError(30);
+				}
+			});
+
+			UI.Console.RegisterCommand("bench_interpolation_batch", (string[] args) => {
+				int count = 0;
+				if (args.Length > 1) {
+					if (!int.TryParse(args[1], out count) || count < 1) {
+						Client.ConsoleMessage("ERROR: Invalid syntax. Use 'bench_interpolation_batch [entities]'.");
+						return;
+					}
+					InterpolationBatch(count);
+				}
+				else {
+					InterpolationBatch(1000);
+					InterpolationBatch(10000);
+				}
+			});
+
+			UI.Console.RegisterCommand("bench_player_sync", (string[] args) => {
+				float budget = Network.NetLocalPlayer.PLAYER_SYNC_BUDGET;
+				if (args.Length > 1 && (!float.TryParse(args[1], out budget) || budget <= 0.0f)) {
+					Client.ConsoleMessage("ERROR: Invalid syntax. Use 'bench_player_sync [budget in bytes per second]'.");
+					return;
+				}
+				for (int session = 0; session < SESSION_NAMES.Length; ++session) {
+					PlayerSyncBandwidth(session, budget);
+				}
+			});
+
+			UI.Console.RegisterCommand("bench_anim", (string[] args) => {
+				int count = 0;
+				if (args.Length > 1) {
+					if (!int.TryParse(args[1], out count) || count < 1) {
+						Client.ConsoleMessage("ERROR: Invalid syntax. Use 'bench_anim [characters]'.");
+						return;
+					}
+					AnimationControllers(count);
+				}
+				else {
+					AnimationControllers(1);
+					AnimationControllers(16);
+				}
+			});
+		}
+
+		/// <summary>
+		/// Convert stopwatch ticks to microseconds per operation.
+		/// </summary>
+		/// <param name="ticks">The ticks.</param>
+		/// <param name="operations">Amount of operations done in the ticks.</param>
+		/// <returns>Microseconds per operation.</returns>
+		static double MicrosecondsPerOperation(long ticks, int operations) {
+			return ticks * 1000000.0 / Stopwatch.Frequency / operations;
+		}
+
+		/// <summary>
+		/// Compare linear scan of the synced objects with ObjectSyncIndex lookups.
+		/// </summary>
+		/// <param name="count">Amount of registered objects.</param>
+		static void ObjectLookup(int count) {
+			const int PREFAB_COUNT = 100;
+			const int LOOKUPS = 1000;
+
+			// Objects are created under inactive root so the components never wake up and never register to the real manager.
+			var root = new GameObject("BenchmarkRoot");
+			root.SetActive(false);
+
+			var gameObjects = new GameObject[count];
+			var objects = new List<ObjectSyncComponent>(count);
+			var index = new ObjectSyncIndex();
+			for (int i = 0; i < count; ++i) {
+				var go = new GameObject("BenchmarkObject");
+				go.transform.parent = root.transform;
+				go.AddComponent<PickupableMetaDataComponent>().prefabId = i % PREFAB_COUNT;
+				var osc = go.AddComponent<ObjectSyncComponent>();
+
+				gameObjects[i] = go;
+				objects.Add(osc);
+			}
+
+			var watch = Stopwatch.StartNew();
+			foreach (ObjectSyncComponent osc in objects) {
+				index.Add(osc);
+			}
+			long buildTicks = watch.ElapsedTicks;
+
+			var random = new System.Random(count);
+			var targets = new GameObject[LOOKUPS];
+			var prefabs = new int[LOOKUPS];
+			for (int i = 0; i < LOOKUPS; ++i) {
+				targets[i] = gameObjects[random.Next(count)];
+				prefabs[i] = random.Next(PREFAB_COUNT);
+			}
+
+			// Linear scan as done by NetWorld.GetPickupableByGameObject before the index.
+			int found = 0;
+			watch = Stopwatch.StartNew();
+			for (int i = 0; i < LOOKUPS; ++i) {
+				foreach (ObjectSyncComponent osc in objects) {
+					if (osc.gameObject == targets[i]) {
+						found++;
+						break;
+					}
+				}
+			}
+			long scanTicks = watch.ElapsedTicks;
+
+			watch = Stopwatch.StartNew();
+			for (int i = 0; i < LOOKUPS; ++i) {
+				if (index.GetByGameObject(targets[i]) != null) {
+					found++;
+				}
+			}
+			long indexTicks = watch.ElapsedTicks;
+
+			// Prefab scan as done by NetWorld.SpawnPickupable on prefab mismatch before the index.
+			watch = Stopwatch.StartNew();
+			for (int i = 0; i < LOOKUPS; ++i) {
+				foreach (ObjectSyncComponent osc in objects) {
+					if (osc.gameObject.GetComponent<PickupableMetaDataComponent>().prefabId == prefabs[i]) {
+						found++;
+						break;
+					}
+				}
+			}
+			long prefabScanTicks = watch.ElapsedTicks;
+
+			watch = Stopwatch.StartNew();
+			for (int i = 0; i < LOOKUPS; ++i) {
+				if (index.GetAnyByPrefab(prefabs[i]) != null) {
+					found++;
+				}
+			}
+			long prefabIndexTicks = watch.ElapsedTicks;
+
+			GameObject.Destroy(root);
+
+			Client.ConsoleMessage($"Object lookup, {count} objects, {LOOKUPS} lookups (found {found}/{LOOKUPS * 4}), index built in {MicrosecondsPerOperation(buildTicks, 1):0} us");
+			Client.ConsoleMessage($"  by game object: scan {MicrosecondsPerOperation(scanTicks, LOOKUPS):0.00} us, index {MicrosecondsPerOperation(indexTicks, LOOKUPS):0.000} us");
+			Client.ConsoleMessage($"  by prefab: scan {MicrosecondsPerOperation(prefabScanTicks, LOOKUPS):0.00} us, index {MicrosecondsPerOperation(prefabIndexTicks, LOOKUPS):0.000} us");
+		}
+
+		/// <summary>
+		/// Ground truth paths used to measure the interpolation error.
+		/// </summary>
+		static readonly string[] PATH_NAMES = { "circle", "slalom" };
+
+		/// <summary>
+		/// Sample the ground truth path. The object always faces the direction of movement.
+		/// </summary>
+		/// <param name="path">Index of the path. (See PATH_NAMES)</param>
+		/// <param name="seconds">Time on the path.</param>
+		/// <param name="position">Position on the path.</param>
+		/// <param name="rotation">Rotation on the path.</param>
+		static void SamplePath(int path, double seconds, out Vector3 position, out Quaternion rotation) {
+			double heading;
+			if (path == 0) {
+				// Car cornering, 15 m radius at 12 m/s.
+				const double RADIUS = 15.0;
+				double angle = seconds * 12.0 / RADIUS;
+				position = new Vector3((float)(RADIUS * System.Math.Sin(angle)), 0.0f, (float)(RADIUS * System.Math.Cos(angle)));
+				heading = angle + System.Math.PI / 2.0;
+			}
+			else {
+				// Slalom at 10 m/s, 3 m amplitude, one cone every second.
+				double phase = seconds * System.Math.PI;
+				position = new Vector3((float)(3.0 * System.Math.Sin(phase)), 0.0f, (float)(seconds * 10.0));
+				heading = System.Math.Atan2(3.0 * System.Math.PI * System.Math.Cos(phase), 10.0);
+			}
+			rotation = Quaternion.Euler(0.0f, (float)(heading * 180.0 / System.Math.PI), 0.0f);
+		}
+
+		/// <summary>
+		/// Measure the error of the interpolated trajectory against the ground truth paths.
+		/// </summary>
+		/// <param name="rate">Send rate in Hz.</param>
+		static void InterpolationError(int rate) {
+			const long DURATION = 25000;
+			const long WARMUP = 5000;
+			const long FRAME_TIME = 16;
+			const long TRANSIT_TIME = 30;
+			long sendInterval = 1000 / rate;
+
+			Client.ConsoleMessage($"Interpolation error at {rate} Hz (position rms/max cm, rotation rms/max deg)");
+			for (int path = 0; path < PATH_NAMES.Length; ++path) {
+				string result = $"  {PATH_NAMES[path]}:";
+				foreach (SnapshotBuffer.InterpolationMode mode in new SnapshotBuffer.InterpolationMode[] { SnapshotBuffer.InterpolationMode.Linear, SnapshotBuffer.InterpolationMode.Hermite }) {
+					var buffer = new SnapshotBuffer();
+					buffer.Interpolation = mode;
+
+					double positionSquares = 0.0, positionMax = 0.0, rotationSquares = 0.0, rotationMax = 0.0;
+					int samples = 0;
+					long nextSend = 0;
+					for (long now = 0; now < DURATION; now += FRAME_TIME) {
+						while (nextSend + TRANSIT_TIME <= now) {
+							Vector3 sentPosition;
+							Quaternion sentRotation;
+							SamplePath(path, nextSend / 1000.0, out sentPosition, out sentRotation);
+							buffer.Add((ulong)nextSend, (ulong)(nextSend + TRANSIT_TIME), sentPosition, sentRotation);
+							nextSend += sendInterval;
+						}
+
+						Vector3 position;
+						Quaternion rotation;
+						if (!buffer.Sample((ulong)now, out position, out rotation) || now < WARMUP) {
+							continue;
+						}
+						Vector3 truePosition;
+						Quaternion trueRotation;
+						SamplePath(path, buffer.PlaybackTime / 1000.0, out truePosition, out trueRotation);
+
+						double positionError = (position - truePosition).magnitude * 100.0;
+						double rotationError = Quaternion.Angle(rotation, trueRotation);
+						positionSquares += positionError * positionError;
+						rotationSquares += rotationError * rotationError;
+						positionMax = System.Math.Max(positionMax, positionError);
+						rotationMax = System.Math.Max(rotationMax, rotationError);
+						samples++;
+					}
+
+					result += $" {mode.ToString().ToLower()} {System.Math.Sqrt(positionSquares / samples):0.0}/{positionMax:0.0} cm {System.Math.Sqrt(rotationSquares / samples):0.00}/{rotationMax:0.00} deg";
+				}
+				Client.ConsoleMessage(result);
+			}
+		}
+
+		/// <summary>
+		/// Compare evaluation of the interpolators one by one with the TransformInterpolationSystem.
+		/// </summary>
+		/// <param name="count">Amount of interpolated entities.</param>
+		static void InterpolationBatch(int count) {
+			const long DURATION = 3000;
+			const long WARMUP = 1000;
+			const long FRAME_TIME = 16;
+			const long SEND_INTERVAL = 100;
+
+			var single = new TransformInterpolator[count];
+			var batched = new TransformInterpolator[count];
+			var system = new TransformInterpolationSystem();
+			for (int i = 0; i < count; ++i) {
+				single[i] = new TransformInterpolator();
+				batched[i] = new TransformInterpolator();
+				system.Add(batched[i]);
+			}
+
+			long singleTicks = 0, batchedTicks = 0;
+			int frames = 0;
+			long nextSend = 0;
+			for (long now = 0; now < DURATION; now += FRAME_TIME) {
+				while (nextSend <= now) {
+					for (int i = 0; i < count; ++i) {
+						Vector3 position;
+						Quaternion rotation;
+						SamplePath(i & 1, nextSend / 1000.0 + i, out position, out rotation);
+						single[i].AddSnapshot((ulong)nextSend, (ulong)now, position, rotation);
+						batched[i].AddSnapshot((ulong)nextSend, (ulong)now, position, rotation);
+					}
+					nextSend += SEND_INTERVAL;
+				}
+
+				var watch = Stopwatch.StartNew();
+				for (int i = 0; i < count; ++i) {
+					single[i].Evaluate((ulong)now);
+				}
+				long frameSingleTicks = watch.ElapsedTicks;
+
+				watch = Stopwatch.StartNew();
+				system.Evaluate((ulong)now);
+				long frameBatchedTicks = watch.ElapsedTicks;
+
+				if (now >= WARMUP) {
+					singleTicks += frameSingleTicks;
+					batchedTicks += frameBatchedTicks;
+					frames++;
+				}
+			}
+
+			// Both paths must produce the same transforms.
+			float maxDifference = 0.0f;
+			for (int i = 0; i < count; ++i) {
+				maxDifference = Mathf.Max(maxDifference, (single[i].CurrentPosition - batched[i].CurrentPosition).magnitude);
+			}
+
+			Client.ConsoleMessage($"Interpolation, {count} entities, {frames} frames (max difference {maxDifference * 1000.0f:0.000} mm)");
+			Client.ConsoleMessage($"  one by one: {MicrosecondsPerOperation(singleTicks, frames):0} us per frame, batched: {MicrosecondsPerOperation(batchedTicks, frames):0} us per frame");
+		}
+
+		/// <summary>
+		/// Synthetic play sessions used to measure the player sync bandwidth.
+		/// </summary>
+		static readonly string[] SESSION_NAMES = { "garage", "walking", "sprinting", "mixed" };
+
+		/// <summary>
+		/// Share of the session time spent by the activities. (Idle, looking around, walking, sprinting)
+		/// </summary>
+		static readonly float[][] SESSION_ACTIVITIES = {
+			new float[] { 0.8f, 0.2f, 0.0f, 0.0f },
+			new float[] { 0.0f, 0.0f, 1.0f, 0.0f },
+			new float[] { 0.0f, 0.0f, 0.0f, 1.0f },
+			new float[] { 0.4f, 0.1f, 0.35f, 0.15f },
+		};
+
+		/// <summary>
+		/// Speed in m/s and maximum turning rate in deg/s of the activities.
+		/// </summary>
+		static readonly float[] ACTIVITY_SPEEDS = { 0.0f, 0.0f, 1.4f, 5.0f };
+		static readonly float[] ACTIVITY_TURN_RATES = { 0.0f, 90.0f, 30.0f, 120.0f };
+
+		/// <summary>
+		/// Size of the message header in bytes. (Protocol id and message id, see NetManager.WriteMessage)
+		/// </summary>
+		const int MESSAGE_HEADER_SIZE = 5;
+
+		/// <summary>
+		/// Compare the bandwidth and the interpolation error of the fixed rate player sync with the
+		/// SyncRateController on the synthetic play session.
+		/// </summary>
+		/// <param name="session">Index of the session. (See SESSION_NAMES)</param>
+		/// <param name="budget">Budget of the controller in bytes per second.</param>
+		static void PlayerSyncBandwidth(int session, float budget) {
+			const long DURATION = 300000;
+			const long WARMUP = 5000;
+			const long FRAME_TIME = 16;
+			const long TRANSIT_TIME = 30;
+			const int MAX_TRANSIT_JITTER = 20;
+			const ulong FIXED_INTERVAL = 100;
+
+			// Simulate the player, activity changes every few seconds and the turning rate every half second.
+			var random = new System.Random(session + 1);
+			int frameCount = (int)(DURATION / FRAME_TIME) + 1;
+			var positions = new Vector3[frameCount];
+			var headings = new float[frameCount];
+			Vector3 position = Vector3.zero;
+			float heading = 0.0f;
+			int activity = 0;
+			float turnRate = 0.0f;
+			long activityEnd = 0, turnEnd = 0;
+			for (int frame = 0; frame < frameCount; ++frame) {
+				long now = frame * FRAME_TIME;
+				if (now >= activityEnd) {
+					float pick = (float)random.NextDouble();
+					for (activity = 0; activity < SESSION_ACTIVITIES[session].Length - 1; ++activity) {
+						pick -= SESSION_ACTIVITIES[session][activity];
+						if (pick < 0.0f) {
+							break;
+						}
+					}
+					activityEnd = now + random.Next(2000, 10000);
+				}
+				if (now >= turnEnd) {
+					turnRate = ACTIVITY_TURN_RATES[activity] * (float)(random.NextDouble() * 2.0 - 1.0);
+					turnEnd = now + 500;
+				}
+				heading += turnRate * FRAME_TIME / 1000.0f;
+				position += Quaternion.Euler(0.0f, heading, 0.0f) * Vector3.forward * (ACTIVITY_SPEEDS[activity] * FRAME_TIME / 1000.0f);
+				positions[frame] = position;
+				headings[frame] = heading;
+			}
+
+			var message = new Network.Messages.PlayerSyncMessage();
+			message.position = Utils.GameVec3ToNet(Vector3.zero);
+			message.rotation = Utils.GameQuatToNet(Quaternion.identity);
+			message.tick = 0;
+			var stream = new System.IO.MemoryStream();
+			message.Write(new System.IO.BinaryWriter(stream));
+			long messageSize = stream.Length + MESSAGE_HEADER_SIZE;
+
+			Client.ConsoleMessage($"Player sync, {SESSION_NAMES[session]} session, {DURATION / 1000} s, {messageSize} bytes per message (position rms/max cm, rotation rms deg)");
+			for (int adaptive = 0; adaptive < 2; ++adaptive) {
+				var controller = new Network.SyncRateController(budget);
+				var buffer = new SnapshotBuffer();
+				var transit = new System.Random(session + 1);
+				var inFlight = new List<KeyValuePair<long, int>>();
+				int lastSentFrame = -1;
+				long messages = 0;
+
+				double positionSquares = 0.0, positionMax = 0.0, rotationSquares = 0.0, delays = 0.0;
+				int samples = 0;
+				for (int frame = 0; frame < frameCount; ++frame) {
+					ulong now = (ulong)(frame * FRAME_TIME);
+					Quaternion rotation = Quaternion.Euler(0.0f, headings[frame], 0.0f);
+
+					// Same as NetLocalPlayer.SendOnFootSync.
+					bool send;
+					float distance = 0.0f, angle = 0.0f;
+					if (lastSentFrame < 0) {
+						send = true;
+					}
+					else if (adaptive == 0) {
+						send = now >= (ulong)(lastSentFrame * FRAME_TIME) + FIXED_INTERVAL;
+					}
+					else {
+						distance = (positions[frame] - positions[lastSentFrame]).magnitude;
+						angle = Quaternion.Angle(rotation, Quaternion.Euler(0.0f, headings[lastSentFrame], 0.0f));
+						send = controller.ShouldSend(now, distance, angle);
+					}
+					if (send) {
+						controller.Sent(now, distance, angle, messageSize);
+						inFlight.Add(new KeyValuePair<long, int>((long)now + TRANSIT_TIME + transit.Next(MAX_TRANSIT_JITTER + 1), frame));
+						lastSentFrame = frame;
+						if ((long)now >= WARMUP) {
+							messages++;
+						}
+					}
+
+					for (int i = inFlight.Count - 1; i >= 0; --i) {
+						if (inFlight[i].Key <= (long)now) {
+							int sentFrame = inFlight[i].Value;
+							buffer.Add((ulong)(sentFrame * FRAME_TIME), now, positions[sentFrame], Quaternion.Euler(0.0f, headings[sentFrame], 0.0f));
+							inFlight.RemoveAt(i);
+						}
+					}
+
+					Vector3 sampledPosition;
+					Quaternion sampledRotation;
+					if (!buffer.Sample(now, out sampledPosition, out sampledRotation) || (long)now < WARMUP) {
+						continue;
+					}
+
+					// Ground truth at the playback time, linear between the simulated frames.
+					double playback = System.Math.Max(buffer.PlaybackTime, 0.0) / FRAME_TIME;
+					int truthFrame = System.Math.Min((int)playback, frameCount - 2);
+					float blend = Mathf.Clamp((float)(playback - truthFrame), 0.0f, 1.0f);
+					Vector3 truePosition = Vector3.Lerp(positions[truthFrame], positions[truthFrame + 1], blend);
+					Quaternion trueRotation = Quaternion.Euler(0.0f, headings[truthFrame] + (headings[truthFrame + 1] - headings[truthFrame]) * blend, 0.0f);
+
+					double positionError = (sampledPosition - truePosition).magnitude * 100.0;
+					double rotationError = Quaternion.Angle(sampledRotation, trueRotation);
+					positionSquares += positionError * positionError;
+					rotationSquares += rotationError * rotationError;
+					positionMax = System.Math.Max(positionMax, positionError);
+					delays += buffer.Delay;
+					samples++;
+				}
+
+				double seconds = (DURATION - WARMUP) / 1000.0;
+				string name = adaptive == 0 ? "fixed 10 Hz" : $"adaptive, budget {budget:0} B/s";
+				Client.ConsoleMessage($"  {name}: {messages / seconds:0.0} msg/s, {messages * messageSize / seconds:0} B/s, error {System.Math.Sqrt(positionSquares / samples):0.0}/{positionMax:0.0} cm {System.Math.Sqrt(rotationSquares / samples):0.00} deg, mean delay {delays / samples:0} ms");
+			}
+		}
+
+		/// <summary>
+		/// Scripted animation state of the benchmark characters. (No drinks and swears, they need the local player)
+		/// </summary>
+		/// <param name="step">Index of the state.</param>
+		/// <returns>The animation state.</returns>
+		static Network.PlayerAnimState BenchAnimState(int step) {
+			var animState = new Network.PlayerAnimState();
+			animState.isRunning = step % 8 >= 4;
+			animState.isGrounded = step % 5 != 0;
+			animState.isLeaning = step % 7 == 3;
+			animState.isDrunk = step / 16 % 2 == 1;
+			animState.activeHandState = step % 9 < 4 ? (byte)(step % 9) : Network.PlayerAnimState.NONE;
+			animState.drinkId = Network.PlayerAnimState.NONE;
+			animState.swearId = Network.PlayerAnimState.NO_SWEAR;
+			animState.aimRot = step * 7 % 60 - 30.0f;
+			animState.crouchPosition = step % 11 == 0 ? 1.0f : 1.6f;
+			return animState;
+		}
+
+		/// <summary>
+		/// Measure per frame cost of the animation controllers of the remote characters and compare reading the
+		/// blend state of the overlay animations through the cached handles with the lookups by name.
+		/// </summary>
+		/// <param name="count">Amount of characters. (Spawned under the map for the duration of the benchmark)</param>
+		static void AnimationControllers(int count) {
+			const int FRAMES = 600;
+			const int WARMUP = 60;
+			const int MESSAGE_INTERVAL = 6;
+
+			GameObject model = Client.LoadAsset<GameObject>(Network.NetPlayer.CHARACTER_PREFAB_NAME);
+			var characters = new GameObject[count];
+			var animations = new Animation[count];
+			var overlays = new AnimationState[count * 2];
+			var controllers = new Network.PlayerAnimManager[count];
+			for (int i = 0; i < count; ++i) {
+				characters[i] = (GameObject)Object.Instantiate(model, new Vector3(i, -1000.0f, 0.0f), Quaternion.identity);
+				animations[i] = characters[i].GetComponentInChildren<Animation>();
+				overlays[i * 2] = animations[i]["Jump"];
+				overlays[i * 2 + 1] = animations[i]["Drunk"];
+				controllers[i] = new Network.PlayerAnimManager();
+				controllers[i].SetupAnimations(characters[i]);
+			}
+
+			var message = new Network.Messages.AnimSyncMessage();
+			long controllerTicks = 0, nameTicks = 0, handleTicks = 0;
+			int messages = 0;
+			float sum = 0.0f;
+			for (int frame = 0; frame < FRAMES; ++frame) {
+				var watch = Stopwatch.StartNew();
+				for (int i = 0; i < count; ++i) {
+					Network.PlayerAnimManager controller = controllers[i];
+					// Characters receive the state in different frames like the real players.
+					if ((frame + i) % MESSAGE_INTERVAL == 0) {
+						BenchAnimState((frame + i) / MESSAGE_INTERVAL).Write(message);
+						controller.HandleAnimations(message);
+						messages++;
+					}
+					controller.HandleOnFootMovementAnimations((frame / 120 + i) % 3 == 0 ? 0.0f : 0.05f);
+					controller.CheckBlendedOutAnimationStates();
+					controller.SyncVerticalHeadLook();
+				}
+				long frameControllerTicks = watch.ElapsedTicks;
+
+				watch = Stopwatch.StartNew();
+				for (int i = 0; i < count; ++i) {
+					Animation animation = animations[i];
+					sum += animation["Jump"].time + animation["Jump"].weight + animation["Drunk"].time + animation["Drunk"].weight;
+				}
+				long frameNameTicks = watch.ElapsedTicks;
+
+				watch = Stopwatch.StartNew();
+				for (int i = 0; i < count; ++i) {
+					AnimationState jump = overlays[i * 2], drunk = overlays[i * 2 + 1];
+					sum += jump.time + jump.weight + drunk.time + drunk.weight;
+				}
+				long frameHandleTicks = watch.ElapsedTicks;
+
+				if (frame >= WARMUP) {
+					controllerTicks += frameControllerTicks;
+					nameTicks += frameNameTicks;
+					handleTicks += frameHandleTicks;
+				}
+			}
+
+			for (int i = 0; i < count; ++i) {
+				Object.Destroy(characters[i]);
+			}
+
+			int frames = FRAMES - WARMUP;
+			Client.ConsoleMessage($"Animation controllers, {count} characters, {frames} frames, {messages} states received ({sum:0})");
+			Client.ConsoleMessage($"  controllers: {MicrosecondsPerOperation(controllerTicks, frames):0.0} us per frame, {MicrosecondsPerOperation(controllerTicks, frames * count):0.00} us per character");
+			Client.ConsoleMessage($"  overlay blend state by name: {MicrosecondsPerOperation(nameTicks, frames):0.0} us per frame, by handle: {MicrosecondsPerOperation(handleTicks, frames):0.0} us per frame");
+		}
+	}
+#endif
+}
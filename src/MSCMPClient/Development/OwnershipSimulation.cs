@@ -0,0 +1,216 @@
+using System.Collections.Generic;
+using MSCMP.Game;
+
+namespace MSCMP.Development {
+#if !PUBLIC_RELEASE
+	/// <summary>
+	/// Headless simulation of the ownership protocol between multiple players. Run from the dev console.
+	/// </summary>
+	/// <remarks>
+	/// Every round several players claim the same object at nearly the same time - some of them by force - and the
+	/// claims and rejections are delivered with random latency. Players decide through the same ObjectOwnership
+	/// methods as the ObjectSyncComponent and NetWorld handlers and send the same responses. After all messages are
+	/// delivered every player must agree on the owner and the owner must be the winner of all claims made in the
+	/// round.
+	/// </remarks>
+	static class OwnershipSimulation {
+
+		const ulong NO_OWNER = 0;
+		const ulong FIRST_PLAYER_ID = 76561197960265728;
+
+		/// <summary>
+		/// Claims are made within this window. (Shared clock milliseconds, coarse to produce ties)
+		/// </summary>
+		const int CLAIM_WINDOW = 100;
+		const int CLAIM_TIME_STEP = 10;
+
+		const int MIN_LATENCY = 10;
+		const int MAX_LATENCY = 250;
+
+		/// <summary>
+		/// Simulated message.
+		/// </summary>
+		class Message {
+			public ulong deliveryTime;
+			public int order;
+			public int receiver;
+			public bool rejection;
+			public OwnershipClaim claim;
+		}
+
+		/// <summary>
+		/// Register simulation console commands.
+		/// </summary>
+		public static void RegisterCommands() {
+			UI.Console.RegisterCommand("sim_ownership", (string[] args) => {
+				int players = 4;
+				int rounds = 1000;
+				int seed = 1;
+				if ((args.Length > 1 && (!int.TryParse(args[1], out players) || players < 2)) ||
+					(args.Length > 2 && (!int.TryParse(args[2], out rounds) || rounds < 1)) ||
+					(args.Length > 3 && !int.TryParse(args[3], out seed))) {
+					Client.ConsoleMessage("ERROR: Invalid syntax. Use 'sim_ownership [players] [rounds] [seed]'.");
+					return;
+				}
+				Run(players, rounds, seed);
+			});
+		}
+
+		/// <summary>
+		/// Run the simulation and print the results.
+		/// </summary>
+		/// <param name="players">Amount of players.</param>
+		/// <param name="rounds">Amount of contended rounds.</param>
+		/// <param name="seed">Seed of the random generator.</param>
+		/// <returns>Amount of rounds that did not converge to the expected owner.</returns>
+		public static int Run(int players, int rounds, int seed) {
+			var random = new System.Random(seed);
+			var states = new ObjectOwnership[players];
+			var queue = new List<Message>();
+			var lastDelivery = new ulong[players * players];
+			int failures = 0;
+			int messages = 0;
+			int rejections = 0;
+			int rollbackStates = 0;
+			int rollbacks = 0;
+			int contended = 0;
+
+			for (int round = 0; round < rounds; ++round) {
+				for (int i = 0; i < players; ++i) {
+					states[i] = new ObjectOwnership(NO_OWNER);
+				}
+
+				// Schedule the local claims, claimants decide when their claim time comes.
+				int claimants = random.Next(2, players + 1);
+				var claimTimes = new ulong[players];
+				var claimForce = new bool[players];
+				var claiming = new bool[players];
+				for (int c = 0; c < claimants; ++c) {
+					int player = random.Next(players);
+					claiming[player] = true;
+					claimTimes[player] = (ulong)(random.Next(CLAIM_WINDOW / CLAIM_TIME_STEP + 1) * CLAIM_TIME_STEP);
+					claimForce[player] = random.Next(3) == 0;
+				}
+
+				bool hasExpected = false;
+				OwnershipClaim expected = new OwnershipClaim(NO_OWNER, 0, false);
+				int order = 0;
+				int claims = 0;
+				queue.Clear();
+				System.Array.Clear(lastDelivery, 0, lastDelivery.Length);
+
+				ulong now = 0;
+				while (true) {
+					// Next event is either local claim or message delivery.
+					int nextClaim = -1;
+					for (int i = 0; i < players; ++i) {
+						if (claiming[i] && (nextClaim < 0 || claimTimes[i] < claimTimes[nextClaim])) {
+							nextClaim = i;
+						}
+					}
+					int nextMessage = -1;
+					for (int i = 0; i < queue.Count; ++i) {
+						if (nextMessage < 0 || queue[i].deliveryTime < queue[nextMessage].deliveryTime ||
+							(queue[i].deliveryTime == queue[nextMessage].deliveryTime && queue[i].order < queue[nextMessage].order)) {
+							nextMessage = i;
+						}
+					}
+					if (nextClaim < 0 && nextMessage < 0) {
+						break;
+					}
+
+					if (nextClaim >= 0 && (nextMessage < 0 || claimTimes[nextClaim] <= queue[nextMessage].deliveryTime)) {
+						int player = nextClaim;
+						claiming[player] = false;
+						now = claimTimes[player];
+
+						ulong id = FIRST_PLAYER_ID + (ulong)player;
+						ObjectOwnership state = states[player];
+						bool force = claimForce[player];
+						if (!state.CanClaim(id, force)) {
+							continue;
+						}
+						OwnershipClaim claim = state.Claim(id, now, force);
+						claims++;
+						if (!hasExpected || OwnershipArbiter.Wins(claim, expected, NO_OWNER)) {
+							expected = claim;
+							hasExpected = true;
+						}
+						Broadcast(queue, lastDelivery, random, player, players, now, false, claim, ref order);
+						continue;
+					}
+
+					Message msg = queue[nextMessage];
+					queue.RemoveAt(nextMessage);
+					messages++;
+					now = msg.deliveryTime;
+
+					ulong localId = FIRST_PLAYER_ID + (ulong)msg.receiver;
+					ObjectOwnership receiver = states[msg.receiver];
+					ObjectOwnership.Result result = receiver.HandleClaim(localId, msg.claim, msg.rejection);
+					if (result == ObjectOwnership.Result.Rejected || result == ObjectOwnership.Result.RejectedByOwner) {
+						rejections++;
+						Broadcast(queue, lastDelivery, random, msg.receiver, players, now, true, receiver.Current, ref order);
+
+						// State carries no claim so it does not affect the ownership, count it only.
+						if (result == ObjectOwnership.Result.RejectedByOwner) {
+							rollbackStates++;
+						}
+					}
+					else if (result == ObjectOwnership.Result.LostOwnership) {
+						rollbacks++;
+					}
+				}
+
+				if (claims > 1) {
+					contended++;
+				}
+
+				// All players must agree on the winner of the round.
+				bool converged = true;
+				for (int i = 0; i < players; ++i) {
+					if (states[i].Owner != expected.owner) {
+						converged = false;
+					}
+				}
+				if (!converged) {
+					if (failures == 0) {
+						var owners = new string[players];
+						for (int i = 0; i < players; ++i) {
+							owners[i] = states[i].Owner == NO_OWNER ? "-" : (states[i].Owner - FIRST_PLAYER_ID).ToString();
+						}
+						Client.ConsoleMessage($"  round {round} diverged, expected player {expected.owner - FIRST_PLAYER_ID}, owners: {string.Join(" ", owners)}");
+					}
+					failures++;
+				}
+			}
+
+			Client.ConsoleMessage($"Ownership simulation, {players} players, {rounds} rounds ({contended} contended), seed {seed}");
+			Client.ConsoleMessage($"  messages {messages}, rejections {rejections}, rollback states {rollbackStates}, rollbacks {rollbacks}");
+			Client.ConsoleMessage($"  diverged rounds: {failures}");
+			return failures;
+		}
+
+		/// <summary>
+		/// Queue message to all other players with random latency. Messages between two players are delivered
+		/// in order like the reliable messages in the game.
+		/// </summary>
+		static void Broadcast(List<Message> queue, ulong[] lastDelivery, System.Random random, int sender, int players, ulong now, bool rejection, OwnershipClaim claim, ref int order) {
+			for (int i = 0; i < players; ++i) {
+				if (i == sender) {
+					continue;
+				}
+				int link = sender * players + i;
+				var msg = new Message();
+				msg.deliveryTime = System.Math.Max(now + (ulong)random.Next(MIN_LATENCY, MAX_LATENCY + 1), lastDelivery[link]);
+				lastDelivery[link] = msg.deliveryTime;
+				msg.order = order++;
+				msg.receiver = i;
+				msg.rejection = rejection;
+				msg.claim = claim;
+				queue.Add(msg);
+			}
+		}
+	}
+#endif
+}
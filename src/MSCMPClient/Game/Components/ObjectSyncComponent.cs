@@ -8,10 +8,24 @@ namespace MSCMP.Game.Components {
 	/// Sync is provided based on distance from the player and paramters inside an ISyncedObject.
 	/// </summary>
 	class ObjectSyncComponent : MonoBehaviour {
-		// If sync is enabled.
-		public bool SyncEnabled = false;
+		// If sync is enabled. (Synced objects are updated by the ObjectSyncSystem)
+		public bool SyncEnabled {
+			get { return syncEnabled; }
+			set {
+				syncEnabled = value;
+				ObjectSyncManager.Instance?.SyncSystem.SetActive(this, value);
+				if (value) {
+					ObjectSyncManager.Instance?.Receiver.Remove(this);
+				}
+			}
+		}
+		bool syncEnabled = false;
 		// Sync owner.
-		public ulong Owner = 0;
+		public ulong Owner {
+			get { return ownership.Owner; }
+		}
+		// Ownership state and the claim of the current owner.
+		readonly ObjectOwnership ownership = new ObjectOwnership(ObjectSyncManager.NO_OWNER);
 		// Object ID.
 		public int ObjectID = ObjectSyncManager.AUTOMATIC_ID;
 		// Object type.
@@ -57,6 +71,13 @@ namespace MSCMP.Game.Components {
 			}
 		}
 
+		/// <summary>
+		/// Called when object is destroyed.
+		/// </summary>
+		void OnDestroy() {
+			ObjectSyncManager.Instance?.RemoveObject(this);
+		}
+
 		/// <summary>
 		/// Creates the object's subtype.
 		/// </summary>
@@ -88,39 +109,34 @@ namespace MSCMP.Game.Components {
 		}
 
 		/// <summary>
-		/// Called once per frame.
+		/// Sends periodic sync of the object if the object has periodic sync enabled.
+		/// (Called by ObjectSyncManager's periodic sync scheduler)
 		/// </summary>
-		void Update() {
-			if (isSetup) {
-				if (SyncEnabled) {
-					// Updates object's position continuously.
-					// (Typically used when player is holding a pickupable, or driving a vehicle)
-					if (sendConstantSync) {
-						SendObjectSync(ObjectSyncManager.SyncTypes.GenericSync, true, false);
-					}
-
-					// Check if object should be synced.
-					else if (syncedObject.CanSync()) {
-						SendObjectSync(ObjectSyncManager.SyncTypes.GenericSync, true, false);
-					}
-				}
-
-				// Periodically update the object's position if periodic sync is enabled.
-				if (syncedObject.PeriodicSyncEnabled() && ObjectSyncManager.Instance.ShouldPeriodicSync(Owner, SyncEnabled)) {
-					SendObjectSync(ObjectSyncManager.SyncTypes.PeriodicSync, true, false);
-				}
+		/// <returns>True if sync was sent.</returns>
+		public bool SendPeriodicSync() {
+			if (!isSetup || !syncedObject.PeriodicSyncEnabled()) {
+				return false;
 			}
+			SendObjectSync(ObjectSyncManager.SyncTypes.PeriodicSync, true, false);
+			return true;
 		}
 
 		/// <summary>
 		/// Sends a sync update of the object.
 		/// </summary>
-		public void SendObjectSync(ObjectSyncManager.SyncTypes type, bool sendVariables, bool syncWasRequested) {
-			if (sendVariables) {
-				NetLocalPlayer.Instance.SendObjectSync(ObjectID, syncedObject.ObjectTransform().position, syncedObject.ObjectTransform().rotation, type, syncedObject.ReturnSyncedVariables(true));
+		public void SendObjectSync(ObjectSyncManager.SyncTypes type, bool sendVariables, bool syncWasRequested, ulong claimTime = 0) {
+			Transform objectTransform = syncedObject.ObjectTransform();
+			byte[] variables = null;
+			if (sendVariables && syncedObject.UpdateSyncedVariables()) {
+				variables = syncedObject.GetSyncedVariables()?.ToArray(true);
+			}
+			// Send velocities as well so the receiver can extrapolate the object until the next update.
+			Rigidbody rigidbody = objectTransform.GetComponent<Rigidbody>();
+			if (rigidbody != null) {
+				NetLocalPlayer.Instance.SendObjectSync(ObjectID, objectTransform.position, objectTransform.rotation, rigidbody.velocity, rigidbody.angularVelocity, type, variables, claimTime);
 			}
 			else {
-				NetLocalPlayer.Instance.SendObjectSync(ObjectID, syncedObject.ObjectTransform().position, syncedObject.ObjectTransform().rotation, type, null);
+				NetLocalPlayer.Instance.SendObjectSync(ObjectID, objectTransform.position, objectTransform.rotation, type, variables, claimTime);
 			}
 		}
 
@@ -135,7 +151,7 @@ namespace MSCMP.Game.Components {
 		/// Called when object sync request is accepted by the remote client.
 		/// </summary>
 		public void SyncRequestAccepted() {
-			Owner = Steamworks.SteamUser.GetSteamID().m_SteamID;
+			ownership.SetOwner(Steamworks.SteamUser.GetSteamID().m_SteamID);
 			Logger.Log("Sync request accepted, object: " + gameObject.name);
 			SyncEnabled = true;
 		}
@@ -144,8 +160,8 @@ namespace MSCMP.Game.Components {
 		/// Called when the player enter sync range of the object.
 		/// </summary>
 		public void SendEnterSync() {
-			if (Owner == ObjectSyncManager.NO_OWNER && syncedObject.ShouldTakeOwnership()) {
-				SendObjectSync(ObjectSyncManager.SyncTypes.SetOwner, true, false);
+			if (ownership.CanClaim(ObjectSyncManager.Instance.steamID.m_SteamID, false) && syncedObject.ShouldTakeOwnership()) {
+				ClaimOwnership(ObjectSyncManager.SyncTypes.SetOwner, false);
 			}
 		}
 
@@ -154,7 +170,7 @@ namespace MSCMP.Game.Components {
 		/// </summary>
 		public void SendExitSync() {
 			if (Owner == ObjectSyncManager.Instance.steamID.m_SteamID) {
-				Owner = ObjectSyncManager.NO_OWNER;
+				ownership.Release();
 				SyncEnabled = false;
 				SendObjectSync(ObjectSyncManager.SyncTypes.RemoveOwner, false, false);
 			}
@@ -164,16 +180,57 @@ namespace MSCMP.Game.Components {
 		/// Take sync control of the object by force.
 		/// </summary>
 		public void TakeSyncControl() {
-			if (Owner != Steamworks.SteamUser.GetSteamID().m_SteamID) {
-				SendObjectSync(ObjectSyncManager.SyncTypes.ForceSetOwner, true, false);
+			if (ownership.CanClaim(Steamworks.SteamUser.GetSteamID().m_SteamID, true)) {
+				ClaimOwnership(ObjectSyncManager.SyncTypes.ForceSetOwner, true);
 			}
 		}
 
+		/// <summary>
+		/// Take ownership of the object without waiting for the remote players and send the claim to them.
+		/// If the claim loses the conflict with the claim of another player the object is given back in
+		/// HandleOwnershipClaim and the winner's state replaces the local one.
+		/// </summary>
+		/// <param name="type">SetOwner or ForceSetOwner.</param>
+		/// <param name="force">Is the object taken by force?</param>
+		void ClaimOwnership(ObjectSyncManager.SyncTypes type, bool force) {
+			OwnershipClaim claim = ownership.Claim(ObjectSyncManager.Instance.steamID.m_SteamID, NetManager.Instance.GetSharedClock(), force);
+			SyncEnabled = true;
+			SendObjectSync(type, true, false, claim.time);
+		}
+
+		/// <summary>
+		/// Claim of the current owner.
+		/// </summary>
+		public OwnershipClaim OwnershipClaim {
+			get { return ownership.Current; }
+		}
+
+		/// <summary>
+		/// Resolve ownership claim of the remote player. Applies the new owner, the caller sends the response.
+		/// </summary>
+		/// <param name="claim">The claim.</param>
+		/// <param name="rejection">Was the claim sent with the rejection of the local claim?</param>
+		/// <returns>Result of the claim. (See ObjectOwnership.HandleClaim)</returns>
+		public ObjectOwnership.Result HandleOwnershipClaim(OwnershipClaim claim, bool rejection) {
+			ObjectOwnership.Result result = ownership.HandleClaim(ObjectSyncManager.Instance.steamID.m_SteamID, claim, rejection);
+			if (result != ObjectOwnership.Result.Accepted && result != ObjectOwnership.Result.LostOwnership) {
+				return result;
+			}
+			if (result == ObjectOwnership.Result.LostOwnership || claim.force) {
+				SyncEnabled = false;
+				SyncTakenByForce();
+			}
+			if (syncedObject != null) {
+				syncedObject.OwnerSetToRemote();
+			}
+			return result;
+		}
+
 		/// <summary>
 		/// Called when sync owner is set to the remote client.
 		/// </summary>
 		public void OwnerSetToRemote(ulong newOwner) {
-			Owner = newOwner;
+			ownership.SetOwner(newOwner);
 			if (syncedObject != null) {
 				syncedObject.OwnerSetToRemote();
 			}
@@ -183,7 +240,7 @@ namespace MSCMP.Game.Components {
 		/// Called when owner is removed.
 		/// </summary>
 		public void OwnerRemoved() {
-			Owner = ObjectSyncManager.NO_OWNER;
+			ownership.Release();
 			if (syncedObject != null) {
 				syncedObject.OwnerRemoved();
 			}
@@ -204,19 +261,36 @@ namespace MSCMP.Game.Components {
 		/// <param name="newValue">If object should be constantly synced.</param>
 		public void SendConstantSync(bool newValue) {
 			sendConstantSync = newValue;
+			ObjectSyncManager.Instance?.SyncSystem.SetConstantSync(this, newValue);
 			if (syncedObject != null) {
 				syncedObject.ConstantSyncChanged(newValue);
 			}
 		}
 
+		/// <summary>
+		/// Is object constantly synced?
+		/// </summary>
+		public bool IsConstantSync {
+			get { return sendConstantSync; }
+		}
+
 		/// <summary>
 		/// Handles synced variables sent from remote client.
 		/// </summary>
-		/// <param name="syncedVariables">Synced variables</param>
-		public void HandleSyncedVariables(float[] syncedVariables) {
-			if (syncedObject != null) {
-				syncedObject.HandleSyncedVariables(syncedVariables);
+		/// <param name="data">Buffer containing the encoded variables.</param>
+		/// <param name="offset">Offset of the variables in the buffer.</param>
+		/// <param name="length">Size of the variables in bytes.</param>
+		public void HandleSyncedVariables(byte[] data, int offset, int length) {
+			SyncedVariables variables = syncedObject?.GetSyncedVariables();
+			if (variables == null) {
+				return;
+			}
+			uint received;
+			if (!variables.Read(data, offset, length, out received)) {
+				Logger.Error($"Received malformed synced variables of object {ObjectID}.");
+				return;
 			}
+			syncedObject.HandleSyncedVariables(received);
 		}
 
 		/// <summary>
@@ -233,21 +307,41 @@ namespace MSCMP.Game.Components {
 		}
 
 		/// <summary>
-		/// Set object's postion and rotationn.
+		/// Apply object state received from the remote player. (Smoothed by the ObjectSyncReceiver)
 		/// </summary>
-		/// <param name="pos"></param>
-		/// <param name="rot"></param>
-		public void SetPositionAndRotation(Vector3 pos, Quaternion rot) {
+		/// <param name="pos">Received position.</param>
+		/// <param name="rot">Received rotation.</param>
+		/// <param name="hasVelocity">Does received state contain velocities?</param>
+		/// <param name="velocity">Received linear velocity.</param>
+		/// <param name="angularVelocity">Received angular velocity.</param>
+		/// <param name="age">Seconds since the remote player took the state.</param>
+		public void HandleObjectState(Vector3 pos, Quaternion rot, bool hasVelocity, Vector3 velocity, Vector3 angularVelocity, float age) {
 			if (syncedObject == null) {
 				// Can be caused by moving an object whilst the remote client is still loading.
 				// Object should become synced after the client has finished loading anyway.
 				Logger.Debug($"Tried to set position of object '{gameObject.name}' but object isn't setup. (This is usually fine)");
 				return;
 			}
-			if (syncedObject != null) {
-				syncedObject.ObjectTransform().position = pos;
-				syncedObject.ObjectTransform().rotation = rot;
+			Transform objectTransform = syncedObject.ObjectTransform();
+			if (ObjectType == ObjectSyncManager.ObjectTypes.GarageDoor) {
+				// Doors are driven by the hinge, never blend them.
+				objectTransform.position = pos;
+				objectTransform.rotation = rot;
+				return;
+			}
+			ObjectSyncManager.Instance.Receiver.HandleState(this, objectTransform, pos, rot, hasVelocity, velocity, angularVelocity, age);
+		}
+
+		/// <summary>
+		/// Apply final state of the object that came to rest on the remote player's side.
+		/// </summary>
+		/// <param name="pos">Exact rest position.</param>
+		/// <param name="rot">Exact rest rotation.</param>
+		public void HandleObjectAtRest(Vector3 pos, Quaternion rot) {
+			if (syncedObject == null) {
+				return;
 			}
+			ObjectSyncManager.Instance.Receiver.HandleAtRest(this, syncedObject.ObjectTransform(), pos, rot);
 		}
 
 		/// <summary>
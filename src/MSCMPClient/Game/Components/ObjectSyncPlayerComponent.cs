@@ -1,5 +1,4 @@
 ﻿using UnityEngine;
-using System.Threading.Tasks;
 
 namespace MSCMP.Game.Components {
 	/// <summary>
@@ -20,8 +19,7 @@ namespace MSCMP.Game.Components {
 		void OnTriggerEnter(Collider other) {
 			ObjectSyncComponent syncComponent = other.GetComponent<ObjectSyncComponent>();
 			if (syncComponent != null) {
-				Task t = new Task(syncComponent.SendEnterSync);
-				t.Start();
+				syncComponent.SendEnterSync();
 			}
 		}
 
@@ -32,8 +30,7 @@ namespace MSCMP.Game.Components {
 		void OnTriggerExit(Collider other) {
 			ObjectSyncComponent syncComponent = other.GetComponent<ObjectSyncComponent>();
 			if (syncComponent != null) {
-				Task t = new Task(syncComponent.SendExitSync);
-				t.Start();
+				syncComponent.SendExitSync();
 			}
 		}
 	}
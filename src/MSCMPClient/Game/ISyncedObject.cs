@@ -17,6 +17,7 @@ namespace MSCMP.Game {
 
 		/// <summary>
 		/// Called to determine if the object should be synced. 
+		/// Movement is detected by the ObjectSyncSystem, return true only for object specific reasons.
 		/// </summary>
 		/// <returns>True if object should be synced, false if object shouldn't be synced.</returns>
 		bool CanSync();
@@ -28,17 +29,23 @@ namespace MSCMP.Game {
 		bool ShouldTakeOwnership();
 
 		/// <summary>
-		/// Called to return variables that need to be synced on the remote client.
+		/// Variables synced together with the object's transform.
 		/// </summary>
-		/// <returns>Variables to send to remote client.</returns>
-		/// <param name="sendFullSync">Send all variables regardless of conditions.</param>
-		float[] ReturnSyncedVariables(bool sendFullSync);
+		/// <returns>Block of the synced variables or null if the object has none.</returns>
+		SyncedVariables GetSyncedVariables();
 
 		/// <summary>
-		/// Handle synced variables sent from the remote client.
+		/// Called before the object is sent to write current values into its synced variables.
 		/// </summary>
-		/// <param name="variables"></param>
-		void HandleSyncedVariables(float[] variables);
+		/// <returns>false if the variables should not be sent this time.</returns>
+		bool UpdateSyncedVariables();
+
+		/// <summary>
+		/// Handle synced variables sent from the remote client. Received values are already decoded into the block
+		/// returned by GetSyncedVariables.
+		/// </summary>
+		/// <param name="received">Mask of the received variables. (See SyncedVariables.IsSet)</param>
+		void HandleSyncedVariables(uint received);
 
 		/// <summary>
 		/// Called when owner is set to remote client.
@@ -0,0 +1,142 @@
+namespace MSCMP.Game {
+	/// <summary>
+	/// Ownership state of the single synced object as seen by one player.
+	/// </summary>
+	/// <remarks>
+	/// Local claims take effect immediately. Remote claims are resolved by the OwnershipArbiter against the
+	/// claim of the current owner - if the local player loses, it must stop syncing the object and accept the
+	/// winner's state, if the remote player loses, the local owner sends its state so the loser rolls back.
+	///
+	/// The network handlers and the OwnershipSimulation act on the results of CanClaim and HandleClaim only, so
+	/// the simulation exercises the same decisions as the game.
+	/// </remarks>
+	class ObjectOwnership {
+
+		/// <summary>
+		/// Result of the remote claim.
+		/// </summary>
+		public enum Result {
+			/// <summary>
+			/// Nothing to do. (Own claim forwarded back or rejection of the claim we do not hold anymore)
+			/// </summary>
+			Ignored,
+			/// <summary>
+			/// Remote player is the new owner.
+			/// </summary>
+			Accepted,
+			/// <summary>
+			/// Remote player is the new owner, local player lost the object.
+			/// </summary>
+			LostOwnership,
+			/// <summary>
+			/// Current owner keeps the object, the claimant gets the rejection with the owner's claim.
+			/// </summary>
+			Rejected,
+			/// <summary>
+			/// Local player keeps the object, the claimant gets the rejection and the local state to roll back to.
+			/// </summary>
+			RejectedByOwner,
+		}
+
+		readonly ulong noOwner;
+
+		OwnershipClaim current;
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="noOwner">Owner id meaning the object has no owner.</param>
+		public ObjectOwnership(ulong noOwner) {
+			this.noOwner = noOwner;
+			current = new OwnershipClaim(noOwner, 0, false);
+		}
+
+		/// <summary>
+		/// The current owner.
+		/// </summary>
+		public ulong Owner {
+			get { return current.owner; }
+		}
+
+		/// <summary>
+		/// Claim of the current owner.
+		/// </summary>
+		public OwnershipClaim Current {
+			get { return current; }
+		}
+
+		/// <summary>
+		/// Check if the local player may claim the object. Objects are taken either when they have no owner or by
+		/// force from the other player.
+		/// </summary>
+		/// <param name="localId">Steam id of the local player.</param>
+		/// <param name="force">Is the object taken by force?</param>
+		/// <returns>true if the claim should be made, false otherwise.</returns>
+		public bool CanClaim(ulong localId, bool force) {
+			return force ? current.owner != localId : current.owner == noOwner;
+		}
+
+		/// <summary>
+		/// Claim the object for the local player. Takes effect immediately.
+		/// </summary>
+		/// <param name="localId">Steam id of the local player.</param>
+		/// <param name="time">Shared clock time of the claim.</param>
+		/// <param name="force">Is the object taken by force?</param>
+		/// <returns>The claim to send to the remote players.</returns>
+		public OwnershipClaim Claim(ulong localId, ulong time, bool force) {
+			current = new OwnershipClaim(localId, time, force);
+			return current;
+		}
+
+		/// <summary>
+		/// Resolve claim received from the remote player.
+		/// </summary>
+		/// <param name="localId">Steam id of the local player.</param>
+		/// <param name="claim">The remote claim or the winner's claim sent with the rejection of the local claim.</param>
+		/// <param name="rejection">Was the claim sent with the rejection?</param>
+		/// <returns>Result of the claim.</returns>
+		public Result HandleClaim(ulong localId, OwnershipClaim claim, bool rejection) {
+			// Our own claim forwarded by another player.
+			if (claim.owner == localId) {
+				return Result.Ignored;
+			}
+			bool owned = current.owner == localId;
+			// Rejection matters only while we still hold the rejected claim, the winner's state follows it.
+			if (rejection && !owned) {
+				return Result.Ignored;
+			}
+			if (!OwnershipArbiter.Wins(claim, current, noOwner)) {
+				// Rejections are not answered, the winner resolved them the same way already.
+				if (rejection) {
+					return Result.Ignored;
+				}
+				return owned ? Result.RejectedByOwner : Result.Rejected;
+			}
+			current = claim;
+			return owned ? Result.LostOwnership : Result.Accepted;
+		}
+
+		/// <summary>
+		/// Set owner without a claim. (Owner assigned by the remote player, claim is treated as the oldest one)
+		/// </summary>
+		/// <param name="owner">The new owner.</param>
+		public void SetOwner(ulong owner) {
+			current = new OwnershipClaim(owner, 0, false);
+		}
+
+		/// <summary>
+		/// Set owner with the known claim. (e.g. claim of the winner received with the rejection)
+		/// </summary>
+		/// <param name="claim">The claim of the owner.</param>
+		public void SetOwner(OwnershipClaim claim) {
+			current = claim;
+		}
+
+		/// <summary>
+		/// Remove owner of the object.
+		/// </summary>
+		public void Release() {
+			current = new OwnershipClaim(noOwner, 0, false);
+		}
+	}
+}
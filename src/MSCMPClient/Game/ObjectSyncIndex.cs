@@ -0,0 +1,134 @@
+using System.Collections.Generic;
+using MSCMP.Game.Components;
+using UnityEngine;
+
+namespace MSCMP.Game {
+	/// <summary>
+	/// Reverse lookup of the synced objects by their game object and by their pickupable prefab.
+	/// </summary>
+	/// <remarks>
+	/// Keys are captured when object is added - when the game object is being destroyed its components
+	/// (including pickupable meta data) may already be gone so they can't be queried on removal.
+	/// </remarks>
+	class ObjectSyncIndex {
+
+		/// <summary>
+		/// Keys under which the object was indexed.
+		/// </summary>
+		struct Keys {
+			public int instanceId;
+			public int prefabId;
+		}
+
+		/// <summary>
+		/// Objects by the instance id of their game object.
+		/// </summary>
+		Dictionary<int, ObjectSyncComponent> byInstanceId = new Dictionary<int, ObjectSyncComponent>();
+
+		/// <summary>
+		/// Pickupable objects by their prefab id.
+		/// </summary>
+		Dictionary<int, HashSet<ObjectSyncComponent>> byPrefabId = new Dictionary<int, HashSet<ObjectSyncComponent>>();
+
+		/// <summary>
+		/// Keys of the indexed objects.
+		/// </summary>
+		Dictionary<ObjectSyncComponent, Keys> keys = new Dictionary<ObjectSyncComponent, Keys>();
+
+		/// <summary>
+		/// Amount of indexed objects.
+		/// </summary>
+		public int Count {
+			get { return keys.Count; }
+		}
+
+		/// <summary>
+		/// Add object to the index.
+		/// </summary>
+		/// <param name="osc">The object to add.</param>
+		public void Add(ObjectSyncComponent osc) {
+			Remove(osc);
+
+			var metaData = osc.GetComponent<PickupableMetaDataComponent>();
+
+			Keys objectKeys;
+			objectKeys.instanceId = osc.gameObject.GetInstanceID();
+			objectKeys.prefabId = metaData != null ? metaData.prefabId : -1;
+			keys.Add(osc, objectKeys);
+
+			// Game object can have multiple sync components for a moment (see NetWorld.SpawnPickupable), the newest one wins.
+			byInstanceId[objectKeys.instanceId] = osc;
+
+			if (objectKeys.prefabId != -1) {
+				HashSet<ObjectSyncComponent> instances;
+				if (!byPrefabId.TryGetValue(objectKeys.prefabId, out instances)) {
+					instances = new HashSet<ObjectSyncComponent>();
+					byPrefabId.Add(objectKeys.prefabId, instances);
+				}
+				instances.Add(osc);
+			}
+		}
+
+		/// <summary>
+		/// Remove object from the index.
+		/// </summary>
+		/// <param name="osc">The object to remove.</param>
+		public void Remove(ObjectSyncComponent osc) {
+			Keys objectKeys;
+			if (!keys.TryGetValue(osc, out objectKeys)) {
+				return;
+			}
+			keys.Remove(osc);
+
+			ObjectSyncComponent indexed;
+			if (byInstanceId.TryGetValue(objectKeys.instanceId, out indexed) && ReferenceEquals(indexed, osc)) {
+				byInstanceId.Remove(objectKeys.instanceId);
+			}
+
+			HashSet<ObjectSyncComponent> instances;
+			if (objectKeys.prefabId != -1 && byPrefabId.TryGetValue(objectKeys.prefabId, out instances)) {
+				instances.Remove(osc);
+			}
+		}
+
+		/// <summary>
+		/// Remove all objects from the index.
+		/// </summary>
+		public void Clear() {
+			byInstanceId.Clear();
+			byPrefabId.Clear();
+			keys.Clear();
+		}
+
+		/// <summary>
+		/// Get object by its game object.
+		/// </summary>
+		/// <param name="go">The game object.</param>
+		/// <returns>The object or null if game object has no indexed sync component.</returns>
+		public ObjectSyncComponent GetByGameObject(GameObject go) {
+			ObjectSyncComponent osc;
+			if (!byInstanceId.TryGetValue(go.GetInstanceID(), out osc) || osc == null) {
+				return null;
+			}
+			return osc;
+		}
+
+		/// <summary>
+		/// Get any pickupable object spawned from the given prefab.
+		/// </summary>
+		/// <param name="prefabId">The prefab id.</param>
+		/// <returns>The object or null if there is no indexed object of this prefab.</returns>
+		public ObjectSyncComponent GetAnyByPrefab(int prefabId) {
+			HashSet<ObjectSyncComponent> instances;
+			if (!byPrefabId.TryGetValue(prefabId, out instances)) {
+				return null;
+			}
+			foreach (ObjectSyncComponent osc in instances) {
+				if (osc != null) {
+					return osc;
+				}
+			}
+			return null;
+		}
+	}
+}
@@ -1,5 +1,5 @@
 using MSCMP.Game.Components;
-using System.Collections.Concurrent;
+using MSCMP.Utilities;
 using UnityEngine;
 
 namespace MSCMP.Game {
@@ -13,9 +13,14 @@ namespace MSCMP.Game {
 		public static ObjectSyncManager Instance = null;
 
 		/// <summary>
-		/// Dictionary of ObjectIDs.
+		/// Synced objects by ObjectID.
 		/// </summary>
-		public ConcurrentDictionary<int, ObjectSyncComponent> ObjectIDs = new ConcurrentDictionary<int, ObjectSyncComponent>();
+		/// <remarks>
+		/// ObjectIDs are generational slot map ids. Host allocates them and clients insert objects under ids
+		/// received from host. Ids of removed objects become stale and do not resolve to the object reusing the slot.
+		/// Objects created during game load are allocated on both sides in the same order so they get the same ids.
+		/// </remarks>
+		public SlotMap<ObjectSyncComponent> ObjectIDs = new SlotMap<ObjectSyncComponent>();
 
 		/// <summary>
 		/// Type of objects.
@@ -54,15 +59,64 @@ namespace MSCMP.Game {
 		/// </summary>
 		public Steamworks.CSteamID steamID;
 
+		/// <summary>
+		/// Reverse lookup of the objects by game object and prefab.
+		/// </summary>
+		ObjectSyncIndex index = new ObjectSyncIndex();
+
+		/// <summary>
+		/// System sending sync updates of the objects synced by the local player.
+		/// </summary>
+		ObjectSyncSystem syncSystem = new ObjectSyncSystem();
+
+		/// <summary>
+		/// System sending sync updates of the objects synced by the local player.
+		/// </summary>
+		public ObjectSyncSystem SyncSystem {
+			get { return syncSystem; }
+		}
+
+		/// <summary>
+		/// System smoothing objects synced by the remote players.
+		/// </summary>
+		ObjectSyncReceiver receiver = new ObjectSyncReceiver();
+
+		/// <summary>
+		/// System smoothing objects synced by the remote players.
+		/// </summary>
+		public ObjectSyncReceiver Receiver {
+			get { return receiver; }
+		}
+
+		/// <summary>
+		/// Scheduler of the periodic syncs.
+		/// </summary>
+		PeriodicSyncScheduler periodicSync = new PeriodicSyncScheduler(System.Enum.GetValues(typeof(ObjectTypes)).Length);
+
+		/// <summary>
+		/// Scheduler of the periodic syncs.
+		/// </summary>
+		public PeriodicSyncScheduler PeriodicSync {
+			get { return periodicSync; }
+		}
+
 		/// <summary>
 		/// Constructor.
 		/// </summary>
 		public ObjectSyncManager() {
 			Instance = this;
+
+			// Periods in seconds in which every object of the type gets periodic sync. Pickupables and garage doors
+			// do not use periodic sync (see ISyncedObject.PeriodicSyncEnabled) so they are not scheduled at all.
+			periodicSync.SetPeriod((int)ObjectTypes.PlayerVehicle, 2.0f);
+			periodicSync.SetPeriod((int)ObjectTypes.AIVehicle, 2.0f);
+			periodicSync.SetPeriod((int)ObjectTypes.Boat, 2.0f);
+			periodicSync.SetPeriod((int)ObjectTypes.Pickupable, 0.0f);
+			periodicSync.SetPeriod((int)ObjectTypes.GarageDoor, 0.0f);
 		}
 
 		/// <summary>
-		/// Adds new object to the ObjectIDs Dictionary.
+		/// Adds new object to the ObjectIDs slot map.
 		/// </summary>
 		/// <param name="osc">Object to add.</param>
 		/// <param name="objectID">Object ID to assign to object.</param>
@@ -73,34 +127,122 @@ namespace MSCMP.Game {
 				if (steamID.m_SteamID == 0) {
 					steamID = Steamworks.SteamUser.GetSteamID();
 				}
-				Logger.Debug($"Added new ObjectID at: {ObjectIDs.Count + 1}");
-				ObjectIDs.GetOrAdd(ObjectIDs.Count + 1, osc);
-				return ObjectIDs.Count;
+				objectID = ObjectIDs.Add(osc);
+				Logger.Debug($"Added new ObjectID at: {objectID}");
 			}
 			// Assign object a specific ObjectID.
 			else {
 				Logger.Debug($"Force adding new ObjectID at: {objectID}");
-				if (ObjectIDs.ContainsKey(objectID)) {
-					ObjectIDs[objectID] = osc;
+				ObjectSyncComponent oldOsc;
+				if (!ObjectIDs.Insert(objectID, osc, out oldOsc)) {
+					Logger.Error($"Tried to add object with invalid ObjectID: {objectID}");
+					return objectID;
 				}
-				else {
-					ObjectIDs.GetOrAdd(objectID, osc);
+				// Host reused the slot (possibly with the new generation) - object that was there is gone on the host side.
+				if (!ReferenceEquals(oldOsc, null) && !ReferenceEquals(oldOsc, osc)) {
+					syncSystem.Remove(oldOsc);
+					receiver.Remove(oldOsc);
+					periodicSync.Remove(oldOsc.ObjectID);
+					index.Remove(oldOsc);
 				}
-				return objectID;
 			}
+			periodicSync.Add(objectID, (int)osc.ObjectType);
+			index.Add(osc);
+			return objectID;
 		}
 
 		/// <summary>
-		/// Check if a periodic object sync should be performed.
+		/// Removes object from the ObjectIDs slot map.
 		/// </summary>
-		/// <returns>True if object periodic sync should be sent.</returns>
-		public bool ShouldPeriodicSync(ulong owner, bool syncEnabled) {
-			if (Network.NetManager.Instance.TicksSinceConnectionStarted % 500 == 0) {
-				if (syncEnabled || owner == NO_OWNER && Network.NetManager.Instance.IsHost) {
-					return true;
-				}
+		/// <param name="osc">Object to remove.</param>
+		public void RemoveObject(ObjectSyncComponent osc) {
+			syncSystem.Remove(osc);
+			receiver.Remove(osc);
+
+			// Slot can already be taken by the new component of the same object (see NetWorld.SpawnPickupable).
+			if (!ReferenceEquals(ObjectIDs.Get(osc.ObjectID), osc)) {
+				return;
+			}
+			ObjectIDs.Remove(osc.ObjectID);
+			periodicSync.Remove(osc.ObjectID);
+			index.Remove(osc);
+		}
+
+		/// <summary>
+		/// Get object by ObjectID.
+		/// </summary>
+		/// <param name="objectID">The ObjectID.</param>
+		/// <returns>The object or null if there is no object with such ObjectID or the ObjectID is stale.</returns>
+		public ObjectSyncComponent GetObject(int objectID) {
+			ObjectSyncComponent osc = ObjectIDs.Get(objectID);
+			// Destroyed component only compares equal to null, make sure caller gets real null.
+			if (osc == null) {
+				return null;
+			}
+			return osc;
+		}
+
+		/// <summary>
+		/// Get object by its game object.
+		/// </summary>
+		/// <param name="go">The game object.</param>
+		/// <returns>The object or null if the game object is not synced.</returns>
+		public ObjectSyncComponent GetObjectByGameObject(GameObject go) {
+			return index.GetByGameObject(go);
+		}
+
+		/// <summary>
+		/// Get any pickupable spawned from the given prefab.
+		/// </summary>
+		/// <param name="prefabId">The prefab id.</param>
+		/// <returns>The object or null if there is no synced pickupable of this prefab.</returns>
+		public ObjectSyncComponent GetAnyPickupableOfPrefab(int prefabId) {
+			return index.GetAnyByPrefab(prefabId);
+		}
+
+		/// <summary>
+		/// Remove all objects.
+		/// </summary>
+		public void ClearObjects() {
+			ObjectIDs.Clear();
+			periodicSync.Clear();
+			index.Clear();
+			syncSystem.Clear();
+			receiver.Clear();
+		}
+
+		/// <summary>
+		/// Update object sync manager state. Sends sync updates of the objects synced by the local player
+		/// and the periodic syncs that are due this frame.
+		/// </summary>
+		/// <param name="deltaTime">Time elapsed since the last update in seconds.</param>
+		public void Update(float deltaTime) {
+			syncSystem.Update(deltaTime);
+			periodicSync.Update(deltaTime, SendPeriodicSync);
+		}
+
+		/// <summary>
+		/// Fixed update of the object sync manager. Drives objects synced by the remote players.
+		/// </summary>
+		public void FixedUpdate() {
+			receiver.FixedUpdate();
+		}
+
+		/// <summary>
+		/// Send periodic sync of the object if local player is responsible for it.
+		/// </summary>
+		/// <param name="objectID">The object id.</param>
+		/// <returns>True if periodic sync was sent.</returns>
+		bool SendPeriodicSync(int objectID) {
+			ObjectSyncComponent osc;
+			if (!ObjectIDs.TryGetValue(objectID, out osc) || osc == null) {
+				return false;
+			}
+			// Synced by the owner, unowned objects are synced by the host.
+			if (!osc.SyncEnabled && !(osc.Owner == NO_OWNER && Network.NetManager.Instance.IsHost)) {
+				return false;
 			}
-			return false;
+			return osc.SendPeriodicSync();
 		}
 	}
 }
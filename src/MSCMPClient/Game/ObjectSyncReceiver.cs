@@ -0,0 +1,194 @@
+using System.Collections.Generic;
+using MSCMP.Game.Components;
+using MSCMP.Math;
+using UnityEngine;
+
+namespace MSCMP.Game {
+	/// <summary>
+	/// Applies object states received from the remote players.
+	/// </summary>
+	/// <remarks>
+	/// Objects with non kinematic rigidbody are not teleported. Received state is smoothed by the
+	/// ProjectiveVelocityBlender and the object is driven towards the smoothed trajectory by setting
+	/// velocities of its rigidbody, so the local physics keeps resolving collisions. Only objects
+	/// that are being blended or extrapolated are updated each physics step.
+	///
+	/// When the owner's object comes to rest it is placed at the exact received transform and its rigidbody
+	/// is put to sleep, so it does not jitter under the local physics until the next update.
+	/// </remarks>
+	class ObjectSyncReceiver {
+
+		/// <summary>
+		/// Distance in meters over which the object is teleported instead of blended.
+		/// </summary>
+		const float SNAP_DISTANCE = 5.0f;
+
+		/// <summary>
+		/// Smoothing state of the single object.
+		/// </summary>
+		class Entry {
+			public Rigidbody rigidbody;
+			public ProjectiveVelocityBlender blender = new ProjectiveVelocityBlender();
+			public bool active = false;
+		}
+
+		/// <summary>
+		/// Smoothing state of all objects that received state.
+		/// </summary>
+		Dictionary<ObjectSyncComponent, Entry> entries = new Dictionary<ObjectSyncComponent, Entry>();
+
+		/// <summary>
+		/// Entries being blended or extrapolated.
+		/// </summary>
+		List<Entry> activeEntries = new List<Entry>();
+
+		/// <summary>
+		/// Amount of objects being blended or extrapolated.
+		/// </summary>
+		public int ActiveCount {
+			get { return activeEntries.Count; }
+		}
+
+		/// <summary>
+		/// Handle state of the object received from the remote player.
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		/// <param name="transform">The object's transform.</param>
+		/// <param name="position">Received position.</param>
+		/// <param name="rotation">Received rotation.</param>
+		/// <param name="hasVelocity">Does received state contain velocities?</param>
+		/// <param name="velocity">Received linear velocity.</param>
+		/// <param name="angularVelocity">Received angular velocity.</param>
+		/// <param name="age">Seconds since the remote player took the state.</param>
+		public void HandleState(ObjectSyncComponent osc, Transform transform, Vector3 position, Quaternion rotation, bool hasVelocity, Vector3 velocity, Vector3 angularVelocity, float age) {
+			Entry entry;
+			if (!entries.TryGetValue(osc, out entry)) {
+				entry = new Entry();
+				entry.rigidbody = transform.GetComponent<Rigidbody>();
+				entries.Add(osc, entry);
+			}
+
+			// Objects without physics are simply moved.
+			if (entry.rigidbody == null || entry.rigidbody.isKinematic) {
+				transform.position = position;
+				transform.rotation = rotation;
+				return;
+			}
+
+			if ((transform.position - position).sqrMagnitude > SNAP_DISTANCE * SNAP_DISTANCE) {
+				transform.position = position;
+				transform.rotation = rotation;
+				entry.rigidbody.velocity = velocity;
+				entry.rigidbody.angularVelocity = angularVelocity;
+				entry.blender.Reset();
+			}
+
+			// Extrapolate from the time the state was taken so the object does not lag behind by the transit time.
+			float stateTime = Time.time - Mathf.Min(age, ProjectiveVelocityBlender.MAX_EXTRAPOLATION);
+			if (!entry.blender.AddState(Time.time, stateTime, position, rotation, hasVelocity, velocity, angularVelocity, transform.position, transform.rotation, entry.rigidbody.velocity)) {
+				// Reordered state older than the one already blended to.
+				return;
+			}
+			if (!entry.active) {
+				entry.active = true;
+				activeEntries.Add(entry);
+			}
+		}
+
+		/// <summary>
+		/// Handle final state of the object that came to rest on the remote player's side.
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		/// <param name="transform">The object's transform.</param>
+		/// <param name="position">Exact rest position.</param>
+		/// <param name="rotation">Exact rest rotation.</param>
+		public void HandleAtRest(ObjectSyncComponent osc, Transform transform, Vector3 position, Quaternion rotation) {
+			Entry entry;
+			if (entries.TryGetValue(osc, out entry)) {
+				entry.blender.Reset();
+				if (entry.active) {
+					entry.active = false;
+					activeEntries.Remove(entry);
+				}
+			}
+
+			transform.position = position;
+			transform.rotation = rotation;
+
+			Rigidbody rigidbody = transform.GetComponent<Rigidbody>();
+			if (rigidbody != null && !rigidbody.isKinematic) {
+				rigidbody.velocity = Vector3.zero;
+				rigidbody.angularVelocity = Vector3.zero;
+				rigidbody.Sleep();
+			}
+		}
+
+		/// <summary>
+		/// Stop smoothing the object. (Called when local player takes the object or when it is destroyed)
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		public void Remove(ObjectSyncComponent osc) {
+			Entry entry;
+			if (!entries.TryGetValue(osc, out entry)) {
+				return;
+			}
+			entries.Remove(osc);
+			if (entry.active) {
+				activeEntries.Remove(entry);
+			}
+		}
+
+		/// <summary>
+		/// Stop smoothing all objects.
+		/// </summary>
+		public void Clear() {
+			entries.Clear();
+			activeEntries.Clear();
+		}
+
+		/// <summary>
+		/// Drive the smoothed objects towards their trajectories. Called every physics step.
+		/// </summary>
+		public void FixedUpdate() {
+			float deltaTime = Time.fixedDeltaTime;
+			// Target the state at the end of this physics step.
+			float time = Time.fixedTime + deltaTime;
+
+			for (int i = activeEntries.Count - 1; i >= 0; --i) {
+				Entry entry = activeEntries[i];
+				Rigidbody rigidbody = entry.rigidbody;
+				if (rigidbody == null) {
+					entry.active = false;
+					activeEntries.RemoveAt(i);
+					continue;
+				}
+
+				Vector3 position;
+				Quaternion rotation;
+				Vector3 velocity;
+				if (!entry.blender.Evaluate(time, out position, out rotation, out velocity)) {
+					// Blend finished, hand the object over to the physics.
+					rigidbody.velocity = velocity;
+					entry.active = false;
+					activeEntries.RemoveAt(i);
+					continue;
+				}
+
+				rigidbody.velocity = (position - rigidbody.position) / deltaTime;
+
+				float angle;
+				Vector3 axis;
+				(rotation * Quaternion.Inverse(rigidbody.rotation)).ToAngleAxis(out angle, out axis);
+				if (angle > 180.0f) {
+					angle -= 360.0f;
+				}
+				if (Mathf.Abs(angle) > 0.01f && !float.IsInfinity(axis.x)) {
+					rigidbody.angularVelocity = axis * (angle * Mathf.Deg2Rad / deltaTime);
+				}
+				else {
+					rigidbody.angularVelocity = Vector3.zero;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,454 @@
+using System;
+using System.Collections.Generic;
+using MSCMP.Game.Components;
+using MSCMP.Math;
+using MSCMP.Network;
+using UnityEngine;
+
+namespace MSCMP.Game {
+	/// <summary>
+	/// Sends sync updates of all objects the local player is syncing. (Objects with ObjectSyncComponent.SyncEnabled set)
+	/// </summary>
+	/// <remarks>
+	/// Objects not synced by the local player are not visited at all, objects whose component is inactive or
+	/// disabled are skipped. State of the synced objects is kept in parallel arrays and the update runs in
+	/// passes - first read transforms of all synced objects, then decide which objects need to be sent and
+	/// finally send them.
+	///
+	/// Object is sent when the receiver's prediction of its transform (see DeadReckoning) diverges from the real
+	/// transform by more than the error thresholds, when it did not send anything for HeartbeatInterval or when
+	/// the object itself requests it. (ISyncedObject.CanSync, constant sync)
+	///
+	/// When the rigidbody of the object falls asleep its exact transform is sent once as the at-rest state and
+	/// the object is not evaluated nor sent again until it wakes up. Only the sleep state is checked each update.
+	///
+	/// All objects sent in the update are encoded into as few ObjectSnapshotMessages as possible, sorted by
+	/// the object id.
+	/// </remarks>
+	class ObjectSyncSystem {
+
+		/// <summary>
+		/// Initial capacity of the arrays.
+		/// </summary>
+		const int INITIAL_CAPACITY = 64;
+
+		/// <summary>
+		/// Maximum position error of the receiver's prediction in meters.
+		/// </summary>
+		public float PositionErrorThreshold = 0.05f;
+
+		/// <summary>
+		/// Maximum rotation error of the receiver's prediction in degrees.
+		/// </summary>
+		public float AngleErrorThreshold = 2.0f;
+
+		/// <summary>
+		/// Maximum time in seconds between two sends of the synced object.
+		/// </summary>
+		public float HeartbeatInterval = 1.0f;
+
+		/// <summary>
+		/// The synced objects.
+		/// </summary>
+		ObjectSyncComponent[] components = new ObjectSyncComponent[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Subtypes of the synced objects. (null until object subtype is created)
+		/// </summary>
+		ISyncedObject[] syncedObjects = new ISyncedObject[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Transforms of the synced objects.
+		/// </summary>
+		Transform[] transforms = new Transform[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Rigidbodies of the synced objects. (null if object has no physics)
+		/// </summary>
+		Rigidbody[] rigidbodies = new Rigidbody[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Should the object be sent every frame regardless of ISyncedObject.CanSync?
+		/// </summary>
+		bool[] constantSync = new bool[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Positions of the objects read in the current update.
+		/// </summary>
+		Vector3[] positions = new Vector3[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Rotations of the objects read in the current update.
+		/// </summary>
+		Quaternion[] rotations = new Quaternion[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Linear velocities of the objects read in the current update.
+		/// </summary>
+		Vector3[] velocities = new Vector3[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Angular velocities of the objects read in the current update.
+		/// </summary>
+		Vector3[] angularVelocities = new Vector3[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Last sent positions.
+		/// </summary>
+		Vector3[] sentPositions = new Vector3[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Last sent rotations.
+		/// </summary>
+		Quaternion[] sentRotations = new Quaternion[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Last sent linear velocities.
+		/// </summary>
+		Vector3[] sentVelocities = new Vector3[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Last sent angular velocities.
+		/// </summary>
+		Vector3[] sentAngularVelocities = new Vector3[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Time of the last send. (negative if object was not sent yet)
+		/// </summary>
+		float[] sentTimes = new float[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Is the component active and enabled in the current update? (Inactive objects are neither read nor sent)
+		/// </summary>
+		bool[] active = new bool[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Is the rigidbody of the object sleeping in the current update?
+		/// </summary>
+		bool[] sleeping = new bool[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Was the at-rest state of the sleeping object already sent?
+		/// </summary>
+		bool[] atRest = new bool[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Indices of the objects to send in the current update.
+		/// </summary>
+		int[] sendQueue = new int[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Object ids of the objects in the send queue. (Used to sort the queue)
+		/// </summary>
+		int[] sendIds = new int[INITIAL_CAPACITY];
+
+		/// <summary>
+		/// Encoder of the sent snapshots.
+		/// </summary>
+		ObjectSnapshotWriter snapshotWriter = new ObjectSnapshotWriter();
+
+		/// <summary>
+		/// Time accumulated by updates in seconds.
+		/// </summary>
+		float time = 0.0f;
+
+		/// <summary>
+		/// Array index of each synced object.
+		/// </summary>
+		Dictionary<ObjectSyncComponent, int> indices = new Dictionary<ObjectSyncComponent, int>();
+
+		/// <summary>
+		/// Amount of synced objects.
+		/// </summary>
+		int count = 0;
+
+		/// <summary>
+		/// Amount of objects the local player is syncing.
+		/// </summary>
+		public int Count {
+			get { return count; }
+		}
+
+		/// <summary>
+		/// Amount of sync updates sent in the last update.
+		/// </summary>
+		public int SentLastFrame {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Amount of snapshot messages sent in the last update.
+		/// </summary>
+		public int SnapshotsLastFrame {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Amount of objects skipped in the last update because they are at rest.
+		/// </summary>
+		public int AtRestLastFrame {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of at-rest states sent.
+		/// </summary>
+		public long AtRestSends {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of sends because prediction error exceeded the thresholds.
+		/// </summary>
+		public long ErrorSends {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of sends because of the heartbeat.
+		/// </summary>
+		public long HeartbeatSends {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of sends requested by the objects. (Constant sync or ISyncedObject.CanSync)
+		/// </summary>
+		public long RequestedSends {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Start or stop syncing the object.
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		/// <param name="active">Should the object be synced?</param>
+		public void SetActive(ObjectSyncComponent osc, bool active) {
+			if (!active) {
+				Remove(osc);
+				return;
+			}
+
+			if (indices.ContainsKey(osc)) {
+				return;
+			}
+
+			if (count == components.Length) {
+				int capacity = count * 2;
+				Array.Resize(ref components, capacity);
+				Array.Resize(ref syncedObjects, capacity);
+				Array.Resize(ref transforms, capacity);
+				Array.Resize(ref rigidbodies, capacity);
+				Array.Resize(ref constantSync, capacity);
+				Array.Resize(ref positions, capacity);
+				Array.Resize(ref rotations, capacity);
+				Array.Resize(ref velocities, capacity);
+				Array.Resize(ref angularVelocities, capacity);
+				Array.Resize(ref sentPositions, capacity);
+				Array.Resize(ref sentRotations, capacity);
+				Array.Resize(ref sentVelocities, capacity);
+				Array.Resize(ref sentAngularVelocities, capacity);
+				Array.Resize(ref sentTimes, capacity);
+				Array.Resize(ref active, capacity);
+				Array.Resize(ref sleeping, capacity);
+				Array.Resize(ref atRest, capacity);
+				Array.Resize(ref sendQueue, capacity);
+				Array.Resize(ref sendIds, capacity);
+			}
+
+			components[count] = osc;
+			syncedObjects[count] = null;
+			transforms[count] = null;
+			rigidbodies[count] = null;
+			constantSync[count] = osc.IsConstantSync;
+			sentTimes[count] = -1.0f;
+			active[count] = false;
+			sleeping[count] = false;
+			atRest[count] = false;
+			indices.Add(osc, count);
+			count++;
+		}
+
+		/// <summary>
+		/// Update constant sync flag of the object.
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		/// <param name="constant">Should the object be sent every frame?</param>
+		public void SetConstantSync(ObjectSyncComponent osc, bool constant) {
+			int index;
+			if (indices.TryGetValue(osc, out index)) {
+				constantSync[index] = constant;
+			}
+		}
+
+		/// <summary>
+		/// Stop syncing the object.
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		public void Remove(ObjectSyncComponent osc) {
+			int index;
+			if (!indices.TryGetValue(osc, out index)) {
+				return;
+			}
+			indices.Remove(osc);
+
+			int last = count - 1;
+			if (index != last) {
+				components[index] = components[last];
+				syncedObjects[index] = syncedObjects[last];
+				transforms[index] = transforms[last];
+				rigidbodies[index] = rigidbodies[last];
+				constantSync[index] = constantSync[last];
+				sentPositions[index] = sentPositions[last];
+				sentRotations[index] = sentRotations[last];
+				sentVelocities[index] = sentVelocities[last];
+				sentAngularVelocities[index] = sentAngularVelocities[last];
+				sentTimes[index] = sentTimes[last];
+				atRest[index] = atRest[last];
+				indices[components[index]] = index;
+			}
+			components[last] = null;
+			syncedObjects[last] = null;
+			transforms[last] = null;
+			rigidbodies[last] = null;
+			count--;
+		}
+
+		/// <summary>
+		/// Stop syncing all objects.
+		/// </summary>
+		public void Clear() {
+			Array.Clear(components, 0, count);
+			Array.Clear(syncedObjects, 0, count);
+			Array.Clear(transforms, 0, count);
+			Array.Clear(rigidbodies, 0, count);
+			indices.Clear();
+			count = 0;
+		}
+
+		/// <summary>
+		/// Send sync updates of the objects that need it.
+		/// </summary>
+		/// <param name="deltaTime">Time elapsed since the last update in seconds.</param>
+		public void Update(float deltaTime) {
+			time += deltaTime;
+
+			int atRestCount = 0;
+			for (int i = 0; i < count; ++i) {
+				// Components of the inactive objects did not run their Update before either.
+				active[i] = components[i].isActiveAndEnabled;
+				if (!active[i]) {
+					continue;
+				}
+
+				if (syncedObjects[i] == null) {
+					// Object can become synced before its subtype is created. (e.g. while the player is loading)
+					ISyncedObject syncedObject = components[i].GetObjectSubtype();
+					if (syncedObject == null) {
+						continue;
+					}
+					syncedObjects[i] = syncedObject;
+					transforms[i] = syncedObject.ObjectTransform();
+					rigidbodies[i] = transforms[i].GetComponent<Rigidbody>();
+				}
+
+				// Constant synced objects are held or driven by the local player, never treat them as at rest.
+				Rigidbody rigidbody = rigidbodies[i];
+				sleeping[i] = rigidbody != null && !constantSync[i] && rigidbody.IsSleeping();
+				if (sleeping[i]) {
+					if (atRest[i]) {
+						atRestCount++;
+						continue;
+					}
+				}
+				else {
+					atRest[i] = false;
+				}
+
+				Transform transform = transforms[i];
+				positions[i] = transform.position;
+				rotations[i] = transform.rotation;
+
+				if (rigidbody != null) {
+					velocities[i] = rigidbody.velocity;
+					angularVelocities[i] = rigidbody.angularVelocity;
+				}
+				else {
+					velocities[i] = Vector3.zero;
+					angularVelocities[i] = Vector3.zero;
+				}
+			}
+
+			int sendCount = 0;
+			for (int i = 0; i < count; ++i) {
+				if (!active[i] || syncedObjects[i] == null) {
+					continue;
+				}
+
+				if (sleeping[i]) {
+					if (atRest[i]) {
+						continue;
+					}
+					// Object just fell asleep, send its final state.
+					AtRestSends++;
+				}
+				// Typically used when player is holding a pickupable, or driving a vehicle.
+				else if (constantSync[i] || syncedObjects[i].CanSync()) {
+					RequestedSends++;
+				}
+				else if (sentTimes[i] < 0.0f || time - sentTimes[i] >= HeartbeatInterval) {
+					HeartbeatSends++;
+				}
+				else {
+					// Receiver stops extrapolating after a while, predict the same.
+					float elapsed = Mathf.Min(time - sentTimes[i], ProjectiveVelocityBlender.MAX_EXTRAPOLATION);
+					Vector3 predictedPosition = DeadReckoning.PredictPosition(sentPositions[i], sentVelocities[i], elapsed);
+					Quaternion predictedRotation = DeadReckoning.PredictRotation(sentRotations[i], sentAngularVelocities[i], elapsed);
+					if (!DeadReckoning.ExceedsError(predictedPosition, predictedRotation, positions[i], rotations[i], PositionErrorThreshold, AngleErrorThreshold)) {
+						continue;
+					}
+					ErrorSends++;
+				}
+				sendIds[sendCount] = components[i].ObjectID;
+				sendQueue[sendCount++] = i;
+			}
+
+			Array.Sort(sendIds, sendQueue, 0, sendCount);
+
+			int snapshotCount = 0;
+			snapshotWriter.Reset();
+			for (int i = 0; i < sendCount; ++i) {
+				int index = sendQueue[i];
+				ISyncedObject syncedObject = syncedObjects[index];
+				SyncedVariables variables = syncedObject.UpdateSyncedVariables() ? syncedObject.GetSyncedVariables() : null;
+				// First update after the object became synced carries all variables, later ones only the changed.
+				snapshotWriter.Write(sendIds[i], positions[index], rotations[index], rigidbodies[index] != null, velocities[index], angularVelocities[index], variables, sentTimes[index] < 0.0f, sleeping[index]);
+				if (snapshotWriter.Length >= ObjectSnapshotWriter.MAX_PAYLOAD_SIZE) {
+					NetLocalPlayer.Instance.SendObjectSnapshot(snapshotWriter);
+					snapshotWriter.Reset();
+					snapshotCount++;
+				}
+
+				sentPositions[index] = positions[index];
+				sentRotations[index] = rotations[index];
+				sentTimes[index] = time;
+				if (sleeping[index]) {
+					atRest[index] = true;
+					sentVelocities[index] = Vector3.zero;
+					sentAngularVelocities[index] = Vector3.zero;
+				}
+				else {
+					sentVelocities[index] = velocities[index];
+					sentAngularVelocities[index] = angularVelocities[index];
+				}
+			}
+			if (snapshotWriter.Count > 0) {
+				NetLocalPlayer.Instance.SendObjectSnapshot(snapshotWriter);
+				snapshotCount++;
+			}
+			SentLastFrame = sendCount;
+			SnapshotsLastFrame = snapshotCount;
+			AtRestLastFrame = atRestCount;
+		}
+	}
+}
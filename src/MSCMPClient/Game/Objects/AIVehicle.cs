@@ -9,6 +9,33 @@ namespace MSCMP.Game.Objects {
 		ObjectSyncComponent syncComponent;
 		bool isSyncing = false;
 
+		/// <summary>
+		/// Types of the synced variables.
+		/// </summary>
+		static readonly SyncedVariables.Type[] VariablesSchema = {
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Int,
+			SyncedVariables.Type.Int,
+			SyncedVariables.Type.Int,
+			SyncedVariables.Type.Int,
+			SyncedVariables.Type.Bool,
+		};
+
+		const int VAR_STEERING = 0;
+		const int VAR_THROTTLE = 1;
+		const int VAR_BRAKE = 2;
+		const int VAR_TARGET_SPEED = 3;
+		const int VAR_WAYPOINT = 4;
+		const int VAR_ROUTE = 5;
+		const int VAR_WAYPOINT_START = 6;
+		const int VAR_WAYPOINT_END = 7;
+		const int VAR_CLOCKWISE = 8;
+
+		SyncedVariables syncedVariables = new SyncedVariables(VariablesSchema);
+
 		GameObject gameObject;
 		Rigidbody rigidbody;
 
@@ -222,14 +249,9 @@ namespace MSCMP.Game.Objects {
 		/// </summary>
 		/// <returns>True if object should be synced, false if it shouldn't.</returns>
 		public bool CanSync() {
-			if (rigidbody.velocity.sqrMagnitude >= 0.01f) {
-				isSyncing = true;
-				return true;
-			}
-			else {
-				isSyncing = false;
-				return false;
-			}
+			// Movement is handled by the ObjectSyncSystem, only decide if AI state should be sent with it.
+			isSyncing = rigidbody.velocity.sqrMagnitude >= 0.01f;
+			return false;
 		}
 
 		/// <summary>
@@ -241,33 +263,49 @@ namespace MSCMP.Game.Objects {
 		}
 
 		/// <summary>
-		/// Returns variables to be sent to the remote client.
+		/// Returns variables synced with the object.
 		/// </summary>
-		/// <returns>Variables to be sent to the remote client.</returns>
-		public float[] ReturnSyncedVariables(bool sendAllVariables) {
-			if (isSyncing == true) {
-				float[] variables = { Steering, Throttle, Brake, TargetSpeed, Waypoint, Route, WaypointStart, WaypointEnd, isClockwise };
-				return variables;
-			}
-			else {
-				return null;
+		/// <returns>Block of the synced variables.</returns>
+		public SyncedVariables GetSyncedVariables() {
+			return syncedVariables;
+		}
+
+		/// <summary>
+		/// Write current values of the synced variables.
+		/// </summary>
+		/// <returns>true if the vehicle is moving and variables should be sent.</returns>
+		public bool UpdateSyncedVariables() {
+			if (!isSyncing) {
+				return false;
 			}
+			syncedVariables.SetFloat(VAR_STEERING, Steering);
+			syncedVariables.SetFloat(VAR_THROTTLE, Throttle);
+			syncedVariables.SetFloat(VAR_BRAKE, Brake);
+			syncedVariables.SetFloat(VAR_TARGET_SPEED, TargetSpeed);
+			syncedVariables.SetInt(VAR_WAYPOINT, Waypoint);
+			syncedVariables.SetInt(VAR_ROUTE, Route);
+			syncedVariables.SetInt(VAR_WAYPOINT_START, WaypointStart);
+			syncedVariables.SetInt(VAR_WAYPOINT_END, WaypointEnd);
+			syncedVariables.SetBool(VAR_CLOCKWISE, isClockwise == 1);
+			return true;
 		}
 
 		/// <summary>
 		/// Handle variables sent from the remote client.
 		/// </summary>
-		public void HandleSyncedVariables(float[] variables) {
-			if (variables != null) {
-				Steering = variables[0];
-				Throttle = variables[1];
-				Brake = variables[2];
-				TargetSpeed = variables[3];
-				WaypointSet = TrafficManager.GetWaypoint(variables[4], (int)variables[5]);
-				WaypointStart = Convert.ToInt32(variables[6]);
-				WaypointEnd = Convert.ToInt32(variables[7]);
-				if (isClockwise != variables[8]) {
-					isClockwise = variables[8];
+		public void HandleSyncedVariables(uint received) {
+			// Inputs are reapplied with every update, unchanged ones keep the last received value.
+			Steering = syncedVariables.GetFloat(VAR_STEERING);
+			Throttle = syncedVariables.GetFloat(VAR_THROTTLE);
+			Brake = syncedVariables.GetFloat(VAR_BRAKE);
+			TargetSpeed = syncedVariables.GetFloat(VAR_TARGET_SPEED);
+			WaypointSet = TrafficManager.GetWaypoint(syncedVariables.GetInt(VAR_WAYPOINT), syncedVariables.GetInt(VAR_ROUTE));
+			WaypointStart = syncedVariables.GetInt(VAR_WAYPOINT_START);
+			WaypointEnd = syncedVariables.GetInt(VAR_WAYPOINT_END);
+			if (SyncedVariables.IsSet(received, VAR_CLOCKWISE)) {
+				float clockwise = syncedVariables.GetBool(VAR_CLOCKWISE) ? 1 : 0;
+				if (isClockwise != clockwise) {
+					isClockwise = clockwise;
 					if (isClockwise == 1) {
 						navigationFsm = Utils.GetPlaymakerScriptByName(parentGameObject.transform.FindChild("NavigationCW").gameObject, "Navigation");
 					}
@@ -25,6 +25,21 @@ namespace MSCMP.Game.Objects {
 
 		PlayMakerFSM driveFSM;
 
+		/// <summary>
+		/// Types of the synced variables.
+		/// </summary>
+		static readonly SyncedVariables.Type[] VariablesSchema = {
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+		};
+
+		const int VAR_THROTTLE = 0;
+		const int VAR_RPM_MAX = 1;
+		const int VAR_MOTOR_ROTATION = 2;
+
+		SyncedVariables syncedVariables = new SyncedVariables(VariablesSchema);
+
 		/// <summary>
 		/// Constructor.
 		/// </summary>
@@ -126,12 +141,8 @@ namespace MSCMP.Game.Objects {
 		/// </summary>
 		/// <returns>True if object should be synced, false if it shouldn't.</returns>
 		public bool CanSync() {
-			if (rigidbody.velocity.sqrMagnitude >= 0.01f) {
-				return true;
-			}
-			else {
-				return false;
-			}
+			// Movement is handled by the ObjectSyncSystem.
+			return false;
 		}
 
 		/// <summary>
@@ -143,31 +154,37 @@ namespace MSCMP.Game.Objects {
 		}
 
 		/// <summary>
-		/// Returns variables to be sent to the remote client.
+		/// Returns variables synced with the object.
+		/// </summary>
+		/// <returns>Block of the synced variables.</returns>
+		public SyncedVariables GetSyncedVariables() {
+			return syncedVariables;
+		}
+
+		/// <summary>
+		/// Write current values of the synced variables.
 		/// </summary>
-		/// <returns>Variables to be sent to the remote client.</returns>
-		public float[] ReturnSyncedVariables(bool sendAllVariables) {
+		/// <returns>true, variables are always sent.</returns>
+		public bool UpdateSyncedVariables() {
 			if (!engineGO.activeSelf) {
 				engineGO.SetActive(true);
 			}
-			float[] variables = {
-				engineFSM.FsmVariables.GetFsmFloat("Throttle").Value,
-				engineFSM.FsmVariables.GetFsmFloat("RPMmax").Value,
-				motorGO.transform.localRotation.y
-			};
-			return variables;
+			syncedVariables.SetFloat(VAR_THROTTLE, engineFSM.FsmVariables.GetFsmFloat("Throttle").Value);
+			syncedVariables.SetFloat(VAR_RPM_MAX, engineFSM.FsmVariables.GetFsmFloat("RPMmax").Value);
+			syncedVariables.SetFloat(VAR_MOTOR_ROTATION, motorGO.transform.localRotation.y);
+			return true;
 		}
 
 		/// <summary>
 		/// Handle variables sent from the remote client.
 		/// </summary>
-		public void HandleSyncedVariables(float[] variables) {
+		public void HandleSyncedVariables(uint received) {
 			if (!engineGO.activeSelf) {
 				engineGO.SetActive(true);
 			}
-			engineFSM.FsmVariables.GetFsmFloat("Throttle").Value = variables[0];
-			engineFSM.FsmVariables.GetFsmFloat("RPMmax").Value = variables[1];
-			motorGO.transform.localRotation = new Quaternion(motorGO.transform.localRotation.x, variables[2], motorGO.transform.localRotation.z, motorGO.transform.localRotation.w);
+			engineFSM.FsmVariables.GetFsmFloat("Throttle").Value = syncedVariables.GetFloat(VAR_THROTTLE);
+			engineFSM.FsmVariables.GetFsmFloat("RPMmax").Value = syncedVariables.GetFloat(VAR_RPM_MAX);
+			motorGO.transform.localRotation = new Quaternion(motorGO.transform.localRotation.x, syncedVariables.GetFloat(VAR_MOTOR_ROTATION), motorGO.transform.localRotation.z, motorGO.transform.localRotation.w);
 		}
 
 		/// <summary>
@@ -76,17 +76,25 @@ namespace MSCMP.Game.Objects {
 		}
 
 		/// <summary>
-		/// Returns variables to be sent to the remote client.
+		/// Returns variables synced with the object.
 		/// </summary>
-		/// <returns>Variables to be sent to the remote client.</returns>
-		public float[] ReturnSyncedVariables(bool sendAllVariables) {
+		/// <returns>null, door has no synced variables.</returns>
+		public SyncedVariables GetSyncedVariables() {
 			return null;
 		}
 
+		/// <summary>
+		/// Write current values of the synced variables.
+		/// </summary>
+		/// <returns>false, door has no synced variables.</returns>
+		public bool UpdateSyncedVariables() {
+			return false;
+		}
+
 		/// <summary>
 		/// Handle variables sent from the remote client.
 		/// </summary>
-		public void HandleSyncedVariables(float[] variables) {
+		public void HandleSyncedVariables(uint received) {
 
 		}
 
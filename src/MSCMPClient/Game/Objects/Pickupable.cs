@@ -1,5 +1,4 @@
 ﻿using System;
-using System.Collections.Generic;
 using MSCMP.Game.Objects.PickupableTypes;
 using UnityEngine;
 
@@ -20,7 +19,26 @@ namespace MSCMP.Game.Objects {
 		SubType objectType;
 
 		BeerCase beerCaseSubType;
-		int usedBottlesLast;
+
+		/// <summary>
+		/// Types of the synced variables.
+		/// </summary>
+		static readonly SyncedVariables.Type[] VariablesSchema = {
+			SyncedVariables.Type.Bool,
+		};
+
+		/// <summary>
+		/// Types of the synced variables of the beer case.
+		/// </summary>
+		static readonly SyncedVariables.Type[] BeerCaseVariablesSchema = {
+			SyncedVariables.Type.Bool,
+			SyncedVariables.Type.Int,
+		};
+
+		const int VAR_HOLDING = 0;
+		const int VAR_USED_BOTTLES = 1;
+
+		SyncedVariables syncedVariables;
 
 		/// <summary>
 		/// Constructor.
@@ -80,12 +98,8 @@ namespace MSCMP.Game.Objects {
 		/// </summary>
 		/// <returns>True if object should be synced, false if it shouldn't.</returns>
 		public bool CanSync() {
-			if (rigidbody.velocity.sqrMagnitude >= 0.01f) {
-				return true;
-			}
-			else {
-				return false;
-			}
+			// Movement is handled by the ObjectSyncSystem.
+			return false;
 		}
 
 		/// <summary>
@@ -97,49 +111,48 @@ namespace MSCMP.Game.Objects {
 		}
 
 		/// <summary>
-		/// Returns variables to be sent to the remote client.
+		/// Returns variables synced with the object.
 		/// </summary>
-		/// <returns>Variables to be sent to the remote client.</returns>
-		public float[] ReturnSyncedVariables(bool sendAllVariables) {
-			List<float> variables = new List<float>();
-			if (holdingObject) {
-				variables.Add(1);
-			}
-			else {
-				variables.Add(0);
+		/// <returns>Block of the synced variables.</returns>
+		public SyncedVariables GetSyncedVariables() {
+			// Subtype is known only after the constructor finished.
+			if (syncedVariables == null) {
+				syncedVariables = new SyncedVariables(objectType == SubType.BeerCase ? BeerCaseVariablesSchema : VariablesSchema);
 			}
+			return syncedVariables;
+		}
+
+		/// <summary>
+		/// Write current values of the synced variables.
+		/// </summary>
+		/// <returns>true, variables are always sent.</returns>
+		public bool UpdateSyncedVariables() {
+			SyncedVariables variables = GetSyncedVariables();
+			variables.SetBool(VAR_HOLDING, holdingObject);
 
 			// Beer case.
 			if (objectType == SubType.BeerCase) {
-				if (usedBottlesLast != beerCaseSubType.UsedBottles || sendAllVariables) {
-					usedBottlesLast = beerCaseSubType.UsedBottles;
-					variables.Add(beerCaseSubType.UsedBottles);
-				}
+				variables.SetInt(VAR_USED_BOTTLES, beerCaseSubType.UsedBottles);
 			}
-
-			return variables.ToArray();
+			return true;
 		}
 
 		/// <summary>
 		/// Handle variables sent from the remote client.
 		/// </summary>
-		public void HandleSyncedVariables(float[] variables) {
+		public void HandleSyncedVariables(uint received) {
 			if (rigidbody != null) {
-				if (variables[0] == 1) {
-					// Object is being held.
-					rigidbody.useGravity = false;
-				}
-				else {
-					// Object is not being held.
-					rigidbody.useGravity = true;
+				SyncedVariables variables = GetSyncedVariables();
+				if (SyncedVariables.IsSet(received, VAR_HOLDING)) {
+					// Held object is not affected by gravity.
+					rigidbody.useGravity = !variables.GetBool(VAR_HOLDING);
 				}
 
-				if (variables.Length > 1) {
-					// Beer case
-					if (objectType == SubType.BeerCase) {
-						if (variables[1] != beerCaseSubType.UsedBottles) {
-							beerCaseSubType.RemoveBottles((int)variables[1]);
-						}
+				// Beer case
+				if (objectType == SubType.BeerCase && SyncedVariables.IsSet(received, VAR_USED_BOTTLES)) {
+					int usedBottles = variables.GetInt(VAR_USED_BOTTLES);
+					if (usedBottles != beerCaseSubType.UsedBottles) {
+						beerCaseSubType.RemoveBottles(usedBottles);
 					}
 				}
 			}
@@ -11,6 +11,27 @@ namespace MSCMP.Game.Objects {
 		ObjectSyncComponent syncComponent;
 		bool isSyncing = false;
 
+		/// <summary>
+		/// Types of the synced variables.
+		/// </summary>
+		static readonly SyncedVariables.Type[] VariablesSchema = {
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Float,
+			SyncedVariables.Type.Int,
+			SyncedVariables.Type.Float,
+		};
+
+		const int VAR_STEERING = 0;
+		const int VAR_THROTTLE = 1;
+		const int VAR_BRAKE = 2;
+		const int VAR_CLUTCH = 3;
+		const int VAR_GEAR = 4;
+		const int VAR_FUEL = 5;
+
+		SyncedVariables syncedVariables = new SyncedVariables(VariablesSchema);
+
 		GameObject gameObject;
 		Rigidbody rigidbody;
 
@@ -262,12 +283,9 @@ namespace MSCMP.Game.Objects {
 				isSyncing = true;
 				return true;
 			}
-			else if (rigidbody.velocity.sqrMagnitude >= 0.01f) {
-				isSyncing = true;
-				return true;
-			}
 			else {
-				isSyncing = false;
+				// Movement is handled by the ObjectSyncSystem, only decide if vehicle state should be sent with it.
+				isSyncing = rigidbody.velocity.sqrMagnitude >= 0.01f;
 				return false;
 			}
 		}
@@ -281,31 +299,41 @@ namespace MSCMP.Game.Objects {
 		}
 
 		/// <summary>
-		/// Returns variables to be sent to the remote client.
+		/// Returns variables synced with the object.
 		/// </summary>
-		/// <returns>Variables to be sent to the remote client.</returns>
-		public float[] ReturnSyncedVariables(bool sendAllVariables) {
-			if (isSyncing == true) {
-				float[] variables = { Steering, Throttle, Brake, ClutchInput, Gear, Fuel };
-				return variables;
-			}
-			else {
-				return null;
+		/// <returns>Block of the synced variables.</returns>
+		public SyncedVariables GetSyncedVariables() {
+			return syncedVariables;
+		}
+
+		/// <summary>
+		/// Write current values of the synced variables.
+		/// </summary>
+		/// <returns>true if the vehicle is moving and variables should be sent.</returns>
+		public bool UpdateSyncedVariables() {
+			if (!isSyncing) {
+				return false;
 			}
+			syncedVariables.SetFloat(VAR_STEERING, Steering);
+			syncedVariables.SetFloat(VAR_THROTTLE, Throttle);
+			syncedVariables.SetFloat(VAR_BRAKE, Brake);
+			syncedVariables.SetFloat(VAR_CLUTCH, ClutchInput);
+			syncedVariables.SetInt(VAR_GEAR, Gear);
+			syncedVariables.SetFloat(VAR_FUEL, Fuel);
+			return true;
 		}
 
 		/// <summary>
 		/// Handle variables sent from the remote client.
 		/// </summary>
-		public void HandleSyncedVariables(float[] variables) {
-			if (variables != null) {
-				Steering = variables[0];
-				Throttle = variables[1];
-				Brake = variables[2];
-				ClutchInput = variables[3];
-				Gear = (int)variables[4];
-				Fuel = variables[5];
-			}
+		public void HandleSyncedVariables(uint received) {
+			// Inputs are reapplied with every update, unchanged ones keep the last received value.
+			Steering = syncedVariables.GetFloat(VAR_STEERING);
+			Throttle = syncedVariables.GetFloat(VAR_THROTTLE);
+			Brake = syncedVariables.GetFloat(VAR_BRAKE);
+			ClutchInput = syncedVariables.GetFloat(VAR_CLUTCH);
+			Gear = syncedVariables.GetInt(VAR_GEAR);
+			Fuel = syncedVariables.GetFloat(VAR_FUEL);
 		}
 
 		/// <summary>
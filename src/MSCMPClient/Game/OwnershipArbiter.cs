@@ -0,0 +1,63 @@
+namespace MSCMP.Game {
+	/// <summary>
+	/// Claim of the object ownership.
+	/// </summary>
+	struct OwnershipClaim {
+		/// <summary>
+		/// Steam id of the claiming player. (ObjectSyncManager.NO_OWNER if object has no owner)
+		/// </summary>
+		public ulong owner;
+
+		/// <summary>
+		/// Shared clock time of the claim in milliseconds. (See NetManager.GetSharedClock)
+		/// </summary>
+		public ulong time;
+
+		/// <summary>
+		/// Is the object taken by force? (Picked up, entered vehicle)
+		/// </summary>
+		public bool force;
+
+		public OwnershipClaim(ulong owner, ulong time, bool force) {
+			this.owner = owner;
+			this.time = time;
+			this.force = force;
+		}
+	}
+
+	/// <summary>
+	/// Resolves conflicting ownership claims.
+	/// </summary>
+	/// <remarks>
+	/// Players take ownership optimistically and send their claim with the shared clock timestamp. When two claims
+	/// meet every player compares the same two claims with the same rules so all of them agree on the winner
+	/// without another round trip.
+	///
+	/// - Claim by force beats claim without force.
+	/// - Claims without force - the earlier one wins. (Player that came close first keeps the object)
+	/// - Claims by force - the later one wins. (Player that grabbed the object last takes it)
+	/// - Same time - lower steam id wins.
+	/// </remarks>
+	static class OwnershipArbiter {
+
+		/// <summary>
+		/// Check if the challenger claim wins over the current one.
+		/// </summary>
+		/// <param name="challenger">The new claim.</param>
+		/// <param name="current">The claim of the current owner.</param>
+		/// <param name="noOwner">Owner id meaning the object has no owner.</param>
+		/// <returns>true if the challenger becomes the owner.</returns>
+		public static bool Wins(OwnershipClaim challenger, OwnershipClaim current, ulong noOwner) {
+			if (current.owner == noOwner || challenger.owner == current.owner) {
+				return true;
+			}
+			if (challenger.force != current.force) {
+				return challenger.force;
+			}
+			if (challenger.time != current.time) {
+				return challenger.force ? challenger.time > current.time : challenger.time < current.time;
+			}
+			return challenger.owner < current.owner;
+		}
+	}
+}
@@ -0,0 +1,243 @@
+using System;
+using System.Collections.Generic;
+
+namespace MSCMP.Game {
+	/// <summary>
+	/// Time-sliced round robin scheduler of the periodic object syncs.
+	/// </summary>
+	/// <remarks>
+	/// Each object type has its own period. Every frame each type accumulates credit proportional to the amount of
+	/// its objects and the elapsed time, so that over one period every object is visited once and the visits are
+	/// spread evenly across frames. The total amount of visits per frame is capped - visits over the cap are deferred
+	/// to the next frames instead of being dropped.
+	///
+	/// Scheduler does not depend on Unity - it only deals with object ids and type indices.
+	/// </remarks>
+	class PeriodicSyncScheduler {
+
+		/// <summary>
+		/// Callback trying to send periodic sync of the given object.
+		/// </summary>
+		/// <param name="objectId">The id of the object.</param>
+		/// <returns>true if sync was sent, false if object did not need it.</returns>
+		public delegate bool SendDelegate(int objectId);
+
+		/// <summary>
+		/// Objects of the single type.
+		/// </summary>
+		class TypeQueue {
+			/// <summary>
+			/// Period in seconds in which every object of this type should be visited once. (0 disables periodic sync)
+			/// </summary>
+			public float period = 0.0f;
+
+			/// <summary>
+			/// Object ids in round robin order.
+			/// </summary>
+			public List<int> objects = new List<int>();
+
+			/// <summary>
+			/// Index of the next object to visit.
+			/// </summary>
+			public int cursor = 0;
+
+			/// <summary>
+			/// Amount of visits due but not done yet.
+			/// </summary>
+			public float credit = 0.0f;
+
+			/// <summary>
+			/// Amount of the due visits already counted as deferred.
+			/// </summary>
+			public int deferred = 0;
+		}
+
+		/// <summary>
+		/// Queues indexed by object type.
+		/// </summary>
+		TypeQueue[] queues = null;
+
+		/// <summary>
+		/// Position of each registered object. (object id -> type)
+		/// </summary>
+		Dictionary<int, int> objectTypes = new Dictionary<int, int>();
+
+		/// <summary>
+		/// Maximum amount of visits per update.
+		/// </summary>
+		public int MaxPerFrame = 8;
+
+		/// <summary>
+		/// Total amount of visits that became due.
+		/// </summary>
+		public long Scheduled {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of visits that resulted in sent sync.
+		/// </summary>
+		public long Sent {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of visits where object did not need sync. (e.g. it is owned by remote player)
+		/// </summary>
+		public long Skipped {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Total amount of visits postponed to the later frames because of per frame cap. (Each visit is counted once
+		/// when it is deferred first)
+		/// </summary>
+		public long Deferred {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Amount of visits done in the last update.
+		/// </summary>
+		public int VisitedLastFrame {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="typeCount">Amount of object types.</param>
+		public PeriodicSyncScheduler(int typeCount) {
+			queues = new TypeQueue[typeCount];
+			for (int i = 0; i < typeCount; ++i) {
+				queues[i] = new TypeQueue();
+			}
+		}
+
+		/// <summary>
+		/// Set the period of the given type.
+		/// </summary>
+		/// <param name="type">The type index.</param>
+		/// <param name="seconds">The period in seconds. (0 disables periodic sync of the type)</param>
+		public void SetPeriod(int type, float seconds) {
+			queues[type].period = System.Math.Max(seconds, 0.0f);
+		}
+
+		/// <summary>
+		/// Get the period of the given type.
+		/// </summary>
+		/// <param name="type">The type index.</param>
+		/// <returns>The period in seconds.</returns>
+		public float GetPeriod(int type) {
+			return queues[type].period;
+		}
+
+		/// <summary>
+		/// Amount of registered objects.
+		/// </summary>
+		public int Count {
+			get { return objectTypes.Count; }
+		}
+
+		/// <summary>
+		/// Register object. Registering already registered object moves it to the given type.
+		/// </summary>
+		/// <param name="objectId">The id of the object.</param>
+		/// <param name="type">The type index.</param>
+		public void Add(int objectId, int type) {
+			Remove(objectId);
+			queues[type].objects.Add(objectId);
+			objectTypes.Add(objectId, type);
+		}
+
+		/// <summary>
+		/// Unregister object.
+		/// </summary>
+		/// <param name="objectId">The id of the object.</param>
+		public void Remove(int objectId) {
+			int type;
+			if (!objectTypes.TryGetValue(objectId, out type)) {
+				return;
+			}
+			objectTypes.Remove(objectId);
+
+			TypeQueue queue = queues[type];
+			int index = queue.objects.IndexOf(objectId);
+			queue.objects.RemoveAt(index);
+			if (index < queue.cursor) {
+				queue.cursor--;
+			}
+			if (queue.cursor >= queue.objects.Count) {
+				queue.cursor = 0;
+			}
+		}
+
+		/// <summary>
+		/// Unregister all objects and reset the state. (Statistics are kept)
+		/// </summary>
+		public void Clear() {
+			objectTypes.Clear();
+			foreach (TypeQueue queue in queues) {
+				queue.objects.Clear();
+				queue.cursor = 0;
+				queue.credit = 0.0f;
+				queue.deferred = 0;
+			}
+		}
+
+		/// <summary>
+		/// Advance scheduler and visit objects that are due.
+		/// </summary>
+		/// <param name="deltaTime">Time elapsed since the last update in seconds.</param>
+		/// <param name="send">Callback sending periodic sync of the object.</param>
+		public void Update(float deltaTime, SendDelegate send) {
+			int budget = MaxPerFrame;
+			VisitedLastFrame = 0;
+
+			foreach (TypeQueue queue in queues) {
+				int count = queue.objects.Count;
+				if (queue.period <= 0.0f || count == 0) {
+					queue.credit = 0.0f;
+					queue.deferred = 0;
+					continue;
+				}
+
+				float newCredit = count * deltaTime / queue.period;
+				Scheduled += (long)(queue.credit + newCredit) - (long)queue.credit;
+
+				// Never keep more than one full round as backlog - nothing is gained by syncing the same object twice in a row.
+				queue.credit = System.Math.Min(queue.credit + newCredit, count);
+
+				int due = (int)queue.credit;
+				int visits = System.Math.Min(due, budget);
+
+				// Backlog is visited first, count only the visits deferred for the first time.
+				int stillDeferred = System.Math.Max(queue.deferred - visits, 0);
+				queue.deferred = due - visits;
+				Deferred += System.Math.Max(queue.deferred - stillDeferred, 0);
+
+				for (int i = 0; i < visits; ++i) {
+					// Callback can unregister objects so check the bounds every time.
+					if (queue.objects.Count == 0) {
+						break;
+					}
+					if (queue.cursor >= queue.objects.Count) {
+						queue.cursor = 0;
+					}
+
+					int objectId = queue.objects[queue.cursor++];
+					if (send(objectId)) {
+						Sent++;
+					}
+					else {
+						Skipped++;
+					}
+				}
+
+				queue.credit -= visits;
+				budget -= visits;
+				VisitedLastFrame += visits;
+			}
+		}
+	}
+}
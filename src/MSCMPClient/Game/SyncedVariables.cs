@@ -0,0 +1,245 @@
+using System;
+using System.IO;
+using MSCMP.Math;
+
+namespace MSCMP.Game {
+	/// <summary>
+	/// Typed block of the variables synced together with the object's transform.
+	/// </summary>
+	/// <remarks>
+	/// Each object type declares a schema - types of its variables - and keeps one block per object. The owner
+	/// writes current values into the block before the object is sent, values that differ from the previous
+	/// ones are marked as changed and only those are serialized. The receiver decodes straight into its block
+	/// of the same object and is told which variables were received.
+	///
+	/// Encoding is the varint mask of the variables followed by their values in the schema order. Floats take
+	/// 4 bytes, ints are zigzag varints and bools take single byte.
+	/// </remarks>
+	class SyncedVariables {
+
+		/// <summary>
+		/// Type of the synced variable.
+		/// </summary>
+		public enum Type : byte {
+			Float,
+			Int,
+			Bool,
+		}
+
+		/// <summary>
+		/// Maximum amount of variables in the block. (Size of the change mask)
+		/// </summary>
+		public const int MAX_VARIABLES = 32;
+
+		/// <summary>
+		/// Types of the variables.
+		/// </summary>
+		readonly Type[] schema;
+
+		/// <summary>
+		/// Values of the float variables. (Indexed by the variable index)
+		/// </summary>
+		readonly float[] floats;
+
+		/// <summary>
+		/// Values of the int and bool variables. (Indexed by the variable index)
+		/// </summary>
+		readonly int[] ints;
+
+		/// <summary>
+		/// Mask with bit set for every variable in the schema.
+		/// </summary>
+		readonly uint allMask;
+
+		/// <summary>
+		/// Variables changed since the last write.
+		/// </summary>
+		uint changedMask;
+
+		/// <summary>
+		/// Scratch stream used by ToArray.
+		/// </summary>
+		static MemoryStream scratchStream = new MemoryStream();
+		static BinaryWriter scratchWriter = new BinaryWriter(scratchStream);
+
+		/// <summary>
+		/// Create block of the variables.
+		/// </summary>
+		/// <param name="schema">Types of the variables. (Shared by all objects of the same type)</param>
+		public SyncedVariables(Type[] schema) {
+			Client.Assert(schema.Length <= MAX_VARIABLES, $"Too many synced variables. ({schema.Length})");
+			this.schema = schema;
+			floats = new float[schema.Length];
+			ints = new int[schema.Length];
+			allMask = schema.Length == MAX_VARIABLES ? uint.MaxValue : (1u << schema.Length) - 1;
+			changedMask = allMask;
+		}
+
+		/// <summary>
+		/// Are there any changed variables to send?
+		/// </summary>
+		public bool HasChanges {
+			get { return changedMask != 0; }
+		}
+
+		/// <summary>
+		/// Mark all variables as changed so the next write sends all of them.
+		/// </summary>
+		public void MarkAllChanged() {
+			changedMask = allMask;
+		}
+
+		/// <summary>
+		/// Get value of the float variable.
+		/// </summary>
+		/// <param name="index">Index of the variable.</param>
+		/// <returns>The value.</returns>
+		public float GetFloat(int index) {
+			return floats[index];
+		}
+
+		/// <summary>
+		/// Get value of the int variable.
+		/// </summary>
+		/// <param name="index">Index of the variable.</param>
+		/// <returns>The value.</returns>
+		public int GetInt(int index) {
+			return ints[index];
+		}
+
+		/// <summary>
+		/// Get value of the bool variable.
+		/// </summary>
+		/// <param name="index">Index of the variable.</param>
+		/// <returns>The value.</returns>
+		public bool GetBool(int index) {
+			return ints[index] != 0;
+		}
+
+		/// <summary>
+		/// Set value of the float variable. Variable is marked as changed if the value differs.
+		/// </summary>
+		/// <param name="index">Index of the variable.</param>
+		/// <param name="value">The value.</param>
+		public void SetFloat(int index, float value) {
+			if (floats[index] != value) {
+				floats[index] = value;
+				changedMask |= 1u << index;
+			}
+		}
+
+		/// <summary>
+		/// Set value of the int variable. Variable is marked as changed if the value differs.
+		/// </summary>
+		/// <param name="index">Index of the variable.</param>
+		/// <param name="value">The value.</param>
+		public void SetInt(int index, int value) {
+			if (ints[index] != value) {
+				ints[index] = value;
+				changedMask |= 1u << index;
+			}
+		}
+
+		/// <summary>
+		/// Set value of the bool variable. Variable is marked as changed if the value differs.
+		/// </summary>
+		/// <param name="index">Index of the variable.</param>
+		/// <param name="value">The value.</param>
+		public void SetBool(int index, bool value) {
+			SetInt(index, value ? 1 : 0);
+		}
+
+		/// <summary>
+		/// Check if the variable is set in the mask.
+		/// </summary>
+		/// <param name="mask">The mask. (e.g. received by Read)</param>
+		/// <param name="index">Index of the variable.</param>
+		/// <returns>true if variable is set in the mask.</returns>
+		public static bool IsSet(uint mask, int index) {
+			return (mask & (1u << index)) != 0;
+		}
+
+		/// <summary>
+		/// Serialize changed variables and clear the change mask.
+		/// </summary>
+		/// <param name="writer">The writer.</param>
+		/// <param name="all">Serialize all variables regardless of the changes.</param>
+		public void Write(BinaryWriter writer, bool all) {
+			uint mask = all ? allMask : changedMask;
+			changedMask = 0;
+
+			VarInt.WriteUInt(writer, mask);
+			for (int i = 0; i < schema.Length; ++i) {
+				if (!IsSet(mask, i)) {
+					continue;
+				}
+				switch (schema[i]) {
+					case Type.Float:
+						writer.Write(floats[i]);
+						break;
+					case Type.Int:
+						VarInt.WriteUInt(writer, VarInt.ZigZagEncode(ints[i]));
+						break;
+					case Type.Bool:
+						writer.Write((byte)ints[i]);
+						break;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Serialize changed variables into the new array and clear the change mask.
+		/// </summary>
+		/// <param name="all">Serialize all variables regardless of the changes.</param>
+		/// <returns>Serialized variables.</returns>
+		public byte[] ToArray(bool all) {
+			scratchStream.SetLength(0);
+			Write(scratchWriter, all);
+			return scratchStream.ToArray();
+		}
+
+		/// <summary>
+		/// Deserialize variables written by Write.
+		/// </summary>
+		/// <param name="data">Buffer containing the variables.</param>
+		/// <param name="offset">Offset of the variables in the buffer.</param>
+		/// <param name="length">Size of the variables in bytes.</param>
+		/// <param name="received">Mask of the received variables.</param>
+		/// <returns>false if the data is malformed or does not match the schema.</returns>
+		public bool Read(byte[] data, int offset, int length, out uint received) {
+			int end = offset + length;
+			if (!VarInt.TryReadUInt(data, ref offset, end, out received) || (received & ~allMask) != 0) {
+				return false;
+			}
+
+			for (int i = 0; i < schema.Length; ++i) {
+				if (!IsSet(received, i)) {
+					continue;
+				}
+				switch (schema[i]) {
+					case Type.Float:
+						if (offset + sizeof(float) > end) {
+							return false;
+						}
+						floats[i] = BitConverter.ToSingle(data, offset);
+						offset += sizeof(float);
+						break;
+					case Type.Int:
+						uint zigzag;
+						if (!VarInt.TryReadUInt(data, ref offset, end, out zigzag)) {
+							return false;
+						}
+						ints[i] = VarInt.ZigZagDecode(zigzag);
+						break;
+					case Type.Bool:
+						if (offset >= end) {
+							return false;
+						}
+						ints[i] = data[offset++] != 0 ? 1 : 0;
+						break;
+				}
+			}
+			return offset == end;
+		}
+	}
+}
@@ -71,6 +71,13 @@ namespace MSCMP {
 #endif
 		}
 
+		void OnDestroy() {
+			if (netManager != null) {
+				netManager.Dispose();
+				netManager = null;
+			}
+		}
+
 		/// <summary>
 		/// Callback called when unity loads new event.
 		/// </summary>
@@ -0,0 +1,56 @@
+using UnityEngine;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Extrapolation model shared by the sender and the receiver of the object syncs.
+	/// </summary>
+	/// <remarks>
+	/// Sender runs the same prediction the receiver does and only sends new state when the prediction
+	/// drifts from the real transform by more than the error thresholds.
+	/// </remarks>
+	static class DeadReckoning {
+
+		/// <summary>
+		/// Predict position after the given time.
+		/// </summary>
+		/// <param name="position">Last known position.</param>
+		/// <param name="velocity">Last known linear velocity.</param>
+		/// <param name="deltaTime">Time elapsed since the last known state in seconds.</param>
+		/// <returns>Predicted position.</returns>
+		public static Vector3 PredictPosition(Vector3 position, Vector3 velocity, float deltaTime) {
+			return position + velocity * deltaTime;
+		}
+
+		/// <summary>
+		/// Predict rotation after the given time.
+		/// </summary>
+		/// <param name="rotation">Last known rotation.</param>
+		/// <param name="angularVelocity">Last known angular velocity in radians per second. (world space)</param>
+		/// <param name="deltaTime">Time elapsed since the last known state in seconds.</param>
+		/// <returns>Predicted rotation.</returns>
+		public static Quaternion PredictRotation(Quaternion rotation, Vector3 angularVelocity, float deltaTime) {
+			float speed = angularVelocity.magnitude;
+			if (speed < 0.0001f) {
+				return rotation;
+			}
+			return Quaternion.AngleAxis(speed * deltaTime * Mathf.Rad2Deg, angularVelocity / speed) * rotation;
+		}
+
+		/// <summary>
+		/// Check if the predicted transform diverges from the real one more than allowed.
+		/// </summary>
+		/// <param name="predictedPosition">The predicted position.</param>
+		/// <param name="predictedRotation">The predicted rotation.</param>
+		/// <param name="position">The real position.</param>
+		/// <param name="rotation">The real rotation.</param>
+		/// <param name="positionThreshold">Maximum allowed position error in meters.</param>
+		/// <param name="angleThreshold">Maximum allowed rotation error in degrees.</param>
+		/// <returns>true if the error exceeds any of the thresholds.</returns>
+		public static bool ExceedsError(Vector3 predictedPosition, Quaternion predictedRotation, Vector3 position, Quaternion rotation, float positionThreshold, float angleThreshold) {
+			if ((position - predictedPosition).sqrMagnitude > positionThreshold * positionThreshold) {
+				return true;
+			}
+			return Quaternion.Angle(predictedRotation, rotation) > angleThreshold;
+		}
+	}
+}
@@ -0,0 +1,172 @@
+using UnityEngine;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Smooths remote object state using projective velocity blending.
+	/// </summary>
+	/// <remarks>
+	/// When new state arrives two trajectories are projected - one from the state the object had when the update
+	/// arrived moving with velocity blended towards the new one, and one extrapolated from the received state.
+	/// The result moves from the first trajectory to the second over the blend duration, so the object never
+	/// jumps but still converges to the sender's motion. (See DeadReckoning for the extrapolation model)
+	///
+	/// Last few received states are kept with the time the sender took them. They are used to estimate velocity
+	/// when the sender did not send it and to derive blend duration from the update interval. The received state
+	/// is extrapolated from the time it was taken, so the transit time does not lag the object behind.
+	/// </remarks>
+	class ProjectiveVelocityBlender {
+
+		/// <summary>
+		/// Received state.
+		/// </summary>
+		struct State {
+			public float time;
+			public Vector3 position;
+			public Quaternion rotation;
+			public Vector3 velocity;
+			public Vector3 angularVelocity;
+		}
+
+		/// <summary>
+		/// Amount of buffered received states.
+		/// </summary>
+		const int BUFFER_SIZE = 4;
+
+		/// <summary>
+		/// Minimum blend duration in seconds.
+		/// </summary>
+		const float MIN_BLEND_DURATION = 0.05f;
+
+		/// <summary>
+		/// Maximum blend duration in seconds.
+		/// </summary>
+		const float MAX_BLEND_DURATION = 0.3f;
+
+		/// <summary>
+		/// How long in seconds after the last received state is the object extrapolated.
+		/// </summary>
+		public const float MAX_EXTRAPOLATION = 1.0f;
+
+		/// <summary>
+		/// Ring buffer of the received states.
+		/// </summary>
+		State[] states = new State[BUFFER_SIZE];
+
+		/// <summary>
+		/// Amount of received states. (Not wrapped, index of the next state is received % BUFFER_SIZE)
+		/// </summary>
+		int received = 0;
+
+		/// <summary>
+		/// State of the object at the time the last update arrived.
+		/// </summary>
+		State blendStart;
+
+		/// <summary>
+		/// Duration of the current blend in seconds.
+		/// </summary>
+		float blendDuration = MIN_BLEND_DURATION;
+
+		/// <summary>
+		/// Time the last received state was taken. (or negative if there is none)
+		/// </summary>
+		public float LastStateTime {
+			get { return received > 0 ? Latest.time : -1.0f; }
+		}
+
+		/// <summary>
+		/// The last received state.
+		/// </summary>
+		State Latest {
+			get { return states[(received - 1) % BUFFER_SIZE]; }
+		}
+
+		/// <summary>
+		/// Forget all received states.
+		/// </summary>
+		public void Reset() {
+			received = 0;
+		}
+
+		/// <summary>
+		/// Add received state.
+		/// </summary>
+		/// <param name="time">Arrival time of the state.</param>
+		/// <param name="stateTime">Time the sender took the state. (Mapped to the local time, not later than the arrival)</param>
+		/// <param name="position">Received position.</param>
+		/// <param name="rotation">Received rotation.</param>
+		/// <param name="hasVelocity">Does received state contain velocities?</param>
+		/// <param name="velocity">Received linear velocity.</param>
+		/// <param name="angularVelocity">Received angular velocity.</param>
+		/// <param name="currentPosition">Current position of the object.</param>
+		/// <param name="currentRotation">Current rotation of the object.</param>
+		/// <param name="currentVelocity">Current linear velocity of the object.</param>
+		/// <returns>false if the state is older than the last received one and was dropped.</returns>
+		public bool AddState(float time, float stateTime, Vector3 position, Quaternion rotation, bool hasVelocity, Vector3 velocity, Vector3 angularVelocity, Vector3 currentPosition, Quaternion currentRotation, Vector3 currentVelocity) {
+			State state;
+			state.time = stateTime;
+			state.position = position;
+			state.rotation = rotation;
+			state.velocity = velocity;
+			state.angularVelocity = angularVelocity;
+
+			if (received > 0) {
+				State previous = Latest;
+				float interval = stateTime - previous.time;
+				if (interval < 0.0f) {
+					return false;
+				}
+				if (!hasVelocity && interval > 0.0001f) {
+					// Sender did not send velocity, estimate it from the previous state.
+					state.velocity = (position - previous.position) / interval;
+					state.angularVelocity = Vector3.zero;
+				}
+				blendDuration = Mathf.Clamp(interval, MIN_BLEND_DURATION, MAX_BLEND_DURATION);
+			}
+
+			blendStart.time = time;
+			blendStart.position = currentPosition;
+			blendStart.rotation = currentRotation;
+			blendStart.velocity = currentVelocity;
+
+			states[received % BUFFER_SIZE] = state;
+			received++;
+			return true;
+		}
+
+		/// <summary>
+		/// Evaluate smoothed state at the given time.
+		/// </summary>
+		/// <param name="time">The time.</param>
+		/// <param name="position">Smoothed position.</param>
+		/// <param name="rotation">Smoothed rotation.</param>
+		/// <param name="velocity">Velocity along the smoothed trajectory.</param>
+		/// <returns>false if there is no state or the blend finished and extrapolation expired. (Object can be left to the physics)</returns>
+		public bool Evaluate(float time, out Vector3 position, out Quaternion rotation, out Vector3 velocity) {
+			if (received == 0) {
+				position = Vector3.zero;
+				rotation = Quaternion.identity;
+				velocity = Vector3.zero;
+				return false;
+			}
+
+			State latest = Latest;
+			float elapsed = Mathf.Min(time - latest.time, MAX_EXTRAPOLATION);
+			float alpha = Mathf.Clamp01((time - blendStart.time) / blendDuration);
+
+			// Trajectory extrapolated from the received state.
+			Vector3 projectedPosition = DeadReckoning.PredictPosition(latest.position, latest.velocity, elapsed);
+			Quaternion projectedRotation = DeadReckoning.PredictRotation(latest.rotation, latest.angularVelocity, elapsed);
+
+			// Trajectory from where the object was when the state arrived.
+			velocity = Vector3.Lerp(blendStart.velocity, latest.velocity, alpha);
+			Vector3 startPosition = DeadReckoning.PredictPosition(blendStart.position, velocity, Mathf.Min(time - blendStart.time, MAX_EXTRAPOLATION));
+
+			position = Vector3.Lerp(startPosition, projectedPosition, alpha);
+			rotation = Quaternion.Slerp(blendStart.rotation, projectedRotation, alpha);
+
+			bool moving = latest.velocity.sqrMagnitude > 0.0001f || latest.angularVelocity.sqrMagnitude > 0.0001f;
+			return alpha < 1.0f || (moving && time - latest.time < MAX_EXTRAPOLATION);
+		}
+	}
+}
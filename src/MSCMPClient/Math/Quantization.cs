@@ -0,0 +1,162 @@
+using UnityEngine;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Fixed point encoding of the transforms sent over the network.
+	/// </summary>
+	static class Quantization {
+
+		/// <summary>
+		/// Maximum absolute value of the position coordinate in meters. (24 bits give ~1 mm precision)
+		/// </summary>
+		public const float POSITION_RANGE = 8192.0f;
+
+		/// <summary>
+		/// Maximum absolute value of the linear velocity component in meters per second.
+		/// </summary>
+		public const float VELOCITY_RANGE = 128.0f;
+
+		/// <summary>
+		/// Maximum absolute value of the angular velocity component in radians per second.
+		/// </summary>
+		public const float ANGULAR_VELOCITY_RANGE = 32.0f;
+
+		const int POSITION_MAX = (1 << 24) - 1;
+		const int ROTATION_BITS = 10;
+		const int ROTATION_MAX = (1 << ROTATION_BITS) - 1;
+
+		/// <summary>
+		/// Range of the three smallest quaternion components. (1 / sqrt(2))
+		/// </summary>
+		const float ROTATION_RANGE = 0.707107f;
+
+		/// <summary>
+		/// Quantize position coordinate to 24 bits.
+		/// </summary>
+		/// <param name="value">The coordinate.</param>
+		/// <returns>Quantized coordinate.</returns>
+		public static int QuantizePosition(float value) {
+			float normalized = (Mathf.Clamp(value, -POSITION_RANGE, POSITION_RANGE) + POSITION_RANGE) / (2.0f * POSITION_RANGE);
+			return Mathf.RoundToInt(normalized * POSITION_MAX);
+		}
+
+		/// <summary>
+		/// Restore position coordinate quantized by QuantizePosition.
+		/// </summary>
+		/// <param name="value">Quantized coordinate.</param>
+		/// <returns>The coordinate.</returns>
+		public static float DequantizePosition(int value) {
+			return (float)value / POSITION_MAX * (2.0f * POSITION_RANGE) - POSITION_RANGE;
+		}
+
+		/// <summary>
+		/// Quantize value from the [-range, range] interval to 16 bits.
+		/// </summary>
+		/// <param name="value">The value.</param>
+		/// <param name="range">Maximum absolute value.</param>
+		/// <returns>Quantized value.</returns>
+		public static short QuantizeSigned(float value, float range) {
+			return (short)Mathf.RoundToInt(Mathf.Clamp(value, -range, range) / range * short.MaxValue);
+		}
+
+		/// <summary>
+		/// Restore value quantized by QuantizeSigned.
+		/// </summary>
+		/// <param name="value">Quantized value.</param>
+		/// <param name="range">Maximum absolute value.</param>
+		/// <returns>The value.</returns>
+		public static float DequantizeSigned(short value, float range) {
+			return (float)value / short.MaxValue * range;
+		}
+
+		/// <summary>
+		/// Quantize value from the [min, max] interval to 8 bits.
+		/// </summary>
+		/// <param name="value">The value.</param>
+		/// <param name="min">Minimal value.</param>
+		/// <param name="max">Maximal value.</param>
+		/// <returns>Quantized value.</returns>
+		public static byte QuantizeByte(float value, float min, float max) {
+			return (byte)Mathf.RoundToInt((Mathf.Clamp(value, min, max) - min) / (max - min) * byte.MaxValue);
+		}
+
+		/// <summary>
+		/// Restore value quantized by QuantizeByte.
+		/// </summary>
+		/// <param name="value">Quantized value.</param>
+		/// <param name="min">Minimal value.</param>
+		/// <param name="max">Maximal value.</param>
+		/// <returns>The value.</returns>
+		public static float DequantizeByte(byte value, float min, float max) {
+			return min + (float)value / byte.MaxValue * (max - min);
+		}
+
+		/// <summary>
+		/// Encode rotation using the smallest three representation. The largest component is dropped and
+		/// restored from the unit length, the remaining three are stored in 10 bits each. (~0.2 degree precision)
+		/// </summary>
+		/// <param name="rotation">The rotation.</param>
+		/// <returns>Rotation packed into 32 bits.</returns>
+		public static uint QuantizeRotation(Quaternion rotation) {
+			float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+			float length = Mathf.Sqrt(x * x + y * y + z * z + w * w);
+			if (length < 0.0001f) {
+				x = y = z = 0.0f;
+				w = 1.0f;
+			}
+			else {
+				x /= length; y /= length; z /= length; w /= length;
+			}
+
+			uint largest = 0;
+			float largestValue = Mathf.Abs(x);
+			if (Mathf.Abs(y) > largestValue) { largest = 1; largestValue = Mathf.Abs(y); }
+			if (Mathf.Abs(z) > largestValue) { largest = 2; largestValue = Mathf.Abs(z); }
+			if (Mathf.Abs(w) > largestValue) { largest = 3; }
+
+			float a, b, c, dropped;
+			switch (largest) {
+				case 0: dropped = x; a = y; b = z; c = w; break;
+				case 1: dropped = y; a = x; b = z; c = w; break;
+				case 2: dropped = z; a = x; b = y; c = w; break;
+				default: dropped = w; a = x; b = y; c = z; break;
+			}
+
+			// q and -q are the same rotation, keep the dropped component positive.
+			if (dropped < 0.0f) {
+				a = -a; b = -b; c = -c;
+			}
+
+			return (largest << 30) | (QuantizeRotationComponent(a) << 20) | (QuantizeRotationComponent(b) << 10) | QuantizeRotationComponent(c);
+		}
+
+		/// <summary>
+		/// Restore rotation encoded by QuantizeRotation.
+		/// </summary>
+		/// <param name="value">Packed rotation.</param>
+		/// <returns>The rotation.</returns>
+		public static Quaternion DequantizeRotation(uint value) {
+			uint largest = value >> 30;
+			float a = DequantizeRotationComponent((value >> 20) & ROTATION_MAX);
+			float b = DequantizeRotationComponent((value >> 10) & ROTATION_MAX);
+			float c = DequantizeRotationComponent(value & ROTATION_MAX);
+			float dropped = Mathf.Sqrt(Mathf.Max(0.0f, 1.0f - a * a - b * b - c * c));
+
+			switch (largest) {
+				case 0: return new Quaternion(dropped, a, b, c);
+				case 1: return new Quaternion(a, dropped, b, c);
+				case 2: return new Quaternion(a, b, dropped, c);
+				default: return new Quaternion(a, b, c, dropped);
+			}
+		}
+
+		static uint QuantizeRotationComponent(float value) {
+			float normalized = (Mathf.Clamp(value, -ROTATION_RANGE, ROTATION_RANGE) + ROTATION_RANGE) / (2.0f * ROTATION_RANGE);
+			return (uint)Mathf.RoundToInt(normalized * ROTATION_MAX);
+		}
+
+		static float DequantizeRotationComponent(uint value) {
+			return (float)value / ROTATION_MAX * (2.0f * ROTATION_RANGE) - ROTATION_RANGE;
+		}
+	}
+}
@@ -0,0 +1,474 @@
+using UnityEngine;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Jitter buffer of the timestamped transforms received from the remote player.
+	/// </summary>
+	/// <remarks>
+	/// Snapshots are stored on the sender's timeline and played back with a delay - the local clock is mapped to
+	/// the sender's clock and the playout delay is subtracted - so the transform is always interpolated between
+	/// two received snapshots even if the packets arrive unevenly. The delay adapts to the measured send interval
+	/// and jitter. (RFC 3550 interarrival jitter estimate)
+	///
+	/// Snapshots arriving out of order are inserted in order as long as they are still ahead of the playback,
+	/// older ones are dropped. Missing snapshots are interpolated over, when the buffer runs dry the last motion
+	/// is extrapolated for a short time and then held.
+	///
+	/// Positions are interpolated by cubic Hermite spline and rotations by squad through the window of four
+	/// snapshots around the playback time. Velocities at the snapshots are estimated from their neighbours so the
+	/// speed does not change abruptly at the snapshots on direction changes.
+	/// </remarks>
+	class SnapshotBuffer {
+
+		/// <summary>
+		/// Interpolation between the snapshots.
+		/// </summary>
+		public enum InterpolationMode {
+			/// <summary>
+			/// Lerp and slerp between two snapshots.
+			/// </summary>
+			Linear,
+			/// <summary>
+			/// Hermite and squad through four snapshots.
+			/// </summary>
+			Hermite,
+		}
+
+		struct Snapshot {
+			public long time;
+			public Vector3 position;
+			public Quaternion rotation;
+		}
+
+		/// <summary>
+		/// Segment between two snapshots prepared for the interpolation. (Hermite tangents and squad control points)
+		/// </summary>
+		public struct Window {
+			public Vector3 p0, m0, p1, m1;
+			public Quaternion q1, a1, a2, q2;
+
+			/// <summary>
+			/// Set window holding the single transform.
+			/// </summary>
+			public void Hold(Vector3 position, Quaternion rotation) {
+				p0 = p1 = position;
+				m0 = m1 = Vector3.zero;
+				q1 = a1 = a2 = q2 = rotation;
+			}
+
+			/// <summary>
+			/// Evaluate the transform within the window.
+			/// </summary>
+			/// <param name="t">Interpolation factor.</param>
+			/// <param name="position">Interpolated position.</param>
+			/// <param name="rotation">Interpolated rotation.</param>
+			public void Evaluate(float t, out Vector3 position, out Quaternion rotation) {
+				position = Spline.Hermite(p0, m0, p1, m1, t);
+				rotation = Spline.Squad(q1, a1, a2, q2, t);
+			}
+		}
+
+		/// <summary>
+		/// Maximum amount of buffered snapshots. (The oldest snapshot is dropped when the buffer is full)
+		/// </summary>
+		public const int CAPACITY = 32;
+
+		/// <summary>
+		/// Playout delay limits in milliseconds.
+		/// </summary>
+		public const float MIN_DELAY = 50.0f;
+		public const float MAX_DELAY = 500.0f;
+
+		/// <summary>
+		/// Playout delay in send intervals. (Single lost snapshot is interpolated over)
+		/// </summary>
+		const float INTERVAL_MULTIPLIER = 2.0f;
+
+		/// <summary>
+		/// Gaps between the snapshots longer than this many send intervals are pauses of the sender.
+		/// </summary>
+		const float PAUSE_INTERVALS = 4.0f;
+
+		/// <summary>
+		/// How many jitters are added to the send intervals to get the playout delay.
+		/// </summary>
+		const float JITTER_MULTIPLIER = 3.0f;
+
+		/// <summary>
+		/// For how long the motion is extrapolated when the buffer runs dry in milliseconds.
+		/// </summary>
+		const float MAX_EXTRAPOLATION = 100.0f;
+
+		/// <summary>
+		/// Maximum playback speed change used to follow the delay changes. (Larger differences jump)
+		/// </summary>
+		const double MAX_TIME_WARP = 0.1;
+
+		/// <summary>
+		/// Snapshots ordered by time. (Ring buffer)
+		/// </summary>
+		Snapshot[] snapshots = new Snapshot[CAPACITY];
+		int first = 0;
+		int count = 0;
+
+		/// <summary>
+		/// The last snapshot that was removed from the buffer. (Used to extrapolate)
+		/// </summary>
+		Snapshot previous;
+		bool hasPrevious = false;
+
+		/// <summary>
+		/// Segment being interpolated and the snapshots it was built from.
+		/// </summary>
+		Window window;
+		bool hasWindow = false;
+
+		/// <summary>
+		/// Is the window still built from the first snapshots? (Cleared when a snapshot is inserted among them)
+		/// </summary>
+		bool windowValid = false;
+		InterpolationMode windowMode;
+		long windowBefore, windowFrom, windowTo, windowAfter;
+
+		/// <summary>
+		/// Lowest seen difference between the local receive time and sender's time. (Maps sender's timeline to local clock)
+		/// </summary>
+		long clockOffset = 0;
+		bool hasClock = false;
+
+		long lastSenderTime = 0;
+		long lastReceiveTime = 0;
+
+		/// <summary>
+		/// Smoothed difference of the interarrival times in milliseconds.
+		/// </summary>
+		float jitter = 0.0f;
+
+		/// <summary>
+		/// Smoothed send interval in milliseconds.
+		/// </summary>
+		float interval = 0.0f;
+
+		/// <summary>
+		/// Current playback time on the sender's timeline.
+		/// </summary>
+		double playbackTime = 0.0;
+		long lastSampleTime = 0;
+		bool hasPlayback = false;
+
+		/// <summary>
+		/// Interpolation between the snapshots.
+		/// </summary>
+		public InterpolationMode Interpolation {
+			get; set;
+		}
+
+		/// <summary>
+		/// Current playback time on the sender's timeline in milliseconds.
+		/// </summary>
+		public double PlaybackTime {
+			get { return playbackTime; }
+		}
+
+		public SnapshotBuffer() {
+			Interpolation = InterpolationMode.Hermite;
+		}
+
+		/// <summary>
+		/// Amount of snapshots currently buffered.
+		/// </summary>
+		public int Count {
+			get { return count; }
+		}
+
+		/// <summary>
+		/// Current playout delay in milliseconds.
+		/// </summary>
+		public float Delay {
+			get { return Mathf.Clamp(INTERVAL_MULTIPLIER * interval + JITTER_MULTIPLIER * jitter, MIN_DELAY, MAX_DELAY); }
+		}
+
+		/// <summary>
+		/// Measured jitter in milliseconds.
+		/// </summary>
+		public float Jitter {
+			get { return jitter; }
+		}
+
+		/// <summary>
+		/// Amount of snapshots dropped because they arrived after their time was played back.
+		/// </summary>
+		public int LateSnapshots {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Was the last sample extrapolated or held because the buffer ran dry?
+		/// </summary>
+		public bool Starved {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Add received snapshot.
+		/// </summary>
+		/// <param name="senderTime">Sender's clock when the snapshot was taken in milliseconds.</param>
+		/// <param name="receiveTime">Local clock when the snapshot was received in milliseconds.</param>
+		/// <param name="position">The position.</param>
+		/// <param name="rotation">The rotation.</param>
+		/// <returns>false if the snapshot was dropped. (Late or duplicate)</returns>
+		public bool Add(ulong senderTime, ulong receiveTime, Vector3 position, Quaternion rotation) {
+			long sent = (long)senderTime;
+			long received = (long)receiveTime;
+			long transit = received - sent;
+
+			if (!hasClock) {
+				clockOffset = transit;
+				hasClock = true;
+			}
+			else if (sent > lastSenderTime) {
+				// RFC 3550 jitter and send interval, measured on in order snapshots only.
+				long difference = (received - lastReceiveTime) - (sent - lastSenderTime);
+				jitter += (System.Math.Abs(difference) - jitter) / 16.0f;
+				// Pauses of the sender don't change the interval. (e.g. idle player sending keepalives only)
+				long gap = sent - lastSenderTime;
+				if (interval <= 0.0f) {
+					interval = gap;
+				}
+				else if (gap <= PAUSE_INTERVALS * interval) {
+					interval += (gap - interval) / 16.0f;
+				}
+
+				// Follow the lowest transit time, relax slowly upwards so clock drift is followed too.
+				if (transit < clockOffset) {
+					clockOffset = transit;
+				}
+				else {
+					clockOffset += (transit - clockOffset) / 64;
+				}
+			}
+
+			if (sent > lastSenderTime || count == 0) {
+				lastSenderTime = sent;
+				lastReceiveTime = received;
+			}
+
+			if (hasPlayback && sent <= playbackTime) {
+				LateSnapshots++;
+				return false;
+			}
+
+			// Find place for the snapshot, usually it is the newest one.
+			int index = count;
+			while (index > 0 && At(index - 1).time >= sent) {
+				if (At(index - 1).time == sent) {
+					return false;
+				}
+				index--;
+			}
+
+			if (count == CAPACITY) {
+				if (index == 0) {
+					return false;
+				}
+				RemoveFirst();
+				windowValid = false;
+				index--;
+			}
+
+			// Snapshot changes the current segment or its following snapshot.
+			if (index <= 2) {
+				windowValid = false;
+			}
+
+			for (int i = count; i > index; --i) {
+				snapshots[(first + i) % CAPACITY] = At(i - 1);
+			}
+			Snapshot snapshot;
+			snapshot.time = sent;
+			snapshot.position = position;
+			snapshot.rotation = rotation;
+			snapshots[(first + index) % CAPACITY] = snapshot;
+			count++;
+			return true;
+		}
+
+		/// <summary>
+		/// Sample the transform at the current playback time.
+		/// </summary>
+		/// <param name="localTime">Local clock in milliseconds.</param>
+		/// <param name="position">Sampled position.</param>
+		/// <param name="rotation">Sampled rotation.</param>
+		/// <returns>false if there is nothing to sample.</returns>
+		public bool Sample(ulong localTime, out Vector3 position, out Quaternion rotation) {
+			float t;
+			if (!Prepare(localTime, out t)) {
+				position = Vector3.zero;
+				rotation = Quaternion.identity;
+				return false;
+			}
+			window.Evaluate(t, out position, out rotation);
+			return true;
+		}
+
+		/// <summary>
+		/// Advance the playback and select the segment to interpolate. The segment is described by the Window which
+		/// changes only when the playback moves to another pair of snapshots (see WindowVersion), within the segment
+		/// only the interpolation factor changes.
+		/// </summary>
+		/// <param name="localTime">Local clock in milliseconds.</param>
+		/// <param name="t">Interpolation factor within the Window.</param>
+		/// <returns>false if there is nothing to sample.</returns>
+		public bool Prepare(ulong localTime, out float t) {
+			t = 0.0f;
+			if (count == 0) {
+				return false;
+			}
+
+			AdvancePlayback((long)localTime);
+
+			// Playback is still within the current segment. (Most frames, the snapshots don't need to be touched)
+			if (windowValid && windowMode == Interpolation && playbackTime > windowFrom && playbackTime < windowTo) {
+				t = (float)((playbackTime - windowFrom) / (windowTo - windowFrom));
+				return true;
+			}
+			windowValid = false;
+
+			// Keep only one snapshot older than the playback time.
+			while (count > 1 && At(1).time <= playbackTime) {
+				RemoveFirst();
+			}
+
+			Snapshot from = At(0);
+			if (playbackTime <= from.time) {
+				Starved = false;
+				if (!IsCurrentWindow(from.time, from.time, from.time, from.time)) {
+					window.Hold(from.position, from.rotation);
+				}
+				return true;
+			}
+
+			if (count > 1) {
+				Snapshot to = At(1);
+				// Missing neighbours are replaced by the snapshots themselves. (One sided velocity estimate)
+				Snapshot before = (hasPrevious && previous.time < from.time) ? previous : from;
+				Snapshot after = count > 2 ? At(2) : to;
+				if (!IsCurrentWindow(before.time, from.time, to.time, after.time)) {
+					BuildWindow(before, from, to, after);
+				}
+				windowValid = true;
+				t = (float)((playbackTime - from.time) / (to.time - from.time));
+				Starved = false;
+				return true;
+			}
+
+			// Buffer ran dry, continue the last motion for a while.
+			Starved = true;
+			Vector3 position = from.position;
+			if (hasPrevious && from.time > previous.time) {
+				float ahead = Mathf.Min((float)(playbackTime - from.time), MAX_EXTRAPOLATION);
+				position = from.position + (from.position - previous.position) * (ahead / (from.time - previous.time));
+			}
+			hasWindow = false;
+			window.Hold(position, from.rotation);
+			WindowVersion++;
+			return true;
+		}
+
+		/// <summary>
+		/// Segment selected by the last Prepare.
+		/// </summary>
+		public Window CurrentWindow {
+			get { return window; }
+		}
+
+		/// <summary>
+		/// Incremented every time the Window changes.
+		/// </summary>
+		public int WindowVersion {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Check if the window of the given snapshots is already built. Marks it as current if it is not.
+		/// </summary>
+		bool IsCurrentWindow(long before, long from, long to, long after) {
+			if (hasWindow && windowMode == Interpolation && windowBefore == before && windowFrom == from && windowTo == to && windowAfter == after) {
+				return true;
+			}
+			hasWindow = true;
+			windowMode = Interpolation;
+			windowBefore = before;
+			windowFrom = from;
+			windowTo = to;
+			windowAfter = after;
+			WindowVersion++;
+			return false;
+		}
+
+		/// <summary>
+		/// Build interpolation window between from and to.
+		/// </summary>
+		void BuildWindow(Snapshot before, Snapshot from, Snapshot to, Snapshot after) {
+			window.p0 = from.position;
+			window.p1 = to.position;
+			window.q1 = from.rotation;
+			window.q2 = Spline.Align(from.rotation, to.rotation);
+			if (Interpolation == InterpolationMode.Hermite) {
+				float duration = to.time - from.time;
+				window.m0 = (to.position - before.position) * (duration / (to.time - before.time));
+				window.m1 = (after.position - from.position) * (duration / (after.time - from.time));
+				Spline.SquadControlPoints(before.rotation, window.q1, window.q2, after.rotation, out window.a1, out window.a2);
+			}
+			else {
+				// Hermite with both tangents equal to the segment is lerp, squad with the control points equal to the ends is slerp.
+				window.m0 = window.m1 = to.position - from.position;
+				window.a1 = window.q1;
+				window.a2 = window.q2;
+			}
+		}
+
+		/// <summary>
+		/// Remove all snapshots. (e.g. when the player is teleported) Clock and jitter estimates are kept.
+		/// </summary>
+		public void Clear() {
+			first = 0;
+			count = 0;
+			hasPrevious = false;
+			hasPlayback = false;
+			hasWindow = false;
+			windowValid = false;
+		}
+
+		/// <summary>
+		/// Move the playback time to the given local time. The playback speeds up or slows down slightly
+		/// to follow the delay changes without visible jumps.
+		/// </summary>
+		/// <param name="localTime">Local clock in milliseconds.</param>
+		void AdvancePlayback(long localTime) {
+			double target = localTime - clockOffset - Delay;
+			if (!hasPlayback || System.Math.Abs(target - playbackTime) > MAX_DELAY) {
+				playbackTime = target;
+			}
+			else {
+				double elapsed = System.Math.Max(0, localTime - lastSampleTime);
+				double warp = target - (playbackTime + elapsed);
+				double maxWarp = elapsed * MAX_TIME_WARP;
+				playbackTime += elapsed + System.Math.Max(-maxWarp, System.Math.Min(maxWarp, warp));
+			}
+			lastSampleTime = localTime;
+			hasPlayback = true;
+		}
+
+		Snapshot At(int index) {
+			return snapshots[(first + index) % CAPACITY];
+		}
+
+		void RemoveFirst() {
+			previous = snapshots[first];
+			hasPrevious = true;
+			first = (first + 1) % CAPACITY;
+			count--;
+		}
+	}
+}
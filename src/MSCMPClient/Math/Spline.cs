@@ -0,0 +1,172 @@
+using UnityEngine;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Smooth interpolation through a window of samples. (Cubic Hermite for positions, squad for rotations)
+	/// </summary>
+	static class Spline {
+
+		/// <summary>
+		/// Cubic Hermite interpolation between two samples.
+		/// </summary>
+		/// <param name="p0">The first position.</param>
+		/// <param name="m0">Tangent at the first position. (Velocity multiplied by time between the samples)</param>
+		/// <param name="p1">The second position.</param>
+		/// <param name="m1">Tangent at the second position. (Velocity multiplied by time between the samples)</param>
+		/// <param name="t">Interpolation factor.</param>
+		/// <returns>Interpolated position.</returns>
+		public static Vector3 Hermite(Vector3 p0, Vector3 m0, Vector3 p1, Vector3 m1, float t) {
+			float t2 = t * t;
+			float t3 = t2 * t;
+			return p0 * (2.0f * t3 - 3.0f * t2 + 1.0f) + m0 * (t3 - 2.0f * t2 + t) + p1 * (3.0f * t2 - 2.0f * t3) + m1 * (t3 - t2);
+		}
+
+		/// <summary>
+		/// Squad control points of the segment between q1 and q2 with their neighbours q0 and q3.
+		/// </summary>
+		/// <param name="q0">Rotation before q1.</param>
+		/// <param name="q1">The first rotation.</param>
+		/// <param name="q2">The second rotation. (Must be aligned with q1, see Align)</param>
+		/// <param name="q3">Rotation after q2.</param>
+		/// <param name="a1">Control point of q1.</param>
+		/// <param name="a2">Control point of q2.</param>
+		public static void SquadControlPoints(Quaternion q0, Quaternion q1, Quaternion q2, Quaternion q3, out Quaternion a1, out Quaternion a2) {
+			a1 = SquadControlPoint(Align(q1, q0), q1, q2);
+			a2 = SquadControlPoint(q1, q2, Align(q2, q3));
+		}
+
+		/// <summary>
+		/// Squad interpolation between q1 and q2. Angular velocity is continuous across the segments unlike
+		/// with the chained slerps.
+		/// </summary>
+		/// <param name="q1">The first rotation.</param>
+		/// <param name="a1">Control point of q1.</param>
+		/// <param name="a2">Control point of q2.</param>
+		/// <param name="q2">The second rotation. (Must be aligned with q1, see Align)</param>
+		/// <param name="t">Interpolation factor.</param>
+		/// <returns>Interpolated rotation.</returns>
+		public static Quaternion Squad(Quaternion q1, Quaternion a1, Quaternion a2, Quaternion q2, float t) {
+			return SlerpNoInvert(SlerpNoInvert(q1, q2, t), SlerpNoInvert(a1, a2, t), 2.0f * t * (1.0f - t));
+		}
+
+		/// <summary>
+		/// Squad control point of q. (q * exp(-(log(q^-1 * next) + log(q^-1 * previous)) / 4))
+		/// </summary>
+		static Quaternion SquadControlPoint(Quaternion previous, Quaternion q, Quaternion next) {
+			Quaternion inverse = new Quaternion(-q.x, -q.y, -q.z, q.w);
+			Quaternion toNext = Log(Multiply(inverse, next));
+			Quaternion toPrevious = Log(Multiply(inverse, previous));
+			var tangent = new Quaternion(
+				-0.25f * (toNext.x + toPrevious.x),
+				-0.25f * (toNext.y + toPrevious.y),
+				-0.25f * (toNext.z + toPrevious.z),
+				0.0f);
+			return Multiply(q, Exp(tangent));
+		}
+
+		/// <summary>
+		/// Flip q to the same hemisphere as the reference. (q and -q are the same rotation)
+		/// </summary>
+		public static Quaternion Align(Quaternion reference, Quaternion q) {
+			if (Dot(reference, q) < 0.0f) {
+				return new Quaternion(-q.x, -q.y, -q.z, -q.w);
+			}
+			return q;
+		}
+
+		static float Dot(Quaternion a, Quaternion b) {
+			return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+		}
+
+		static Quaternion Multiply(Quaternion a, Quaternion b) {
+			return new Quaternion(
+				a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+		}
+
+		/// <summary>
+		/// Logarithm of the unit quaternion.
+		/// </summary>
+		static Quaternion Log(Quaternion q) {
+			float sin = Mathf.Sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+			if (sin < 0.0001f) {
+				return new Quaternion(q.x, q.y, q.z, 0.0f);
+			}
+			float scale = Mathf.Atan2(sin, q.w) / sin;
+			return new Quaternion(q.x * scale, q.y * scale, q.z * scale, 0.0f);
+		}
+
+		/// <summary>
+		/// Exponent of the pure quaternion.
+		/// </summary>
+		static Quaternion Exp(Quaternion q) {
+			float angle = Mathf.Sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+			if (angle < 0.0001f) {
+				return new Quaternion(q.x, q.y, q.z, 1.0f);
+			}
+			float scale = Mathf.Sin(angle) / angle;
+			return new Quaternion(q.x * scale, q.y * scale, q.z * scale, Mathf.Cos(angle));
+		}
+
+		/// <summary>
+		/// Slerp that keeps the hemispheres of the inputs. (Required by squad)
+		/// </summary>
+		public static Quaternion SlerpNoInvert(Quaternion a, Quaternion b, float t) {
+			float x, y, z, w;
+			SlerpNoInvert(a.x, a.y, a.z, a.w, b.x, b.y, b.z, b.w, t, out x, out y, out z, out w);
+			return new Quaternion(x, y, z, w);
+		}
+
+		/// <summary>
+		/// Slerp that keeps the hemispheres of the inputs on the quaternion components. (Used by the batched evaluation)
+		/// </summary>
+		public static void SlerpNoInvert(float ax, float ay, float az, float aw, float bx, float by, float bz, float bw, float t, out float x, out float y, out float z, out float w) {
+			float angle, inverseSin;
+			PrepareSlerp(ax * bx + ay * by + az * bz + aw * bw, out angle, out inverseSin);
+			SlerpPrepared(ax, ay, az, aw, bx, by, bz, bw, angle, inverseSin, t, out x, out y, out z, out w);
+		}
+
+		/// <summary>
+		/// Compute the part of the slerp that does not depend on the interpolation factor.
+		/// </summary>
+		/// <param name="dot">Dot product of the quaternions.</param>
+		/// <param name="angle">Angle between the quaternions. (Zero if they are close enough to use the normalized lerp)</param>
+		/// <param name="inverseSin">Inverse sine of the angle.</param>
+		public static void PrepareSlerp(float dot, out float angle, out float inverseSin) {
+			if (dot > 0.9995f || dot < -0.9995f) {
+				angle = 0.0f;
+				inverseSin = 1.0f;
+			}
+			else {
+				angle = Mathf.Acos(dot);
+				inverseSin = 1.0f / Mathf.Sin(angle);
+			}
+		}
+
+		/// <summary>
+		/// Slerp with the angle computed by PrepareSlerp.
+		/// </summary>
+		public static void SlerpPrepared(float ax, float ay, float az, float aw, float bx, float by, float bz, float bw, float angle, float inverseSin, float t, out float x, out float y, out float z, out float w) {
+			float wa, wb;
+			if (angle == 0.0f) {
+				wa = 1.0f - t;
+				wb = t;
+			}
+			else {
+				wa = Mathf.Sin((1.0f - t) * angle) * inverseSin;
+				wb = Mathf.Sin(t * angle) * inverseSin;
+			}
+			x = wa * ax + wb * bx;
+			y = wa * ay + wb * by;
+			z = wa * az + wb * bz;
+			w = wa * aw + wb * bw;
+			float inverseLength = 1.0f / Mathf.Sqrt(x * x + y * y + z * z + w * w);
+			x *= inverseLength;
+			y *= inverseLength;
+			z *= inverseLength;
+			w *= inverseLength;
+		}
+	}
+}
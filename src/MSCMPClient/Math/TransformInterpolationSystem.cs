@@ -0,0 +1,218 @@
+using System.Collections.Generic;
+using UnityEngine;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Evaluates all remote transform interpolators in a single pass.
+	/// </summary>
+	/// <remarks>
+	/// Interpolation windows of the registered interpolators are kept in struct of arrays buffers indexed by the
+	/// interpolator slot. The window of an interpolator is copied into the buffers only when its snapshot buffer
+	/// moves to another segment, every frame only the interpolation factor is gathered. The positions and the
+	/// rotations are then evaluated in two tight loops over the arrays and the results are scattered back to
+	/// the interpolators before the owners write them into the transforms.
+	/// </remarks>
+	class TransformInterpolationSystem {
+
+		const int INITIAL_CAPACITY = 16;
+
+		/// <summary>
+		/// Registered interpolators. (Index is the slot)
+		/// </summary>
+		List<TransformInterpolator> interpolators = new List<TransformInterpolator>();
+
+		/// <summary>
+		/// Snapshot buffers of the interpolators. (Walked every frame without touching the interpolators)
+		/// </summary>
+		SnapshotBuffer[] buffers;
+
+		/// <summary>
+		/// Window version copied into the slot. (See SnapshotBuffer.WindowVersion)
+		/// </summary>
+		int[] windowVersions;
+
+		/// <summary>
+		/// Does the slot have a sample this frame?
+		/// </summary>
+		bool[] valid;
+
+		float[] t;
+
+		// Hermite segments.
+		float[] p0x, p0y, p0z, m0x, m0y, m0z;
+		float[] p1x, p1y, p1z, m1x, m1y, m1z;
+
+		// Squad segments and the angles of their slerps. (See Spline.PrepareSlerp)
+		float[] q1x, q1y, q1z, q1w, a1x, a1y, a1z, a1w;
+		float[] a2x, a2y, a2z, a2w, q2x, q2y, q2z, q2w;
+		float[] qAngle, qInverseSin, aAngle, aInverseSin;
+
+		// Results.
+		float[] px, py, pz;
+		float[] rx, ry, rz, rw;
+
+		public TransformInterpolationSystem() {
+			Allocate(INITIAL_CAPACITY);
+		}
+
+		/// <summary>
+		/// Amount of registered interpolators.
+		/// </summary>
+		public int Count {
+			get { return interpolators.Count; }
+		}
+
+		/// <summary>
+		/// Register interpolator to be evaluated by the system.
+		/// </summary>
+		/// <param name="interpolator">The interpolator.</param>
+		public void Add(TransformInterpolator interpolator) {
+			Client.Assert(interpolator.Slot == TransformInterpolator.NO_SLOT, "Interpolator is already registered.");
+			int slot = interpolators.Count;
+			if (slot == t.Length) {
+				Allocate(t.Length * 2);
+			}
+			interpolators.Add(interpolator);
+			buffers[slot] = interpolator.Buffer;
+			interpolator.Slot = slot;
+			windowVersions[slot] = interpolator.Buffer.WindowVersion - 1;
+		}
+
+		/// <summary>
+		/// Unregister interpolator. The last interpolator is moved into its slot.
+		/// </summary>
+		/// <param name="interpolator">The interpolator.</param>
+		public void Remove(TransformInterpolator interpolator) {
+			int slot = interpolator.Slot;
+			if (slot == TransformInterpolator.NO_SLOT) {
+				return;
+			}
+			int last = interpolators.Count - 1;
+			if (slot != last) {
+				TransformInterpolator moved = interpolators[last];
+				interpolators[slot] = moved;
+				buffers[slot] = moved.Buffer;
+				moved.Slot = slot;
+				// Force the copy of the window into the new slot.
+				windowVersions[slot] = moved.Buffer.WindowVersion - 1;
+			}
+			interpolators.RemoveAt(last);
+			buffers[last] = null;
+			interpolator.Slot = TransformInterpolator.NO_SLOT;
+		}
+
+		/// <summary>
+		/// Evaluate all registered interpolators.
+		/// </summary>
+		/// <param name="localTime">Local network clock in milliseconds.</param>
+		public void Evaluate(ulong localTime) {
+			int count = interpolators.Count;
+			Gather(localTime, count);
+			EvaluatePositions(count);
+			EvaluateRotations(count);
+			Scatter(count);
+		}
+
+		/// <summary>
+		/// Advance the snapshot buffers and copy the changed windows into the arrays.
+		/// </summary>
+		void Gather(ulong localTime, int count) {
+			for (int i = 0; i < count; ++i) {
+				SnapshotBuffer buffer = buffers[i];
+				valid[i] = buffer.Prepare(localTime, out t[i]);
+				if (!valid[i] || windowVersions[i] == buffer.WindowVersion) {
+					continue;
+				}
+				windowVersions[i] = buffer.WindowVersion;
+
+				SnapshotBuffer.Window window = buffer.CurrentWindow;
+				p0x[i] = window.p0.x; p0y[i] = window.p0.y; p0z[i] = window.p0.z;
+				m0x[i] = window.m0.x; m0y[i] = window.m0.y; m0z[i] = window.m0.z;
+				p1x[i] = window.p1.x; p1y[i] = window.p1.y; p1z[i] = window.p1.z;
+				m1x[i] = window.m1.x; m1y[i] = window.m1.y; m1z[i] = window.m1.z;
+				q1x[i] = window.q1.x; q1y[i] = window.q1.y; q1z[i] = window.q1.z; q1w[i] = window.q1.w;
+				a1x[i] = window.a1.x; a1y[i] = window.a1.y; a1z[i] = window.a1.z; a1w[i] = window.a1.w;
+				a2x[i] = window.a2.x; a2y[i] = window.a2.y; a2z[i] = window.a2.z; a2w[i] = window.a2.w;
+				q2x[i] = window.q2.x; q2y[i] = window.q2.y; q2z[i] = window.q2.z; q2w[i] = window.q2.w;
+				Spline.PrepareSlerp(window.q1.x * window.q2.x + window.q1.y * window.q2.y + window.q1.z * window.q2.z + window.q1.w * window.q2.w, out qAngle[i], out qInverseSin[i]);
+				Spline.PrepareSlerp(window.a1.x * window.a2.x + window.a1.y * window.a2.y + window.a1.z * window.a2.z + window.a1.w * window.a2.w, out aAngle[i], out aInverseSin[i]);
+			}
+		}
+
+		/// <summary>
+		/// Cubic Hermite interpolation of all slots. (See Spline.Hermite)
+		/// </summary>
+		void EvaluatePositions(int count) {
+			for (int i = 0; i < count; ++i) {
+				float t1 = t[i];
+				float t2 = t1 * t1;
+				float t3 = t2 * t1;
+				float h00 = 2.0f * t3 - 3.0f * t2 + 1.0f;
+				float h10 = t3 - 2.0f * t2 + t1;
+				float h01 = 3.0f * t2 - 2.0f * t3;
+				float h11 = t3 - t2;
+				px[i] = h00 * p0x[i] + h10 * m0x[i] + h01 * p1x[i] + h11 * m1x[i];
+				py[i] = h00 * p0y[i] + h10 * m0y[i] + h01 * p1y[i] + h11 * m1y[i];
+				pz[i] = h00 * p0z[i] + h10 * m0z[i] + h01 * p1z[i] + h11 * m1z[i];
+			}
+		}
+
+		/// <summary>
+		/// Squad interpolation of all slots. (See Spline.Squad) Angles of the outer slerps are constant within the
+		/// segment so only the inner one computes its angle.
+		/// </summary>
+		void EvaluateRotations(int count) {
+			for (int i = 0; i < count; ++i) {
+				float t1 = t[i];
+				float sx, sy, sz, sw, cx, cy, cz, cw;
+				Spline.SlerpPrepared(q1x[i], q1y[i], q1z[i], q1w[i], q2x[i], q2y[i], q2z[i], q2w[i], qAngle[i], qInverseSin[i], t1, out sx, out sy, out sz, out sw);
+				Spline.SlerpPrepared(a1x[i], a1y[i], a1z[i], a1w[i], a2x[i], a2y[i], a2z[i], a2w[i], aAngle[i], aInverseSin[i], t1, out cx, out cy, out cz, out cw);
+				Spline.SlerpNoInvert(sx, sy, sz, sw, cx, cy, cz, cw, 2.0f * t1 * (1.0f - t1), out rx[i], out ry[i], out rz[i], out rw[i]);
+			}
+		}
+
+		/// <summary>
+		/// Write the results back to the interpolators.
+		/// </summary>
+		void Scatter(int count) {
+			for (int i = 0; i < count; ++i) {
+				if (valid[i]) {
+					interpolators[i].SetEvaluated(new Vector3(px[i], py[i], pz[i]), new Quaternion(rx[i], ry[i], rz[i], rw[i]));
+				}
+				else {
+					interpolators[i].SetNotEvaluated();
+				}
+			}
+		}
+
+		/// <summary>
+		/// Resize the arrays keeping their content.
+		/// </summary>
+		/// <param name="capacity">New capacity.</param>
+		void Allocate(int capacity) {
+			Resize(ref buffers, capacity);
+			Resize(ref windowVersions, capacity);
+			Resize(ref valid, capacity);
+			Resize(ref t, capacity);
+			Resize(ref p0x, capacity); Resize(ref p0y, capacity); Resize(ref p0z, capacity);
+			Resize(ref m0x, capacity); Resize(ref m0y, capacity); Resize(ref m0z, capacity);
+			Resize(ref p1x, capacity); Resize(ref p1y, capacity); Resize(ref p1z, capacity);
+			Resize(ref m1x, capacity); Resize(ref m1y, capacity); Resize(ref m1z, capacity);
+			Resize(ref q1x, capacity); Resize(ref q1y, capacity); Resize(ref q1z, capacity); Resize(ref q1w, capacity);
+			Resize(ref a1x, capacity); Resize(ref a1y, capacity); Resize(ref a1z, capacity); Resize(ref a1w, capacity);
+			Resize(ref a2x, capacity); Resize(ref a2y, capacity); Resize(ref a2z, capacity); Resize(ref a2w, capacity);
+			Resize(ref q2x, capacity); Resize(ref q2y, capacity); Resize(ref q2z, capacity); Resize(ref q2w, capacity);
+			Resize(ref qAngle, capacity); Resize(ref qInverseSin, capacity); Resize(ref aAngle, capacity); Resize(ref aInverseSin, capacity);
+			Resize(ref px, capacity); Resize(ref py, capacity); Resize(ref pz, capacity);
+			Resize(ref rx, capacity); Resize(ref ry, capacity); Resize(ref rz, capacity); Resize(ref rw, capacity);
+		}
+
+		static void Resize<T>(ref T[] array, int capacity) {
+			var resized = new T[capacity];
+			if (array != null) {
+				System.Array.Copy(array, resized, array.Length);
+			}
+			array = resized;
+		}
+	}
+}
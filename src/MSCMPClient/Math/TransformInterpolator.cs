@@ -1,40 +1,112 @@
 ﻿using UnityEngine;
 
 namespace MSCMP.Math {
+	/// <summary>
+	/// Interpolates transform of the remote object from the received snapshots. (See SnapshotBuffer)
+	/// </summary>
+	/// <remarks>
+	/// Registered interpolators are evaluated by the TransformInterpolationSystem, unregistered ones by Evaluate.
+	/// </remarks>
 	class TransformInterpolator {
-		QuaternionInterpolator rotation = new QuaternionInterpolator();
-		Vector3Interpolator position = new Vector3Interpolator();
+		/// <summary>
+		/// Slot of the interpolator that is not registered in the TransformInterpolationSystem.
+		/// </summary>
+		public const int NO_SLOT = -1;
+
+		SnapshotBuffer buffer = new SnapshotBuffer();
+
+		Vector3 position = Vector3.zero;
+		Quaternion rotation = Quaternion.identity;
+		Vector3 previousPosition = Vector3.zero;
+
+		/// <summary>
+		/// Slot in the TransformInterpolationSystem.
+		/// </summary>
+		public int Slot {
+			get; set;
+		}
+
+		/// <summary>
+		/// Was the transform updated by the last evaluation?
+		/// </summary>
+		public bool Updated {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Position before the last evaluation.
+		/// </summary>
+		public Vector3 PreviousPosition {
+			get {
+				return previousPosition;
+			}
+		}
+
+		public TransformInterpolator() {
+			Slot = NO_SLOT;
+		}
 
 		public Vector3 CurrentPosition {
 			get {
-				return position.Current;
+				return position;
 			}
 		}
 
 		public Quaternion CurrentRotation {
 			get {
-				return rotation.Current;
+				return rotation;
+			}
+		}
+
+		public SnapshotBuffer Buffer {
+			get {
+				return buffer;
 			}
 		}
 
 		public void Teleport(Vector3 pos, Quaternion rot) {
-			position.Teleport(pos);
-			rotation.Teleport(rot);
+			buffer.Clear();
+			position = previousPosition = pos;
+			rotation = rot;
+			Updated = false;
+		}
+
+		public void AddSnapshot(ulong senderTime, ulong receiveTime, Vector3 pos, Quaternion rot) {
+			buffer.Add(senderTime, receiveTime, pos, rot);
 		}
 
-		public void SetTarget(Vector3 pos, Quaternion rot) {
-			position.SetTarget(pos);
-			rotation.SetTarget(rot);
+		/// <summary>
+		/// Update current transform.
+		/// </summary>
+		/// <param name="localTime">Local network clock in milliseconds.</param>
+		/// <returns>false if no snapshot was received since the last teleport.</returns>
+		public bool Evaluate(ulong localTime) {
+			Vector3 pos;
+			Quaternion rot;
+			if (!buffer.Sample(localTime, out pos, out rot)) {
+				SetNotEvaluated();
+				return false;
+			}
+			SetEvaluated(pos, rot);
+			return true;
 		}
 
-		public void Evaluate(ref Vector3 pos, ref Quaternion rot, float alpha) {
-			pos = position.Evaluate(alpha);
-			rot = rotation.Evaluate(alpha);
+		/// <summary>
+		/// Store the evaluated transform. (Called by the TransformInterpolationSystem)
+		/// </summary>
+		public void SetEvaluated(Vector3 pos, Quaternion rot) {
+			previousPosition = position;
+			position = pos;
+			rotation = rot;
+			Updated = true;
 		}
 
-		public void Evaluate(float alpha) {
-			position.Evaluate(alpha);
-			rotation.Evaluate(alpha);
+		/// <summary>
+		/// Mark that there was nothing to evaluate. (Called by the TransformInterpolationSystem)
+		/// </summary>
+		public void SetNotEvaluated() {
+			previousPosition = position;
+			Updated = false;
 		}
 	}
 }
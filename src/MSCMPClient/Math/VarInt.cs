@@ -0,0 +1,91 @@
+using System.IO;
+
+namespace MSCMP.Math {
+	/// <summary>
+	/// Variable length encoding of the integers sent over the network.
+	/// </summary>
+	/// <remarks>
+	/// Unsigned integers are written 7 bits per byte starting with the lowest ones, the high bit of the byte is
+	/// set if more bytes follow. Values below 128 take a single byte, 32 bit value takes at most 5 bytes. Signed
+	/// integers are zigzag encoded first so the small negative values are short too.
+	/// </remarks>
+	static class VarInt {
+
+		/// <summary>
+		/// Maximum size of the encoded 32 bit value in bytes.
+		/// </summary>
+		public const int MAX_SIZE = 5;
+
+		/// <summary>
+		/// Write unsigned integer.
+		/// </summary>
+		/// <param name="writer">The writer.</param>
+		/// <param name="value">The value.</param>
+		public static void WriteUInt(BinaryWriter writer, uint value) {
+			while (value >= 0x80) {
+				writer.Write((byte)(value | 0x80));
+				value >>= 7;
+			}
+			writer.Write((byte)value);
+		}
+
+		/// <summary>
+		/// Read unsigned integer written by WriteUInt.
+		/// </summary>
+		/// <param name="reader">The reader.</param>
+		/// <returns>The value.</returns>
+		/// <exception cref="EndOfStreamException">The stream ended or the value is malformed.</exception>
+		public static uint ReadUInt(BinaryReader reader) {
+			uint value = 0;
+			for (int shift = 0; shift < MAX_SIZE * 7; shift += 7) {
+				byte b = reader.ReadByte();
+				value |= (uint)(b & 0x7F) << shift;
+				if ((b & 0x80) == 0) {
+					return value;
+				}
+			}
+			throw new EndOfStreamException("Malformed varint.");
+		}
+
+		/// <summary>
+		/// Read unsigned integer written by WriteUInt from the buffer.
+		/// </summary>
+		/// <param name="data">The buffer.</param>
+		/// <param name="offset">Offset of the value, advanced past it.</param>
+		/// <param name="end">End of the readable data in the buffer.</param>
+		/// <param name="value">The value.</param>
+		/// <returns>false if the data ended or the value is malformed.</returns>
+		public static bool TryReadUInt(byte[] data, ref int offset, int end, out uint value) {
+			value = 0;
+			for (int shift = 0; shift < MAX_SIZE * 7; shift += 7) {
+				if (offset >= end) {
+					return false;
+				}
+				byte b = data[offset++];
+				value |= (uint)(b & 0x7F) << shift;
+				if ((b & 0x80) == 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Map signed integer to unsigned one so the values close to zero stay small. (0, -1, 1, -2 ... to 0, 1, 2, 3 ...)
+		/// </summary>
+		/// <param name="value">The value.</param>
+		/// <returns>The zigzag encoded value.</returns>
+		public static uint ZigZagEncode(int value) {
+			return (uint)((value << 1) ^ (value >> 31));
+		}
+
+		/// <summary>
+		/// Restore signed integer encoded by ZigZagEncode.
+		/// </summary>
+		/// <param name="value">The zigzag encoded value.</param>
+		/// <returns>The value.</returns>
+		public static int ZigZagDecode(uint value) {
+			return (int)(value >> 1) ^ -(int)(value & 1);
+		}
+	}
+}
@@ -0,0 +1,629 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Periodically exports network and runtime metrics so long running sessions can be analyzed without watching the statistics window.
+	/// </summary>
+	/// <remarks>
+	/// Metrics are collected on the main thread. Writing to the disk and serving the localhost endpoint is done on background threads.
+	/// </remarks>
+	class MetricsExporter {
+
+		/// <summary>
+		/// The output format of the metrics file.
+		/// </summary>
+		public enum Format {
+			Prometheus,
+			Json
+		}
+
+		/// <summary>
+		/// The default interval between metrics collections in seconds.
+		/// </summary>
+		public const float DEFAULT_INTERVAL = 10.0f;
+
+		/// <summary>
+		/// The size after which metrics file is rotated.
+		/// </summary>
+		const long MAX_FILE_SIZE = 8 * 1024 * 1024;
+
+		/// <summary>
+		/// How many rotated files are kept next to the current one.
+		/// </summary>
+		const int MAX_ROTATED_FILES = 5;
+
+		/// <summary>
+		/// Network manager owning this exporter.
+		/// </summary>
+		NetManager netManager = null;
+
+		/// <summary>
+		/// Is exporting to file enabled?
+		/// </summary>
+		bool exporting = false;
+
+		/// <summary>
+		/// The current output format.
+		/// </summary>
+		Format format = Format.Prometheus;
+
+		/// <summary>
+		/// Interval between metrics collections in seconds.
+		/// </summary>
+		float interval = DEFAULT_INTERVAL;
+
+		/// <summary>
+		/// The timestamp of the last collection. (see <see cref="Stopwatch.GetTimestamp"/>)
+		/// </summary>
+		long lastCollectTimestamp = 0;
+
+		/// <summary>
+		/// Path of the current metrics file.
+		/// </summary>
+		string filePath = null;
+
+		/// <summary>
+		/// Single metric sample.
+		/// </summary>
+		struct Sample {
+			public string name;
+			public string labelName;
+			public string labelValue;
+			public double value;
+		}
+
+		/// <summary>
+		/// Samples collected in the current collection. (Reused between collections)
+		/// </summary>
+		List<Sample> samples = new List<Sample>();
+
+		/// <summary>
+		/// Type of each metric. (true if counter, false if gauge)
+		/// </summary>
+		Dictionary<string, bool> metricTypes = new Dictionary<string, bool>();
+
+		/// <summary>
+		/// Reusable builder used to format collections.
+		/// </summary>
+		StringBuilder builder = new StringBuilder();
+
+		/// <summary>
+		/// Formatted collections waiting to be written by the writer thread.
+		/// </summary>
+		Queue<string> pendingWrites = new Queue<string>();
+
+		/// <summary>
+		/// Event signaled when there are pending writes.
+		/// </summary>
+		AutoResetEvent writeEvent = new AutoResetEvent(false);
+
+		/// <summary>
+		/// The file writer thread.
+		/// </summary>
+		Thread writerThread = null;
+
+		/// <summary>
+		/// Should the writer thread end once pending writes are written?
+		/// </summary>
+		bool stopping = false;
+
+		/// <summary>
+		/// Listener of the localhost endpoint.
+		/// </summary>
+		TcpListener listener = null;
+
+		/// <summary>
+		/// The localhost endpoint thread.
+		/// </summary>
+		Thread listenerThread = null;
+
+		/// <summary>
+		/// The latest collection in Prometheus text format served by the localhost endpoint.
+		/// </summary>
+		string latestSnapshot = "";
+
+		/// <summary>
+		/// The last error reported by background threads. (Logger is not thread safe so it is logged from the main thread)
+		/// </summary>
+		string threadError = null;
+
+		/// <summary>
+		/// Lock guarding <see cref="pendingWrites"/>, <see cref="filePath"/>, <see cref="latestSnapshot"/>, <see cref="threadError"/> and <see cref="stopping"/>.
+		/// </summary>
+		object syncLock = new object();
+
+		/// <summary>
+		/// Is exporting to file enabled?
+		/// </summary>
+		public bool IsExporting {
+			get { return exporting; }
+		}
+
+		/// <summary>
+		/// Is the localhost endpoint running?
+		/// </summary>
+		public bool IsServing {
+			get { return listener != null; }
+		}
+
+		public MetricsExporter(NetManager netManager) {
+			this.netManager = netManager;
+		}
+
+		/// <summary>
+		/// Start exporting if requested by the environment. Used by unattended soak runs.
+		/// </summary>
+		/// <remarks>
+		/// MSCMP_METRICS=prometheus|json[:interval in seconds] enables file export, MSCMP_METRICS_PORT=port enables the localhost endpoint.
+		/// </remarks>
+		public void StartFromEnvironment() {
+			string metrics = Environment.GetEnvironmentVariable("MSCMP_METRICS");
+			if (!string.IsNullOrEmpty(metrics)) {
+				string[] parts = metrics.Split(':');
+				Format requestedFormat;
+				float requestedInterval = DEFAULT_INTERVAL;
+				if (!ParseFormat(parts[0], out requestedFormat) || (parts.Length > 1 && !float.TryParse(parts[1], NumberStyles.Float, CultureInfo.InvariantCulture, out requestedInterval))) {
+					Logger.Error($"Invalid MSCMP_METRICS value: {metrics}");
+				}
+				else {
+					Start(requestedFormat, requestedInterval);
+				}
+			}
+
+			string port = Environment.GetEnvironmentVariable("MSCMP_METRICS_PORT");
+			if (!string.IsNullOrEmpty(port)) {
+				int requestedPort = 0;
+				if (!int.TryParse(port, out requestedPort)) {
+					Logger.Error($"Invalid MSCMP_METRICS_PORT value: {port}");
+				}
+				else {
+					Serve(requestedPort);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Parse format name.
+		/// </summary>
+		/// <param name="name">The name of the format.</param>
+		/// <param name="result">The parsed format.</param>
+		/// <returns>true if format name is valid, false otherwise</returns>
+		public static bool ParseFormat(string name, out Format result) {
+			switch (name.ToLower()) {
+				case "prometheus":
+				case "prom":
+					result = Format.Prometheus;
+					return true;
+				case "json":
+					result = Format.Json;
+					return true;
+			}
+			result = Format.Prometheus;
+			return false;
+		}
+
+		/// <summary>
+		/// Start exporting metrics to the rotating file in app data folder.
+		/// </summary>
+		/// <param name="newFormat">The file format.</param>
+		/// <param name="newInterval">Interval between collections in seconds.</param>
+		/// <returns>true if export was started, false otherwise</returns>
+		public bool Start(Format newFormat, float newInterval) {
+			string appData = Client.GetAppDataPath();
+			if (appData == null) {
+				Logger.Error("Cannot export metrics - app data folder is not available.");
+				return false;
+			}
+
+			lock (syncLock) {
+				filePath = appData + (newFormat == Format.Json ? "/metrics.jsonl" : "/metrics.prom");
+			}
+			format = newFormat;
+			interval = System.Math.Max(newInterval, 0.1f);
+			exporting = true;
+			lastCollectTimestamp = 0;
+
+			if (writerThread == null) {
+				lock (syncLock) {
+					stopping = false;
+				}
+				writerThread = new Thread(WriterThread);
+				writerThread.IsBackground = true;
+				writerThread.Name = "MSCMP metrics writer";
+				writerThread.Start();
+			}
+
+			Logger.Log($"Exporting metrics to {filePath} every {interval} seconds.");
+			return true;
+		}
+
+		/// <summary>
+		/// Stop exporting metrics to file.
+		/// </summary>
+		public void Stop() {
+			exporting = false;
+		}
+
+		/// <summary>
+		/// Stop exporting and serving and end the background threads. Waits until pending writes are written.
+		/// </summary>
+		public void Dispose() {
+			Stop();
+			StopServing();
+
+			if (writerThread == null) {
+				return;
+			}
+			lock (syncLock) {
+				stopping = true;
+			}
+			writeEvent.Set();
+			writerThread.Join();
+			writerThread = null;
+		}
+
+		/// <summary>
+		/// Start serving the latest metrics in Prometheus text format on localhost.
+		/// </summary>
+		/// <param name="port">The port to listen on.</param>
+		/// <returns>true if endpoint was started, false otherwise</returns>
+		public bool Serve(int port) {
+			StopServing();
+
+			try {
+				listener = new TcpListener(IPAddress.Loopback, port);
+				listener.Start();
+			}
+			catch (Exception e) {
+				Logger.Error($"Failed to start metrics endpoint on port {port}: {e.Message}");
+				listener = null;
+				return false;
+			}
+
+			listenerThread = new Thread(ListenerThread);
+			listenerThread.IsBackground = true;
+			listenerThread.Name = "MSCMP metrics endpoint";
+			listenerThread.Start(listener);
+
+			// Make sure there is something to serve before first collection.
+			if (!exporting) {
+				lastCollectTimestamp = 0;
+			}
+
+			Logger.Log($"Serving metrics on http://127.0.0.1:{port}/metrics");
+			return true;
+		}
+
+		/// <summary>
+		/// Stop serving metrics on localhost.
+		/// </summary>
+		public void StopServing() {
+			if (listener == null) {
+				return;
+			}
+
+			// Stopping the listener makes pending accept throw which ends the endpoint thread.
+			listener.Stop();
+			listener = null;
+			listenerThread = null;
+		}
+
+		/// <summary>
+		/// Update exporter. Collects metrics when the interval has elapsed.
+		/// </summary>
+		public void Update() {
+			if (!exporting && listener == null) {
+				return;
+			}
+
+			string error = null;
+			lock (syncLock) {
+				error = threadError;
+				threadError = null;
+			}
+			if (error != null) {
+				Logger.Error(error);
+			}
+
+			long timestamp = Stopwatch.GetTimestamp();
+			if (lastCollectTimestamp != 0 && (timestamp - lastCollectTimestamp) < (long)(interval * Stopwatch.Frequency)) {
+				return;
+			}
+			lastCollectTimestamp = timestamp;
+
+			Collect();
+
+			long unixTimeMs = (long)(DateTime.UtcNow - new DateTime(1970, 1, 1, 0, 0, 0, DateTimeKind.Utc)).TotalMilliseconds;
+			string snapshot = FormatPrometheus(-1);
+			string record = null;
+			if (exporting) {
+				record = format == Format.Json ? FormatJson(unixTimeMs) : FormatPrometheus(unixTimeMs);
+			}
+
+			lock (syncLock) {
+				latestSnapshot = snapshot;
+				if (record != null) {
+					pendingWrites.Enqueue(record);
+				}
+			}
+
+			if (record != null) {
+				writeEvent.Set();
+			}
+		}
+
+		/// <summary>
+		/// Add sample to the current collection.
+		/// </summary>
+		/// <param name="name">The name of the metric.</param>
+		/// <param name="value">The value of the sample.</param>
+		/// <param name="counter">Is the metric monotonically increasing counter?</param>
+		/// <param name="labelName">Optional name of the label.</param>
+		/// <param name="labelValue">Optional value of the label.</param>
+		void AddSample(string name, double value, bool counter, string labelName = null, string labelValue = null) {
+			metricTypes[name] = counter;
+
+			Sample sample;
+			sample.name = name;
+			sample.labelName = labelName;
+			sample.labelValue = labelValue;
+			sample.value = value;
+			samples.Add(sample);
+		}
+
+		/// <summary>
+		/// Collect all metrics.
+		/// </summary>
+		void Collect() {
+			samples.Clear();
+
+			NetStatistics statistics = netManager.Statistics;
+
+			AddSample("mscmp_online", netManager.IsOnline ? 1 : 0, false);
+			AddSample("mscmp_uptime_seconds", netManager.GetNetworkClock() / 1000.0, false);
+
+			// Traffic.
+
+			AddSample("mscmp_bytes_sent_total", statistics.BytesSentTotal, true);
+			AddSample("mscmp_bytes_received_total", statistics.BytesReceivedTotal, true);
+			AddSample("mscmp_packets_sent_total", statistics.PacketsSentTotal, true);
+			AddSample("mscmp_packets_received_total", statistics.PacketsReceivedTotal, true);
+
+			AddPerMessageSamples("mscmp_message_packets_sent_total", statistics.GetPacketsSent);
+			AddPerMessageSamples("mscmp_message_bytes_sent_total", statistics.GetBytesSent);
+			AddPerMessageSamples("mscmp_message_packets_received_total", statistics.GetPacketsReceived);
+			AddPerMessageSamples("mscmp_message_bytes_received_total", statistics.GetBytesReceived);
+
+			// Connection.
+
+			AddSample("mscmp_ping_milliseconds", netManager.Ping, false);
+			AddSample("mscmp_jitter_milliseconds", netManager.Jitter, false);
+
+			Steamworks.P2PSessionState_t sessionState;
+			if (netManager.GetP2PSessionState(out sessionState)) {
+				AddSample("mscmp_steam_send_queue_bytes", sessionState.m_nBytesQueuedForSend, false);
+				AddSample("mscmp_steam_send_queue_packets", sessionState.m_nPacketsQueuedForSend, false);
+			}
+
+			// Runtime.
+
+			AddSample("mscmp_gc_heap_bytes", GC.GetTotalMemory(false), false);
+			AddSample("mscmp_gc_collections_total", GC.CollectionCount(0), true);
+
+			AddPercentiles("mscmp_frame_time_microseconds", statistics.FrameTimeHistory);
+			AddPercentiles("mscmp_net_update_time_microseconds", statistics.UpdateTimeHistory);
+
+			// World.
+
+			if (Game.ObjectSyncManager.Instance != null) {
+				AddSample("mscmp_synced_objects", Game.ObjectSyncManager.Instance.ObjectIDs.Count, false);
+				AddSample("mscmp_locally_synced_objects", Game.ObjectSyncManager.Instance.SyncSystem.Count, false);
+
+				Game.PeriodicSyncScheduler periodicSync = Game.ObjectSyncManager.Instance.PeriodicSync;
+				AddSample("mscmp_periodic_sync_scheduled_total", periodicSync.Scheduled, true);
+				AddSample("mscmp_periodic_sync_sent_total", periodicSync.Sent, true);
+				AddSample("mscmp_periodic_sync_skipped_total", periodicSync.Skipped, true);
+				AddSample("mscmp_periodic_sync_deferred_total", periodicSync.Deferred, true);
+			}
+		}
+
+		/// <summary>
+		/// Add per message type counter samples. Message types that were never used are skipped.
+		/// </summary>
+		/// <param name="name">The name of the metric.</param>
+		/// <param name="getter">The getter of the counter value for the message id.</param>
+		void AddPerMessageSamples(string name, Func<int, long> getter) {
+			NetStatistics statistics = netManager.Statistics;
+			for (int i = 0; i < NetStatistics.MAX_MESSAGE_TYPES; ++i) {
+				long value = getter(i);
+				if (value != 0) {
+					AddSample(name, value, true, "message", statistics.GetMessageName(i));
+				}
+			}
+		}
+
+		/// <summary>
+		/// Add percentiles and maximum of the history as samples.
+		/// </summary>
+		/// <param name="name">The name of the metric.</param>
+		/// <param name="history">The history to add.</param>
+		void AddPercentiles(string name, Utilities.SlidingWindow history) {
+			AddSample(name, history.Percentile(50), false, "quantile", "0.5");
+			AddSample(name, history.Percentile(95), false, "quantile", "0.95");
+			AddSample(name, history.Percentile(99), false, "quantile", "0.99");
+			AddSample(name, history.Max, false, "quantile", "1");
+		}
+
+		/// <summary>
+		/// Format current collection in Prometheus text format.
+		/// </summary>
+		/// <param name="unixTimeMs">Timestamp appended to each sample or -1 if samples should not have timestamps.</param>
+		/// <returns>The formatted collection.</returns>
+		string FormatPrometheus(long unixTimeMs) {
+			builder.Length = 0;
+
+			string lastName = null;
+			foreach (Sample sample in samples) {
+				if (sample.name != lastName) {
+					builder.Append("# TYPE ").Append(sample.name).Append(metricTypes[sample.name] ? " counter\n" : " gauge\n");
+					lastName = sample.name;
+				}
+
+				builder.Append(sample.name);
+				if (sample.labelName != null) {
+					builder.Append('{').Append(sample.labelName).Append("=\"").Append(sample.labelValue).Append("\"}");
+				}
+				builder.Append(' ').Append(sample.value.ToString("R", CultureInfo.InvariantCulture));
+				if (unixTimeMs >= 0) {
+					builder.Append(' ').Append(unixTimeMs);
+				}
+				builder.Append('\n');
+			}
+			return builder.ToString();
+		}
+
+		/// <summary>
+		/// Format current collection as single JSON line.
+		/// </summary>
+		/// <param name="unixTimeMs">The timestamp of the collection.</param>
+		/// <returns>The formatted collection.</returns>
+		string FormatJson(long unixTimeMs) {
+			builder.Length = 0;
+
+			builder.Append("{\"timestamp\":").Append(unixTimeMs).Append(",\"metrics\":[");
+			for (int i = 0; i < samples.Count; ++i) {
+				Sample sample = samples[i];
+				if (i > 0) {
+					builder.Append(',');
+				}
+
+				builder.Append("{\"name\":\"").Append(sample.name).Append('"');
+				if (sample.labelName != null) {
+					builder.Append(",\"").Append(sample.labelName).Append("\":\"").Append(sample.labelValue).Append('"');
+				}
+				builder.Append(",\"value\":").Append(sample.value.ToString("R", CultureInfo.InvariantCulture)).Append('}');
+			}
+			builder.Append("]}\n");
+			return builder.ToString();
+		}
+
+		/// <summary>
+		/// Rotate metrics file if it grew too big.
+		/// </summary>
+		/// <param name="path">The path of the current metrics file.</param>
+		static void RotateIfNeeded(string path) {
+			var info = new FileInfo(path);
+			if (!info.Exists || info.Length < MAX_FILE_SIZE) {
+				return;
+			}
+
+			string extension = Path.GetExtension(path);
+			string basePath = path.Substring(0, path.Length - extension.Length);
+
+			string oldest = $"{basePath}.{MAX_ROTATED_FILES}{extension}";
+			if (File.Exists(oldest)) {
+				File.Delete(oldest);
+			}
+
+			for (int i = MAX_ROTATED_FILES - 1; i >= 1; --i) {
+				string source = $"{basePath}.{i}{extension}";
+				if (File.Exists(source)) {
+					File.Move(source, $"{basePath}.{i + 1}{extension}");
+				}
+			}
+			File.Move(path, $"{basePath}.1{extension}");
+		}
+
+		/// <summary>
+		/// The file writer thread body.
+		/// </summary>
+		void WriterThread() {
+			while (true) {
+				writeEvent.WaitOne();
+
+				bool stop = false;
+				while (true) {
+					string record = null;
+					string path = null;
+					lock (syncLock) {
+						stop = stopping;
+						if (pendingWrites.Count == 0) {
+							break;
+						}
+						record = pendingWrites.Dequeue();
+						path = filePath;
+					}
+
+					try {
+						RotateIfNeeded(path);
+						using (var writer = new StreamWriter(path, true)) {
+							writer.Write(record);
+						}
+					}
+					catch (Exception e) {
+						lock (syncLock) {
+							threadError = $"Failed to write metrics to {path}: {e.Message}";
+						}
+					}
+				}
+
+				if (stop) {
+					return;
+				}
+			}
+		}
+
+		/// <summary>
+		/// The localhost endpoint thread body.
+		/// </summary>
+		/// <param name="state">The listener to accept connections from.</param>
+		void ListenerThread(object state) {
+			var threadListener = (TcpListener)state;
+			while (true) {
+				TcpClient client = null;
+				try {
+					client = threadListener.AcceptTcpClient();
+				}
+				catch (Exception) {
+					// Listener was stopped.
+					return;
+				}
+
+				try {
+					NetworkStream stream = client.GetStream();
+
+					// Any request gets the latest metrics. Read the request first so the client does not get a reset.
+					client.ReceiveTimeout = 1000;
+					byte[] request = new byte[1024];
+					stream.Read(request, 0, request.Length);
+
+					string body;
+					lock (syncLock) {
+						body = latestSnapshot;
+					}
+
+					byte[] bodyBytes = Encoding.UTF8.GetBytes(body);
+					byte[] header = Encoding.ASCII.GetBytes($"HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: {bodyBytes.Length}\r\nConnection: close\r\n\r\n");
+					stream.Write(header, 0, header.Length);
+					stream.Write(bodyBytes, 0, bodyBytes.Length);
+				}
+				catch (Exception e) {
+					lock (syncLock) {
+						threadError = $"Failed to serve metrics: {e.Message}";
+					}
+				}
+				finally {
+					client.Close();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,288 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Threading;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Captures raw network packets into a compact binary file for offline analysis. (see MSCMPReplay tool)
+	/// </summary>
+	/// <remarks>
+	/// File layout: header (magic, version, capture start time in UTC ticks) followed by records.
+	/// Each record is: uint32 time in ms since capture start, byte direction, byte send type, byte channel, uint32 length and the packet data.
+	///
+	/// This file does not depend on Unity so it can be shared with the replay tool.
+	/// </remarks>
+	class NetCapture {
+
+		/// <summary>
+		/// The magic at the beginning of the capture file. ("MSCP")
+		/// </summary>
+		public const uint MAGIC = 0x5043534d;
+
+		/// <summary>
+		/// The version of the capture file format.
+		/// </summary>
+		public const ushort VERSION = 1;
+
+		/// <summary>
+		/// Direction of the captured packet.
+		/// </summary>
+		public enum Direction : byte {
+			Incoming,
+			Outgoing
+		}
+
+		/// <summary>
+		/// Single captured packet.
+		/// </summary>
+		public class Record {
+			public uint time;
+			public Direction direction;
+			public byte sendType;
+			public byte channel;
+			public byte[] data;
+		}
+
+		/// <summary>
+		/// The capture file stream.
+		/// </summary>
+		FileStream file = null;
+
+		/// <summary>
+		/// The timestamp of the capture start. (see <see cref="Stopwatch.GetTimestamp"/>)
+		/// </summary>
+		long startTimestamp = 0;
+
+		/// <summary>
+		/// Serialized records waiting to be written by the writer thread.
+		/// </summary>
+		Queue<byte[]> pendingWrites = new Queue<byte[]>();
+
+		/// <summary>
+		/// Event signaled when there are pending writes or capture is stopping.
+		/// </summary>
+		AutoResetEvent writeEvent = new AutoResetEvent(false);
+
+		/// <summary>
+		/// The file writer thread.
+		/// </summary>
+		Thread writerThread = null;
+
+		/// <summary>
+		/// Is the writer thread supposed to stop after writing pending records?
+		/// </summary>
+		bool stopping = false;
+
+		/// <summary>
+		/// Lock guarding <see cref="pendingWrites"/> and <see cref="stopping"/>.
+		/// </summary>
+		object syncLock = new object();
+
+		/// <summary>
+		/// Amount of captured packets.
+		/// </summary>
+		int packetsCaptured = 0;
+
+		/// <summary>
+		/// Amount of captured bytes. (Including record headers)
+		/// </summary>
+		long bytesCaptured = 0;
+
+		/// <summary>
+		/// Path of the capture file.
+		/// </summary>
+		public string FilePath {
+			get; private set;
+		}
+
+		public int PacketsCaptured {
+			get { return packetsCaptured; }
+		}
+
+		public long BytesCaptured {
+			get { return bytesCaptured; }
+		}
+
+		/// <summary>
+		/// Start capture to the given file.
+		/// </summary>
+		/// <param name="path">The path of the capture file.</param>
+		/// <returns>true if capture was started, false otherwise</returns>
+		public bool Start(string path) {
+			try {
+				file = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.Read, 64 * 1024);
+
+				var writer = new BinaryWriter(file);
+				writer.Write(MAGIC);
+				writer.Write(VERSION);
+				writer.Write(DateTime.UtcNow.Ticks);
+				writer.Flush();
+			}
+			catch (Exception e) {
+				Logger.Error($"Failed to start network capture to {path}: {e.Message}");
+				file = null;
+				return false;
+			}
+
+			FilePath = path;
+			startTimestamp = Stopwatch.GetTimestamp();
+
+			writerThread = new Thread(WriterThread);
+			writerThread.IsBackground = true;
+			writerThread.Name = "MSCMP capture writer";
+			writerThread.Start();
+			return true;
+		}
+
+		/// <summary>
+		/// Stop capture. Waits until all pending records are written.
+		/// </summary>
+		public void Stop() {
+			if (writerThread == null) {
+				return;
+			}
+
+			lock (syncLock) {
+				stopping = true;
+			}
+			writeEvent.Set();
+			writerThread.Join();
+			writerThread = null;
+
+			file.Close();
+			file = null;
+		}
+
+		/// <summary>
+		/// Capture packet.
+		/// </summary>
+		/// <param name="direction">The direction of the packet.</param>
+		/// <param name="data">The packet data.</param>
+		/// <param name="length">The length of the packet data.</param>
+		/// <param name="sendType">The send type of the packet. (For incoming packets it is not known and 0 is written)</param>
+		/// <param name="channel">The channel of the packet.</param>
+		public void Capture(Direction direction, byte[] data, int length, byte sendType, byte channel) {
+			uint time = (uint)((Stopwatch.GetTimestamp() - startTimestamp) * 1000 / Stopwatch.Frequency);
+
+			// Serialize on the calling thread so data buffer can be reused right after this call.
+
+			const int HEADER_SIZE = 4 + 1 + 1 + 1 + 4;
+			byte[] record = new byte[HEADER_SIZE + length];
+			WriteUInt32(record, 0, time);
+			record[4] = (byte)direction;
+			record[5] = sendType;
+			record[6] = channel;
+			WriteUInt32(record, 7, (uint)length);
+			Buffer.BlockCopy(data, 0, record, HEADER_SIZE, length);
+
+			lock (syncLock) {
+				pendingWrites.Enqueue(record);
+			}
+			writeEvent.Set();
+
+			packetsCaptured++;
+			bytesCaptured += record.Length;
+		}
+
+		/// <summary>
+		/// Write little endian uint32 into the buffer.
+		/// </summary>
+		/// <param name="buffer">The buffer.</param>
+		/// <param name="offset">The offset in the buffer.</param>
+		/// <param name="value">The value to write.</param>
+		static void WriteUInt32(byte[] buffer, int offset, uint value) {
+			buffer[offset] = (byte)value;
+			buffer[offset + 1] = (byte)(value >> 8);
+			buffer[offset + 2] = (byte)(value >> 16);
+			buffer[offset + 3] = (byte)(value >> 24);
+		}
+
+		/// <summary>
+		/// The file writer thread body.
+		/// </summary>
+		void WriterThread() {
+			while (true) {
+				writeEvent.WaitOne();
+
+				bool stop = false;
+				while (true) {
+					byte[] record = null;
+					lock (syncLock) {
+						stop = stopping;
+						if (pendingWrites.Count == 0) {
+							break;
+						}
+						record = pendingWrites.Dequeue();
+					}
+
+					try {
+						file.Write(record, 0, record.Length);
+					}
+					catch (Exception) {
+						// Disk is full or file got removed - nothing we can do here, capture is best effort.
+					}
+				}
+
+				try {
+					file.Flush();
+				}
+				catch (Exception) {
+					// Same as above.
+				}
+
+				if (stop) {
+					return;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Open capture file for reading.
+		/// </summary>
+		/// <param name="stream">The stream to read capture from.</param>
+		/// <param name="startTime">The UTC time when capture was started.</param>
+		/// <returns>Reader positioned at the first record.</returns>
+		/// <exception cref="InvalidDataException">Thrown when stream does not contain supported capture.</exception>
+		public static BinaryReader OpenForReading(Stream stream, out DateTime startTime) {
+			var reader = new BinaryReader(stream);
+			if (reader.ReadUInt32() != MAGIC) {
+				throw new InvalidDataException("Not a MSCMP network capture file.");
+			}
+
+			ushort version = reader.ReadUInt16();
+			if (version != VERSION) {
+				throw new InvalidDataException($"Unsupported capture version {version}.");
+			}
+
+			startTime = new DateTime(reader.ReadInt64(), DateTimeKind.Utc);
+			return reader;
+		}
+
+		/// <summary>
+		/// Read next record from the capture.
+		/// </summary>
+		/// <param name="reader">The reader returned by <see cref="OpenForReading"/>.</param>
+		/// <returns>The record or null if end of capture was reached. (Truncated last record is treated as the end)</returns>
+		public static Record ReadRecord(BinaryReader reader) {
+			try {
+				var record = new Record();
+				record.time = reader.ReadUInt32();
+				record.direction = (Direction)reader.ReadByte();
+				record.sendType = reader.ReadByte();
+				record.channel = reader.ReadByte();
+
+				int length = (int)reader.ReadUInt32();
+				record.data = reader.ReadBytes(length);
+				if (record.data.Length != length) {
+					return null;
+				}
+				return record;
+			}
+			catch (EndOfStreamException) {
+				return null;
+			}
+		}
+	}
+}
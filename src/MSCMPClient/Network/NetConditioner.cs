@@ -0,0 +1,560 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Network condition simulator sitting between network manager and the steam transport.
+	/// </summary>
+	/// <remarks>
+	/// Adds latency, jitter, loss, burst loss, reordering and duplication to the packets. All random decisions are
+	/// taken from seeded generators (one per direction) so the same seed and packet sequence gives the same result.
+	///
+	/// Reliable packets are only delayed and keep their order - steam would retransmit lost ones anyway. On the
+	/// receive side the send type is not known so loss, duplication and reordering is applied only to the messages
+	/// registered via <see cref="RegisterUnreliableMessage"/>.
+	/// </remarks>
+	class NetConditioner {
+
+		/// <summary>
+		/// Latency distribution.
+		/// </summary>
+		public enum Distribution {
+			Uniform,
+			Normal
+		}
+
+		/// <summary>
+		/// Single packet queued in the conditioner.
+		/// </summary>
+		public class Packet {
+			public ulong deliveryTime;
+			public byte[] data;
+			public Steamworks.CSteamID steamId;
+			public Steamworks.EP2PSend sendType;
+			public int channel;
+		}
+
+		/// <summary>
+		/// Impairments and state of the single direction.
+		/// </summary>
+		public class Direction {
+			/// <summary>
+			/// Base one way latency in milliseconds.
+			/// </summary>
+			public float latency = 0.0f;
+
+			/// <summary>
+			/// Latency variation in milliseconds. (Half range for uniform, standard deviation for normal distribution)
+			/// </summary>
+			public float jitter = 0.0f;
+
+			/// <summary>
+			/// Distribution of the latency variation.
+			/// </summary>
+			public Distribution distribution = Distribution.Uniform;
+
+			/// <summary>
+			/// Packet loss in percents when not in burst.
+			/// </summary>
+			public float loss = 0.0f;
+
+			/// <summary>
+			/// Chance in percents per packet to enter the burst loss state. (Gilbert-Elliott model)
+			/// </summary>
+			public float burstEnter = 0.0f;
+
+			/// <summary>
+			/// Chance in percents per packet to leave the burst loss state.
+			/// </summary>
+			public float burstExit = 50.0f;
+
+			/// <summary>
+			/// Packet loss in percents when in burst.
+			/// </summary>
+			public float burstLoss = 100.0f;
+
+			/// <summary>
+			/// Chance in percents for the packet to be held back so later packets overtake it.
+			/// </summary>
+			public float reorder = 0.0f;
+
+			/// <summary>
+			/// How long reordered packets are held back in milliseconds.
+			/// </summary>
+			public float reorderDelay = 50.0f;
+
+			/// <summary>
+			/// Chance in percents for the packet to be duplicated.
+			/// </summary>
+			public float duplicate = 0.0f;
+
+			/// <summary>
+			/// Random generator of this direction.
+			/// </summary>
+			public Random random = null;
+
+			/// <summary>
+			/// Is the direction currently in the burst loss state?
+			/// </summary>
+			public bool inBurst = false;
+
+			/// <summary>
+			/// Delivery time of the last queued reliable packet. Used to keep reliable packets in order.
+			/// </summary>
+			public ulong lastReliableDelivery = 0;
+
+			/// <summary>
+			/// Packets waiting for delivery sorted by delivery time.
+			/// </summary>
+			public List<Packet> queue = new List<Packet>();
+
+			public int packetsQueued = 0;
+			public int packetsDropped = 0;
+			public int packetsDuplicated = 0;
+			public int packetsReordered = 0;
+
+			/// <summary>
+			/// Reset the state of the direction.
+			/// </summary>
+			/// <param name="seed">The seed of the random generator.</param>
+			public void Reset(int seed) {
+				random = new Random(seed);
+				inBurst = false;
+				packetsQueued = packetsDropped = packetsDuplicated = packetsReordered = 0;
+			}
+
+			/// <summary>
+			/// Roll the chance.
+			/// </summary>
+			/// <param name="percent">The chance in percents.</param>
+			/// <returns>true if roll succeeded, false otherwise</returns>
+			public bool Roll(float percent) {
+				return percent > 0.0f && random.NextDouble() * 100.0 < percent;
+			}
+
+			/// <summary>
+			/// Sample the latency of the next packet.
+			/// </summary>
+			/// <returns>Latency in milliseconds.</returns>
+			public ulong SampleLatency() {
+				double variation = 0.0;
+				if (jitter > 0.0f) {
+					if (distribution == Distribution.Normal) {
+						// Box-Muller transform.
+						double u1 = 1.0 - random.NextDouble();
+						double u2 = random.NextDouble();
+						variation = jitter * System.Math.Sqrt(-2.0 * System.Math.Log(u1)) * System.Math.Cos(2.0 * System.Math.PI * u2);
+					}
+					else {
+						variation = jitter * (random.NextDouble() * 2.0 - 1.0);
+					}
+				}
+				return (ulong)System.Math.Max(0.0, latency + variation);
+			}
+
+			/// <summary>
+			/// Decide if the next packet is lost. Advances the burst loss state.
+			/// </summary>
+			/// <returns>true if packet should be dropped, false otherwise</returns>
+			public bool ShouldDrop() {
+				if (inBurst) {
+					if (Roll(burstExit)) {
+						inBurst = false;
+					}
+				}
+				else if (Roll(burstEnter)) {
+					inBurst = true;
+				}
+				return Roll(inBurst ? burstLoss : loss);
+			}
+
+			/// <summary>
+			/// Insert packet into the queue keeping it sorted. Packets with equal delivery time keep insertion order.
+			/// </summary>
+			/// <param name="packet">The packet to insert.</param>
+			public void Insert(Packet packet) {
+				int index = queue.Count;
+				while (index > 0 && queue[index - 1].deliveryTime > packet.deliveryTime) {
+					--index;
+				}
+				queue.Insert(index, packet);
+			}
+		}
+
+		/// <summary>
+		/// Is the conditioner enabled?
+		/// </summary>
+		bool enabled = false;
+
+		/// <summary>
+		/// The seed of the random generators.
+		/// </summary>
+		int seed = 0;
+
+		/// <summary>
+		/// Outgoing direction.
+		/// </summary>
+		Direction outgoing = new Direction();
+
+		/// <summary>
+		/// Incoming direction.
+		/// </summary>
+		Direction incoming = new Direction();
+
+		/// <summary>
+		/// Ids of the messages that are sent unreliably.
+		/// </summary>
+		HashSet<byte> unreliableMessages = new HashSet<byte>();
+
+		/// <summary>
+		/// Is the conditioner enabled?
+		/// </summary>
+		public bool Enabled {
+			get { return enabled; }
+			set {
+				if (value && !enabled) {
+					Reset();
+				}
+				enabled = value;
+			}
+		}
+
+		/// <summary>
+		/// The seed of the random generators. Changing it resets the generators.
+		/// </summary>
+		public int Seed {
+			get { return seed; }
+			set {
+				seed = value;
+				Reset();
+			}
+		}
+
+		public Direction Outgoing {
+			get { return outgoing; }
+		}
+
+		public Direction Incoming {
+			get { return incoming; }
+		}
+
+		public NetConditioner() {
+			Reset();
+		}
+
+		/// <summary>
+		/// Reset random generators and burst state of both directions.
+		/// </summary>
+		public void Reset() {
+			outgoing.Reset(seed);
+			incoming.Reset(seed + 1);
+		}
+
+		/// <summary>
+		/// Drop all packets waiting for delivery.
+		/// </summary>
+		public void Clear() {
+			outgoing.queue.Clear();
+			incoming.queue.Clear();
+		}
+
+		/// <summary>
+		/// Register message that is sent unreliably so incoming packets of this message can be lost, duplicated and reordered.
+		/// </summary>
+		/// <param name="messageId">The id of the message.</param>
+		public void RegisterUnreliableMessage(byte messageId) {
+			unreliableMessages.Add(messageId);
+		}
+
+		/// <summary>
+		/// Queue packet in the given direction.
+		/// </summary>
+		/// <param name="direction">The direction to queue packet in.</param>
+		/// <param name="packet">The packet to queue.</param>
+		/// <param name="reliable">Is the packet reliable?</param>
+		/// <param name="now">Current network clock.</param>
+		void Queue(Direction direction, Packet packet, bool reliable, ulong now) {
+			direction.packetsQueued++;
+
+			if (reliable) {
+				packet.deliveryTime = System.Math.Max(now + direction.SampleLatency(), direction.lastReliableDelivery);
+				direction.lastReliableDelivery = packet.deliveryTime;
+				direction.Insert(packet);
+				return;
+			}
+
+			if (direction.ShouldDrop()) {
+				direction.packetsDropped++;
+				return;
+			}
+
+			packet.deliveryTime = now + direction.SampleLatency();
+			if (direction.Roll(direction.reorder)) {
+				packet.deliveryTime += (ulong)direction.reorderDelay;
+				direction.packetsReordered++;
+			}
+			direction.Insert(packet);
+
+			if (direction.Roll(direction.duplicate)) {
+				var copy = new Packet();
+				copy.deliveryTime = now + direction.SampleLatency();
+				copy.data = packet.data;
+				copy.steamId = packet.steamId;
+				copy.sendType = packet.sendType;
+				copy.channel = packet.channel;
+				direction.Insert(copy);
+				direction.packetsDuplicated++;
+			}
+		}
+
+		/// <summary>
+		/// Queue outgoing packet.
+		/// </summary>
+		/// <param name="receiver">The receiver of the packet.</param>
+		/// <param name="data">The packet data.</param>
+		/// <param name="sendType">The send type.</param>
+		/// <param name="channel">The channel.</param>
+		/// <param name="now">Current network clock.</param>
+		public void QueueOutgoing(Steamworks.CSteamID receiver, byte[] data, Steamworks.EP2PSend sendType, int channel, ulong now) {
+			var packet = new Packet();
+			packet.data = data;
+			packet.steamId = receiver;
+			packet.sendType = sendType;
+			packet.channel = channel;
+
+			bool reliable = sendType == Steamworks.EP2PSend.k_EP2PSendReliable || sendType == Steamworks.EP2PSend.k_EP2PSendReliableWithBuffering;
+			Queue(outgoing, packet, reliable, now);
+		}
+
+		/// <summary>
+		/// Queue incoming packet.
+		/// </summary>
+		/// <param name="sender">The sender of the packet.</param>
+		/// <param name="data">The packet data.</param>
+		/// <param name="messageId">The id of the message in the packet.</param>
+		/// <param name="now">Current network clock.</param>
+		public void QueueIncoming(Steamworks.CSteamID sender, byte[] data, byte messageId, ulong now) {
+			var packet = new Packet();
+			packet.data = data;
+			packet.steamId = sender;
+
+			Queue(incoming, packet, !unreliableMessages.Contains(messageId), now);
+		}
+
+		/// <summary>
+		/// Pop the next packet that should be delivered.
+		/// </summary>
+		/// <param name="direction">The direction to pop packet from.</param>
+		/// <param name="now">Current network clock.</param>
+		/// <returns>The packet or null if there is no packet to deliver. When conditioner is disabled all packets are delivered.</returns>
+		Packet Pop(Direction direction, ulong now) {
+			if (direction.queue.Count == 0) {
+				return null;
+			}
+
+			Packet packet = direction.queue[0];
+			if (enabled && packet.deliveryTime > now) {
+				return null;
+			}
+			direction.queue.RemoveAt(0);
+			return packet;
+		}
+
+		/// <summary>
+		/// Pop the next outgoing packet that should be sent.
+		/// </summary>
+		/// <param name="now">Current network clock.</param>
+		/// <returns>The packet or null if there is nothing to send.</returns>
+		public Packet PopOutgoing(ulong now) {
+			return Pop(outgoing, now);
+		}
+
+		/// <summary>
+		/// Pop the next incoming packet that should be processed.
+		/// </summary>
+		/// <param name="now">Current network clock.</param>
+		/// <returns>The packet or null if there is nothing to process.</returns>
+		public Packet PopIncoming(ulong now) {
+			return Pop(incoming, now);
+		}
+
+		/// <summary>
+		/// Set conditioner parameter.
+		/// </summary>
+		/// <param name="key">Name of the parameter. Direction parameters are prefixed with in., out. or both.</param>
+		/// <param name="value">The value of the parameter.</param>
+		/// <returns>true if parameter was set, false if parameter or value is invalid</returns>
+		public bool SetParameter(string key, string value) {
+			key = key.ToLower();
+			if (key == "enabled") {
+				bool newEnabled = value == "1" || value.ToLower() == "true" || value.ToLower() == "on";
+				Enabled = newEnabled;
+				return true;
+			}
+			if (key == "seed") {
+				int newSeed;
+				if (!int.TryParse(value, out newSeed)) {
+					return false;
+				}
+				Seed = newSeed;
+				return true;
+			}
+
+			int dot = key.IndexOf('.');
+			if (dot == -1) {
+				return false;
+			}
+
+			string directionName = key.Substring(0, dot);
+			string parameter = key.Substring(dot + 1);
+			if (directionName == "in") {
+				return SetDirectionParameter(incoming, parameter, value);
+			}
+			if (directionName == "out") {
+				return SetDirectionParameter(outgoing, parameter, value);
+			}
+			if (directionName == "both") {
+				return SetDirectionParameter(incoming, parameter, value) && SetDirectionParameter(outgoing, parameter, value);
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Set parameter of the direction.
+		/// </summary>
+		/// <param name="direction">The direction.</param>
+		/// <param name="parameter">Name of the parameter.</param>
+		/// <param name="value">The value of the parameter.</param>
+		/// <returns>true if parameter was set, false if parameter or value is invalid</returns>
+		static bool SetDirectionParameter(Direction direction, string parameter, string value) {
+			if (parameter == "dist") {
+				switch (value.ToLower()) {
+					case "uniform":
+						direction.distribution = Distribution.Uniform;
+						return true;
+					case "normal":
+						direction.distribution = Distribution.Normal;
+						return true;
+				}
+				return false;
+			}
+
+			float number;
+			if (!float.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out number) || number < 0.0f) {
+				return false;
+			}
+
+			switch (parameter) {
+				case "latency":
+					direction.latency = number;
+					return true;
+				case "jitter":
+					direction.jitter = number;
+					return true;
+				case "loss":
+					direction.loss = number;
+					return true;
+				case "burst_enter":
+					direction.burstEnter = number;
+					return true;
+				case "burst_exit":
+					direction.burstExit = number;
+					return true;
+				case "burst_loss":
+					direction.burstLoss = number;
+					return true;
+				case "reorder":
+					direction.reorder = number;
+					return true;
+				case "reorder_delay":
+					direction.reorderDelay = number;
+					return true;
+				case "dup":
+					direction.duplicate = number;
+					return true;
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Load configuration file. Each line is key=value pair accepted by <see cref="SetParameter"/>, lines starting with # are comments.
+		/// </summary>
+		/// <param name="path">The path of the configuration file.</param>
+		/// <returns>true if configuration was loaded, false otherwise</returns>
+		public bool LoadConfig(string path) {
+			string[] lines;
+			try {
+				lines = File.ReadAllLines(path);
+			}
+			catch (Exception e) {
+				Logger.Error($"Failed to read network conditioner config {path}: {e.Message}");
+				return false;
+			}
+
+			for (int i = 0; i < lines.Length; ++i) {
+				string line = lines[i].Trim();
+				if (line.Length == 0 || line.StartsWith("#")) {
+					continue;
+				}
+
+				int separator = line.IndexOf('=');
+				if (separator == -1 || !SetParameter(line.Substring(0, separator).Trim(), line.Substring(separator + 1).Trim())) {
+					Logger.Error($"Invalid network conditioner config line {i + 1}: {line}");
+				}
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Save configuration file.
+		/// </summary>
+		/// <param name="path">The path of the configuration file.</param>
+		/// <returns>true if configuration was saved, false otherwise</returns>
+		public bool SaveConfig(string path) {
+			try {
+				using (var writer = new StreamWriter(path, false)) {
+					writer.WriteLine("# MSCMP network conditioner configuration");
+					writer.WriteLine($"enabled={(enabled ? 1 : 0)}");
+					writer.WriteLine($"seed={seed}");
+					WriteDirectionConfig(writer, "out", outgoing);
+					WriteDirectionConfig(writer, "in", incoming);
+				}
+			}
+			catch (Exception e) {
+				Logger.Error($"Failed to write network conditioner config {path}: {e.Message}");
+				return false;
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Write direction parameters into the configuration file.
+		/// </summary>
+		/// <param name="writer">The writer.</param>
+		/// <param name="prefix">The direction prefix.</param>
+		/// <param name="direction">The direction.</param>
+		static void WriteDirectionConfig(StreamWriter writer, string prefix, Direction direction) {
+			writer.WriteLine($"{prefix}.latency={direction.latency.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.jitter={direction.jitter.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.dist={direction.distribution.ToString().ToLower()}");
+			writer.WriteLine($"{prefix}.loss={direction.loss.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.burst_enter={direction.burstEnter.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.burst_exit={direction.burstExit.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.burst_loss={direction.burstLoss.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.reorder={direction.reorder.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.reorder_delay={direction.reorderDelay.ToString(CultureInfo.InvariantCulture)}");
+			writer.WriteLine($"{prefix}.dup={direction.duplicate.ToString(CultureInfo.InvariantCulture)}");
+		}
+
+		/// <summary>
+		/// Get human readable description of the direction.
+		/// </summary>
+		/// <param name="direction">The direction.</param>
+		/// <returns>The description.</returns>
+		public static string Describe(Direction direction) {
+			return $"latency {direction.latency} +/- {direction.jitter} ms ({direction.distribution}), loss {direction.loss}%, burst {direction.burstEnter}%/{direction.burstExit}%/{direction.burstLoss}%, reorder {direction.reorder}% (+{direction.reorderDelay} ms), dup {direction.duplicate}% | queued {direction.packetsQueued}, dropped {direction.packetsDropped}, reordered {direction.packetsReordered}, duplicated {direction.packetsDuplicated}, pending {direction.queue.Count}";
+		}
+	}
+}
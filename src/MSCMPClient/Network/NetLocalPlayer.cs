@@ -15,14 +15,60 @@ namespace MSCMP.Network {
 		public static NetLocalPlayer Instance = null;
 
 		/// <summary>
-		/// How much time in seconds left until next synchronization packet will be sent.
+		/// Minimal time between two animation synchronization packets in milliseconds.
 		/// </summary>
-		private float timeToUpdate = 0.0f;
+		public const ulong ANIM_SYNC_MIN_INTERVAL = 30;
 
 		/// <summary>
-		/// Synchronization interval in milliseconds.
+		/// Time between two packets while only the aim or crouch position changes in milliseconds.
 		/// </summary>
-		public const ulong SYNC_INTERVAL = 100;
+		public const ulong ANIM_SYNC_CONTINUOUS_INTERVAL = 100;
+
+		/// <summary>
+		/// Delay of the repeated packet after a discrete change in milliseconds. (Covers single lost packet)
+		/// </summary>
+		public const ulong ANIM_SYNC_REPEAT_DELAY = 100;
+
+		/// <summary>
+		/// Time between two packets while the animation state does not change in milliseconds.
+		/// </summary>
+		public const ulong ANIM_SYNC_REFRESH_INTERVAL = 1000;
+
+		/// <summary>
+		/// Bandwidth budget of the player synchronization in bytes per second.
+		/// </summary>
+		public const float PLAYER_SYNC_BUDGET = 1500.0f;
+
+		/// <summary>
+		/// The last sent animation state and the network clock time when it was sent.
+		/// </summary>
+		private PlayerAnimState lastSentAnimState;
+		private ulong lastAnimSyncTime = 0;
+		private bool hasSentAnimState = false;
+
+		/// <summary>
+		/// Network clock time of the repeated animation packet. (Zero if there is none pending)
+		/// </summary>
+		private ulong animSyncRepeatTime = 0;
+
+		/// <summary>
+		/// Decides when the player synchronization packet is sent.
+		/// </summary>
+		private SyncRateController syncRate = new SyncRateController(PLAYER_SYNC_BUDGET);
+
+		/// <summary>
+		/// The last sent state.
+		/// </summary>
+		private Vector3 lastSentPosition = Vector3.zero;
+		private Quaternion lastSentRotation = Quaternion.identity;
+		private bool lastSentPickedUp = false;
+		private Vector3 lastSentPickedUpPosition = Vector3.zero;
+		private Quaternion lastSentPickedUpRotation = Quaternion.identity;
+
+		/// <summary>
+		/// Game state of the player read by the animation synchronization.
+		/// </summary>
+		private PlayerAnimBindings animBindings = new PlayerAnimBindings();
 
 		/// <summary>
 		/// SteamID of local player.
@@ -74,29 +120,28 @@ namespace MSCMP.Network {
 
 			// Synchronization sending.
 
-			timeToUpdate -= Time.deltaTime;
-			if (timeToUpdate <= 0.0f && netManager.IsPlaying) {
-				if (animManager != null) {
-					animManager.PACKETS_LEFT_TO_SYNC--;
-					if (animManager.PACKETS_LEFT_TO_SYNC <= 0) {
-						animManager.PACKETS_LEFT_TO_SYNC = animManager.PACKETS_TOTAL_FOR_SYNC;
-						SendAnimSync();
-					}
-				}
-
-				switch (state) {
-					case State.OnFoot:
-						SendOnFootSync();
-						break;
-				}
+			if (!netManager.IsPlaying) {
+				return;
+			}
+
+			ulong now = netManager.GetNetworkClock();
+			if (animManager != null) {
+				SendAnimSync(now);
+			}
+
+			switch (state) {
+				case State.OnFoot:
+					SendOnFootSync(now);
+					break;
 			}
 		}
 
 		/// <summary>
-		/// Send on foot sync to the server.
+		/// Send on foot sync to the server if the sync rate controller decides so.
 		/// </summary>
+		/// <param name="now">Current network clock time.</param>
 		/// <returns>true if sync message was sent false otherwise</returns>
-		private bool SendOnFootSync() {
+		private bool SendOnFootSync(ulong now) {
 			GamePlayer player = GameWorld.Instance.Player;
 			if (player == null) {
 				return false;
@@ -106,13 +151,32 @@ namespace MSCMP.Network {
 				return false;
 			}
 
+			Transform playerTrans = playerObject.transform;
+			Transform objectTrans = player.PickedUpObject ? player.PickedUpObject.transform : null;
+
+			// Change since the last sent state, the held object counts as well. (It moves with the camera pitch)
+			float distance = (playerTrans.position - lastSentPosition).magnitude;
+			float angle = Quaternion.Angle(playerTrans.rotation, lastSentRotation);
+			bool pickedUp = objectTrans != null;
+			if (pickedUp != lastSentPickedUp) {
+				syncRate.ForceNextSend();
+			}
+			else if (pickedUp) {
+				distance = Mathf.Max(distance, (objectTrans.position - lastSentPickedUpPosition).magnitude);
+				angle = Mathf.Max(angle, Quaternion.Angle(objectTrans.rotation, lastSentPickedUpRotation));
+			}
+
+			if (!syncRate.ShouldSend(now, distance, angle)) {
+				return false;
+			}
+
 			Messages.PlayerSyncMessage message = new Messages.PlayerSyncMessage();
 
-			message.position = Utils.GameVec3ToNet(playerObject.transform.position);
-			message.rotation = Utils.GameQuatToNet(playerObject.transform.rotation);
+			message.position = Utils.GameVec3ToNet(playerTrans.position);
+			message.rotation = Utils.GameQuatToNet(playerTrans.rotation);
+			message.tick = NetManager.ClockToTick(now);
 
-			if (player.PickedUpObject) {
-				Transform objectTrans = player.PickedUpObject.transform;
+			if (pickedUp) {
 				var data = new Messages.PickedUpSync();
 				data.position = Utils.GameVec3ToNet(objectTrans.position);
 				data.rotation = Utils.GameQuatToNet(objectTrans.rotation);
@@ -124,59 +188,98 @@ namespace MSCMP.Network {
 				return false;
 			}
 
-			timeToUpdate = (float)SYNC_INTERVAL / 1000;
+			syncRate.Sent(now, distance, angle, netManager.LastMessageSize);
+			lastSentPosition = playerTrans.position;
+			lastSentRotation = playerTrans.rotation;
+			lastSentPickedUp = pickedUp;
+			if (pickedUp) {
+				lastSentPickedUpPosition = objectTrans.position;
+				lastSentPickedUpRotation = objectTrans.rotation;
+			}
 			return true;
 		}
 
 		/// <summary>
-		/// Send anim sync to the server.
+		/// Send anim sync to the server when the animation state changed.
 		/// </summary>
+		/// <remarks>
+		/// Discrete changes are sent right away and once more after ANIM_SYNC_REPEAT_DELAY, changes of the aim
+		/// and crouch position at most every ANIM_SYNC_CONTINUOUS_INTERVAL. Unchanged state is refreshed every
+		/// ANIM_SYNC_REFRESH_INTERVAL so a lost packet can't leave the wrong pose for long.
+		/// </remarks>
+		/// <param name="now">Current network clock time.</param>
 		/// <returns>true if sync message was sent false otherwise</returns>
-		private bool SendAnimSync() {
-			GamePlayer player = GameWorld.Instance.Player;
-			if (player == null) return false;
+		private bool SendAnimSync(ulong now) {
+			PlayerAnimState animState;
+			if (!ReadAnimState(out animState)) {
+				return false;
+			}
 
-			GameObject playerObject = player.Object;
-			if (playerObject == null) return false;
+			ulong elapsed = now - lastAnimSyncTime;
+			if (hasSentAnimState && elapsed < ANIM_SYNC_MIN_INTERVAL) {
+				return false;
+			}
 
-			if (playerObject.GetComponentInChildren<CharacterMotor>() == null) return false; //Player is dying!
+			bool changed = !hasSentAnimState || animState.Differs(lastSentAnimState, false);
+			bool repeat = animSyncRepeatTime != 0 && now >= animSyncRepeatTime;
+			bool continuous = elapsed >= ANIM_SYNC_CONTINUOUS_INTERVAL && animState.Differs(lastSentAnimState, true);
+			bool refresh = elapsed >= ANIM_SYNC_REFRESH_INTERVAL;
+			if (!changed && !repeat && !continuous && !refresh) {
+				return false;
+			}
 
 			Messages.AnimSyncMessage message = new Messages.AnimSyncMessage();
+			animState.Write(message);
+			message.tick = NetManager.ClockToTick(now);
 
-			message.isRunning = (Utils.GetPlaymakerScriptByName(playerObject, "Running").Fsm.ActiveStateName == "Run");
+			if (!netManager.BroadcastMessage(message, Steamworks.EP2PSend.k_EP2PSendUnreliable)) {
+				return false;
+			}
 
-			float leanRotation = Utils.GetPlaymakerScriptByName(playerObject, "Reach").Fsm.GetFsmFloat("Position").Value;
-			if (leanRotation != 0.0f) message.isLeaning = true;
-			else message.isLeaning = false;
+			animSyncRepeatTime = changed ? now + ANIM_SYNC_REPEAT_DELAY : 0;
+			lastSentAnimState = animState;
+			lastAnimSyncTime = now;
+			hasSentAnimState = true;
+			return true;
+		}
 
-			message.isGrounded = playerObject.GetComponentInChildren<CharacterMotor>().grounded;
+		/// <summary>
+		/// Read the current animation state of the player.
+		/// </summary>
+		/// <param name="animState">The animation state.</param>
+		/// <returns>false if there is no player or the player is dying.</returns>
+		private bool ReadAnimState(out PlayerAnimState animState) {
+			animState = new PlayerAnimState();
 
-			message.activeHandState = animManager.GetActiveHandState(playerObject);
+			GamePlayer player = GameWorld.Instance.Player;
+			if (player == null) return false;
 
-			message.swearId = int.MaxValue;
-			if (animManager.GetHandState(message.activeHandState) == PlayerAnimManager.HandStateId.MiddleFingering) {
-				message.swearId = Utils.GetPlaymakerScriptByName(playerObject, "PlayerFunctions").Fsm.GetFsmInt("RandomInt").Value;
-			}
-			PlayMakerFSM speechFsm = Utils.GetPlaymakerScriptByName(playerObject, "Speech");
-			if (speechFsm.ActiveStateName == "Swear") message.swearId = animManager.Swears_Offset + speechFsm.Fsm.GetFsmInt("RandomInt").Value;
-			else if (speechFsm.ActiveStateName == "Drunk speech") message.swearId = animManager.DrunkSpeaking_Offset + speechFsm.Fsm.GetFsmInt("RandomInt").Value;
-			else if (speechFsm.ActiveStateName == "Yes gestures") message.swearId = animManager.Agreeing_Offset + speechFsm.Fsm.GetFsmInt("RandomInt").Value;
+			GameObject playerObject = player.Object;
+			if (playerObject == null) return false;
 
-			message.aimRot = playerObject.transform.FindChild("Pivot/Camera/FPSCamera").transform.rotation.eulerAngles.x;
-			message.crouchPosition = Utils.GetPlaymakerScriptByName(playerObject, "Crouch").Fsm.GetFsmFloat("Position").Value;
+			if (!animBindings.Bind(playerObject)) return false;
 
-			GameObject DrunkObject = playerObject.transform.FindChild("Pivot/Camera/FPSCamera/FPSCamera").gameObject;
-			float DrunkValue = Utils.GetPlaymakerScriptByName(DrunkObject, "Drunk Mode").Fsm.GetFsmFloat("DrunkYmax").Value;
-			if (DrunkValue >= 4.5f) message.isDrunk = true;
-			else message.isDrunk = false;
+			animState.isRunning = (animBindings.RunningFsm.ActiveStateName == "Run");
+			animState.isLeaning = animBindings.LeanPosition.Value != 0.0f;
+			animState.isGrounded = animBindings.Motor.grounded;
 
-			if (!animManager.AreDrinksPreloaded()) animManager.PreloadDrinkObjects(playerObject);
-			message.drinkId = animManager.GetDrinkingObject(playerObject);
+			animState.activeHandState = animBindings.GetActiveHandState();
 
-			if (!netManager.BroadcastMessage(message, Steamworks.EP2PSend.k_EP2PSendUnreliable)) {
-				return false;
+			animState.swearId = PlayerAnimState.NO_SWEAR;
+			if (PlayerAnimManager.GetHandState(animState.activeHandState) == PlayerAnimManager.HandStateId.MiddleFingering) {
+				animState.swearId = animBindings.FingerRandomInt.Value;
 			}
+			PlayMakerFSM speechFsm = animBindings.SpeechFsm;
+			if (speechFsm.ActiveStateName == "Swear") animState.swearId = PlayerAnimManager.SWEARS_OFFSET + animBindings.SpeechRandomInt.Value;
+			else if (speechFsm.ActiveStateName == "Drunk speech") animState.swearId = PlayerAnimManager.DRUNK_SPEAKING_OFFSET + animBindings.SpeechRandomInt.Value;
+			else if (speechFsm.ActiveStateName == "Yes gestures") animState.swearId = PlayerAnimManager.AGREEING_OFFSET + animBindings.SpeechRandomInt.Value;
+
+			animState.aimRot = animBindings.AimTransform.rotation.eulerAngles.x;
+			animState.crouchPosition = animBindings.CrouchPosition.Value;
+			animState.isDrunk = animBindings.DrunkYMax.Value >= 4.5f;
 
+			if (!PlayerAnimManager.AreDrinksPreloaded()) PlayerAnimManager.PreloadDrinkObjects(animBindings.DrinkObjects);
+			animState.drinkId = animBindings.GetDrinkingObject();
 			return true;
 		}
 
@@ -250,15 +353,60 @@ namespace MSCMP.Network {
 		/// </summary>
 		/// <param name="objectID">The Object ID of the object.</param>
 		/// <param name="setOwner">Set owner of the object.</param>
-		public void SendObjectSync(int objectID, Vector3 pos, Quaternion rot, ObjectSyncManager.SyncTypes syncType, float[] syncedVariables) {
+		/// <param name="claimTime">Shared clock time of the ownership claim. (SetOwner and ForceSetOwner only)</param>
+		public void SendObjectSync(int objectID, Vector3 pos, Quaternion rot, ObjectSyncManager.SyncTypes syncType, byte[] syncedVariables, ulong claimTime = 0) {
+			Messages.ObjectSyncMessage msg = new Messages.ObjectSyncMessage();
+			msg.objectID = objectID;
+			msg.position = Utils.GameVec3ToNet(pos);
+			msg.rotation = Utils.GameQuatToNet(rot);
+			msg.SyncType = (int)syncType;
+			if (syncedVariables != null) {
+				msg.SyncedVariables = syncedVariables;
+			}
+			if (claimTime != 0) {
+				msg.ClaimTime = claimTime;
+			}
+			msg.tick = NetManager.ClockToTick(netManager.GetNetworkClock());
+			netManager.BroadcastMessage(msg, Steamworks.EP2PSend.k_EP2PSendReliable);
+		}
+
+		/// <summary>
+		/// Send object sync with velocities of the object. (Used by the receiver to extrapolate the object)
+		/// </summary>
+		/// <param name="objectID">The Object ID of the object.</param>
+		/// <param name="pos">The object's position.</param>
+		/// <param name="rot">The object's rotation.</param>
+		/// <param name="velocity">The object's linear velocity.</param>
+		/// <param name="angularVelocity">The object's angular velocity.</param>
+		/// <param name="syncType">The sync type.</param>
+		/// <param name="syncedVariables">Encoded synced variables of the object. (can be null)</param>
+		/// <param name="claimTime">Shared clock time of the ownership claim. (SetOwner and ForceSetOwner only)</param>
+		public void SendObjectSync(int objectID, Vector3 pos, Quaternion rot, Vector3 velocity, Vector3 angularVelocity, ObjectSyncManager.SyncTypes syncType, byte[] syncedVariables, ulong claimTime = 0) {
 			Messages.ObjectSyncMessage msg = new Messages.ObjectSyncMessage();
 			msg.objectID = objectID;
-			msg.position = Utils.GameVec3ToNet(pos);
-			msg.rotation = Utils.GameQuatToNet(rot);
+			msg.position = Utils.GameVec3ToNet(pos);
+			msg.rotation = Utils.GameQuatToNet(rot);
 			msg.SyncType = (int)syncType;
 			if (syncedVariables != null) {
 				msg.SyncedVariables = syncedVariables;
 			}
+			msg.Velocity = Utils.GameVec3ToNet(velocity);
+			msg.AngularVelocity = Utils.GameVec3ToNet(angularVelocity);
+			if (claimTime != 0) {
+				msg.ClaimTime = claimTime;
+			}
+			msg.tick = NetManager.ClockToTick(netManager.GetNetworkClock());
+			netManager.BroadcastMessage(msg, Steamworks.EP2PSend.k_EP2PSendReliable);
+		}
+
+		/// <summary>
+		/// Send states of the objects encoded in the snapshot.
+		/// </summary>
+		/// <param name="snapshot">The snapshot to send.</param>
+		public void SendObjectSnapshot(ObjectSnapshotWriter snapshot) {
+			Messages.ObjectSnapshotMessage msg = new Messages.ObjectSnapshotMessage();
+			snapshot.WriteTo(msg);
+			msg.tick = NetManager.ClockToTick(netManager.GetNetworkClock());
 			netManager.BroadcastMessage(msg, Steamworks.EP2PSend.k_EP2PSendReliable);
 		}
 
@@ -283,6 +431,21 @@ namespace MSCMP.Network {
 			msg.accepted = accepted;
 			netManager.BroadcastMessage(msg, Steamworks.EP2PSend.k_EP2PSendReliable);
 		}
+
+		/// <summary>
+		/// Reject ownership claim of the object.
+		/// </summary>
+		/// <param name="objectID">The Object ID of the object.</param>
+		/// <param name="owner">Claim of the current owner. (So the remote player can resolve the conflict)</param>
+		public void SendObjectSyncRejected(int objectID, OwnershipClaim owner) {
+			Messages.ObjectSyncResponseMessage msg = new Messages.ObjectSyncResponseMessage();
+			msg.objectID = objectID;
+			msg.accepted = false;
+			msg.ClaimOwner = owner.owner;
+			msg.ClaimTime = owner.time;
+			msg.ForceClaim = owner.force;
+			netManager.BroadcastMessage(msg, Steamworks.EP2PSend.k_EP2PSendReliable);
+		}
 		
 		/// <summary>
 		/// Send EventHook sync message.
@@ -326,7 +489,8 @@ namespace MSCMP.Network {
 			base.SwitchState(newState);
 
 			// Force synchronization to be send on next frame.
-			timeToUpdate = 0.0f;
+			syncRate.ForceNextSend();
+			hasSentAnimState = false;
 		}
 
 		/// <summary>
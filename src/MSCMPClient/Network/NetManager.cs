@@ -1,4 +1,5 @@
 using System;
+using System.Diagnostics;
 using System.IO;
 using UnityEngine;
 using MSCMP.UI;
@@ -6,7 +7,7 @@ using MSCMP.UI;
 namespace MSCMP.Network {
 	class NetManager {
 		private const int MAX_PLAYERS = 2;
-		private const int PROTOCOL_VERSION = 2;
+		private const int PROTOCOL_VERSION = 3;
 		private const uint PROTOCOL_ID = 0x6d73636d;
 
 		private Steamworks.Callback<Steamworks.GameLobbyJoinRequested_t> gameLobbyJoinRequestedCallback = null;
@@ -71,11 +72,65 @@ namespace MSCMP.Network {
 		/// </summary>
 		ulong remoteClock = 0;
 
+		/// <summary>
+		/// Estimated difference between the remote player's and the local network clock in milliseconds.
+		/// (See GetRemoteClock and GetSharedClock, kept fractional so the filter converges on small differences)
+		/// </summary>
+		double remoteClockOffset = 0.0;
+
 		/// <summary>
 		/// Current ping value.
 		/// </summary>
 		uint ping = 0;
 
+		/// <summary>
+		/// Current ping value in milliseconds.
+		/// </summary>
+		public uint Ping {
+			get { return ping; }
+		}
+
+		/// <summary>
+		/// Smoothed ping variation in milliseconds. (RFC 3550 style interarrival jitter estimate)
+		/// </summary>
+		float jitter = 0.0f;
+
+		/// <summary>
+		/// Smoothed ping variation in milliseconds.
+		/// </summary>
+		public float Jitter {
+			get { return jitter; }
+		}
+
+		/// <summary>
+		/// Was the ping measured at least once?
+		/// </summary>
+		bool hasPingSample = false;
+
+		/// <summary>
+		/// Was the remote clock offset measured at least once?
+		/// </summary>
+		bool hasClockOffsetSample = false;
+
+		/// <summary>
+		/// Size of the last written message in bytes. (Including the header)
+		/// </summary>
+		public long LastMessageSize {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Interpolation of the remote players' transforms.
+		/// </summary>
+		Math.TransformInterpolationSystem interpolationSystem = new Math.TransformInterpolationSystem();
+
+		/// <summary>
+		/// Interpolation of the remote players' transforms. (Evaluated before the players are updated)
+		/// </summary>
+		public Math.TransformInterpolationSystem InterpolationSystem {
+			get { return interpolationSystem; }
+		}
+
 		/// <summary>
 		/// The time when network manager was created in UTC.
 		/// </summary>
@@ -105,6 +160,54 @@ namespace MSCMP.Network {
 		/// </summary>
 		NetStatistics statistics;
 
+		/// <summary>
+		/// Network statistics object.
+		/// </summary>
+		public NetStatistics Statistics {
+			get { return statistics; }
+		}
+
+		/// <summary>
+		/// Metrics exporter object.
+		/// </summary>
+		MetricsExporter metricsExporter;
+
+		/// <summary>
+		/// Metrics exporter object.
+		/// </summary>
+		public MetricsExporter Metrics {
+			get { return metricsExporter; }
+		}
+
+		/// <summary>
+		/// Network condition simulator.
+		/// </summary>
+		NetConditioner conditioner = new NetConditioner();
+
+		/// <summary>
+		/// Network condition simulator.
+		/// </summary>
+		public NetConditioner Conditioner {
+			get { return conditioner; }
+		}
+
+		/// <summary>
+		/// The name of the network conditioner configuration file in app data folder.
+		/// </summary>
+		public const string CONDITIONER_CONFIG_FILE = "netsim.cfg";
+
+		/// <summary>
+		/// Active packet capture. (null if packets are not captured)
+		/// </summary>
+		NetCapture capture = null;
+
+		/// <summary>
+		/// Active packet capture. (null if packets are not captured)
+		/// </summary>
+		public NetCapture Capture {
+			get { return capture; }
+		}
+
 		/// <summary>
 		/// The time the connection was started in UTC.
 		/// </summary>
@@ -129,6 +232,21 @@ namespace MSCMP.Network {
 			netManagerCreationTime = DateTime.UtcNow;
 			netMessageHandler = new NetMessageHandler(this);
 			netWorld = new NetWorld(this);
+			metricsExporter = new MetricsExporter(this);
+			metricsExporter.StartFromEnvironment();
+
+			conditioner.RegisterUnreliableMessage(new Messages.PlayerSyncMessage().MessageId);
+			conditioner.RegisterUnreliableMessage(new Messages.AnimSyncMessage().MessageId);
+
+			string appData = Client.GetAppDataPath();
+			if (appData != null && File.Exists(appData + "/" + CONDITIONER_CONFIG_FILE)) {
+				conditioner.LoadConfig(appData + "/" + CONDITIONER_CONFIG_FILE);
+			}
+
+			string capturePath = Environment.GetEnvironmentVariable("MSCMP_CAPTURE");
+			if (!string.IsNullOrEmpty(capturePath)) {
+				StartCapture(capturePath == "1" ? null : capturePath);
+			}
 
 			p2pSessionRequestCallback = Steamworks.Callback<Steamworks.P2PSessionRequest_t>.Create(OnP2PSessionRequest);
 			p2pConnectFailCallback = Steamworks.Callback<Steamworks.P2PSessionConnectFail_t>.Create(OnP2PConnectFail);
@@ -234,11 +352,26 @@ namespace MSCMP.Network {
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.HeartbeatResponseMessage msg) => {
-				ping = (uint)(GetNetworkClock() - msg.clientClock);
+				uint newPing = (uint)(GetNetworkClock() - msg.clientClock);
+				if (hasPingSample) {
+					jitter += (System.Math.Abs((float)newPing - ping) - jitter) / 16.0f;
+				}
+				ping = newPing;
+				hasPingSample = true;
 
 				// TODO: Some smart lag compensation.
 				remoteClock = msg.clock;
 
+				// Remote clock was read half of the round trip ago.
+				long offset = (long)msg.clock + ping / 2 - (long)GetNetworkClock();
+				if (hasClockOffsetSample) {
+					remoteClockOffset += (offset - remoteClockOffset) / 8.0;
+				}
+				else {
+					remoteClockOffset = offset;
+					hasClockOffsetSample = true;
+				}
+
 				timeSinceLastHeartbeat = 0.0f;
 			});
 
@@ -275,6 +408,77 @@ namespace MSCMP.Network {
 			return (ulong)((DateTime.UtcNow - this.netManagerCreationTime).TotalMilliseconds);
 		}
 
+		/// <summary>
+		/// Get estimate of the host's network clock. All players read the same time from this clock so
+		/// it can be used to order events that happened on different computers. (e.g. ownership claims)
+		/// </summary>
+		/// <returns>Shared clock time in miliseconds.</returns>
+		public ulong GetSharedClock() {
+			if (IsHost) {
+				return GetNetworkClock();
+			}
+			return GetRemoteClock();
+		}
+
+		/// <summary>
+		/// Get estimate of the remote player's network clock.
+		/// </summary>
+		/// <returns>Remote network clock time in miliseconds.</returns>
+		public ulong GetRemoteClock() {
+			long clock = (long)GetNetworkClock() + RoundedClockOffset();
+			return clock > 0 ? (ulong)clock : 0;
+		}
+
+		/// <summary>
+		/// Map time of the remote player's network clock to the local network clock.
+		/// </summary>
+		/// <param name="remoteTime">Remote network clock time in milliseconds.</param>
+		/// <returns>Local network clock time in milliseconds.</returns>
+		public ulong RemoteToLocalClock(ulong remoteTime) {
+			long clock = (long)remoteTime - RoundedClockOffset();
+			return clock > 0 ? (ulong)clock : 0;
+		}
+
+		/// <summary>
+		/// Get the remote clock offset rounded to whole milliseconds.
+		/// </summary>
+		/// <returns>The offset in milliseconds.</returns>
+		long RoundedClockOffset() {
+			return (long)System.Math.Round(remoteClockOffset);
+		}
+
+		/// <summary>
+		/// Get the compact tick of the network clock sent with the state messages. (Low 16 bits, wraps every 65 seconds)
+		/// </summary>
+		/// <param name="clock">Network clock time in milliseconds.</param>
+		/// <returns>The tick.</returns>
+		public static ushort ClockToTick(ulong clock) {
+			return (ushort)clock;
+		}
+
+		/// <summary>
+		/// Reconstruct the remote player's network clock from the tick. The tick is decoded as a delta from the
+		/// estimated remote clock, so it is unambiguous as long as the estimate is within half of the wrap.
+		/// </summary>
+		/// <param name="tick">The tick. (See ClockToTick)</param>
+		/// <returns>Remote network clock time in miliseconds.</returns>
+		public ulong RemoteTickToClock(ushort tick) {
+			ulong reference = GetRemoteClock();
+			long clock = (long)reference + (short)(ushort)(tick - ClockToTick(reference));
+			return clock > 0 ? (ulong)clock : 0;
+		}
+
+		/// <summary>
+		/// Get the local network clock time when the remote player took the state.
+		/// </summary>
+		/// <param name="tick">The tick of the message.</param>
+		/// <param name="now">Local network clock time the message is handled at. (See GetNetworkClock)</param>
+		/// <returns>Local network clock time in milliseconds, never later than now.</returns>
+		public ulong GetRemoteStateTime(ushort tick, ulong now) {
+			// State can't be taken in the future, clamp the error of the clock estimate.
+			return System.Math.Min(RemoteToLocalClock(RemoteTickToClock(tick)), now);
+		}
+
 		/// <summary>
 		/// Writes given network message into a given stream.
 		/// </summary>
@@ -292,6 +496,7 @@ namespace MSCMP.Network {
 			}
 
 			statistics.RecordSendMessage(message.MessageId, stream.Length);
+			LastMessageSize = stream.Length;
 			return true;
 		}
 
@@ -313,12 +518,13 @@ namespace MSCMP.Network {
 				return false;
 			}
 
+			byte[] data = stream.ToArray();
 			foreach (NetPlayer player in players) {
 				if (player is NetLocalPlayer) {
 					continue;
 				}
 
-				player?.SendPacket(stream.GetBuffer(), sendType, channel);
+				SendPacket(player, data, sendType, channel);
 			}
 			return true;
 		}
@@ -342,7 +548,82 @@ namespace MSCMP.Network {
 				return false;
 			}
 
-			return player.SendPacket(stream.GetBuffer(), sendType, channel);
+			return SendPacket(player, stream.ToArray(), sendType, channel);
+		}
+
+		/// <summary>
+		/// Send packet to given player through the network conditioner.
+		/// </summary>
+		/// <param name="player">Player to who packet should be send.</param>
+		/// <param name="data">The data to send.</param>
+		/// <param name="sendType">The send type.</param>
+		/// <param name="channel">The channel used to deliver packet.</param>
+		/// <returns>true if packet was sent or queued, false otherwise</returns>
+		private bool SendPacket(NetPlayer player, byte[] data, Steamworks.EP2PSend sendType, int channel) {
+			if (player == null) {
+				return false;
+			}
+
+			capture?.Capture(NetCapture.Direction.Outgoing, data, data.Length, (byte)sendType, (byte)channel);
+
+			if (conditioner.Enabled) {
+				conditioner.QueueOutgoing(player.SteamId, data, sendType, channel, GetNetworkClock());
+				return true;
+			}
+			return player.SendPacket(data, sendType, channel);
+		}
+
+		/// <summary>
+		/// Start capturing packets.
+		/// </summary>
+		/// <remarks>
+		/// Outgoing packets are captured when they are sent by the game and incoming ones when they are processed,
+		/// so with network conditioner enabled the capture contains what the game has seen, not what was on the wire.
+		/// </remarks>
+		/// <param name="path">The path of the capture file or null to create one in the app data folder.</param>
+		/// <returns>true if capture was started, false otherwise</returns>
+		public bool StartCapture(string path) {
+			StopCapture();
+
+			if (path == null) {
+				string appData = Client.GetAppDataPath();
+				if (appData == null) {
+					Logger.Error("Cannot start network capture - app data folder is not available.");
+					return false;
+				}
+				path = appData + "/capture-" + DateTime.Now.ToString("yyyyMMdd-HHmmss") + ".mscap";
+			}
+
+			var newCapture = new NetCapture();
+			if (!newCapture.Start(path)) {
+				return false;
+			}
+			capture = newCapture;
+			Logger.Log($"Capturing network packets to {path}");
+			return true;
+		}
+
+		/// <summary>
+		/// Stop capturing packets.
+		/// </summary>
+		public void StopCapture() {
+			if (capture == null) {
+				return;
+			}
+			capture.Stop();
+			Logger.Log($"Network capture stopped. {capture.PacketsCaptured} packets written to {capture.FilePath}");
+			capture = null;
+		}
+
+		/// <summary>
+		/// Send outgoing packets which were delayed by the network conditioner.
+		/// </summary>
+		/// <param name="now">Current network clock. Packets with delivery time up to this value are sent.</param>
+		private void SendConditionedPackets(ulong now) {
+			NetConditioner.Packet packet;
+			while ((packet = conditioner.PopOutgoing(now)) != null) {
+				Steamworks.SteamNetworking.SendP2PPacket(packet.steamId, packet.data, (uint)packet.data.Length, packet.sendType, packet.channel);
+			}
 		}
 
 		/// <summary>
@@ -392,6 +673,7 @@ namespace MSCMP.Network {
 			state = State.Idle;
 			players[0].Dispose();
 			players[0] = null;
+			conditioner.Clear();
 			Logger.Log("Left lobby.");
 		}
 
@@ -415,6 +697,15 @@ namespace MSCMP.Network {
 			return players[1] != null;
 		}
 
+		/// <summary>
+		/// Check if the steam id is the host of the session the local player joined.
+		/// </summary>
+		/// <param name="steamId">The steam id to check.</param>
+		/// <returns>true if the local player is not the host and the steam id is the host's one, false otherwise.</returns>
+		public bool IsHostPlayer(Steamworks.CSteamID steamId) {
+			return IsPlayer && players[1] != null && players[1].SteamId == steamId;
+		}
+
 		/// <summary>
 		/// Cleanup remote player.
 		/// </summary>
@@ -425,6 +716,10 @@ namespace MSCMP.Network {
 			Steamworks.SteamNetworking.CloseP2PSessionWithUser(players[1].SteamId);
 			players[1].Dispose();
 			players[1] = null;
+
+			// Next player has a different clock.
+			remoteClockOffset = 0.0;
+			hasClockOffsetSample = false;
 		}
 
 
@@ -433,6 +728,10 @@ namespace MSCMP.Network {
 		/// </summary>
 		public void Disconnect() {
 			BroadcastMessage(new Messages.DisconnectMessage(), Steamworks.EP2PSend.k_EP2PSendReliable);
+
+			// Make sure disconnect message is not stuck in the conditioner.
+			SendConditionedPackets(ulong.MaxValue);
+
 			LeaveLobby();
 		}
 
@@ -517,19 +816,41 @@ namespace MSCMP.Network {
 					continue;
 				}
 
-				MemoryStream stream = new MemoryStream(data);
-				BinaryReader reader = new BinaryReader(stream);
-
-				uint protocolId = reader.ReadUInt32();
-				if (protocolId != PROTOCOL_ID) {
-					Logger.Error("The received message was not sent by MSCMP network layer.");
+				if (conditioner.Enabled && size > 4) {
+					conditioner.QueueIncoming(senderSteamId, data, data[4], GetNetworkClock());
 					continue;
 				}
 
-				byte messageId = reader.ReadByte();
-				statistics.RecordReceivedMessage(messageId, size);
-				netMessageHandler.ProcessMessage(messageId, senderSteamId, reader);
+				ProcessPacket(data, senderSteamId);
+			}
+
+			ulong now = GetNetworkClock();
+			NetConditioner.Packet packet;
+			while ((packet = conditioner.PopIncoming(now)) != null) {
+				ProcessPacket(packet.data, packet.steamId);
+			}
+		}
+
+		/// <summary>
+		/// Process single incomming packet.
+		/// </summary>
+		/// <param name="data">The packet data.</param>
+		/// <param name="senderSteamId">Steamid of the sender client.</param>
+		private void ProcessPacket(byte[] data, Steamworks.CSteamID senderSteamId) {
+			capture?.Capture(NetCapture.Direction.Incoming, data, data.Length, 0, 0);
+
+			MemoryStream stream = new MemoryStream(data);
+			BinaryReader reader = new BinaryReader(stream);
+
+			uint protocolId = reader.ReadUInt32();
+			if (protocolId != PROTOCOL_ID) {
+				Logger.Error("The received message was not sent by MSCMP network layer.");
+				return;
 			}
+
+			byte messageId = reader.ReadByte();
+			statistics.RecordReceivedMessage(messageId, data.Length);
+			netMessageHandler.ProcessMessage(messageId, senderSteamId, reader);
 		}
 
 		/// <summary>
@@ -537,6 +858,17 @@ namespace MSCMP.Network {
 		/// </summary>
 		public void FixedUpdate() {
 			netWorld.FixedUpdate();
+			if (IsOnline) {
+				Game.ObjectSyncManager.Instance?.FixedUpdate();
+			}
+		}
+
+		/// <summary>
+		/// Release the network manager. Stops the metrics exporter and the network capture.
+		/// </summary>
+		public void Dispose() {
+			StopCapture();
+			metricsExporter.Dispose();
 		}
 
 		/// <summary>
@@ -544,12 +876,18 @@ namespace MSCMP.Network {
 		/// </summary>
 		public void Update() {
 			statistics.NewFrame();
+			metricsExporter.Update();
 
 			if (!IsOnline) {
 				return;
 			}
 
+			long updateStart = Stopwatch.GetTimestamp();
+
 			netWorld.Update();
+			if (IsNetworkPlayerConnected()) {
+				Game.ObjectSyncManager.Instance?.Update(Time.deltaTime);
+			}
 			UpdateHeartbeat();
 			ProcessMessages();
 
@@ -560,9 +898,14 @@ namespace MSCMP.Network {
 			}
 #endif
 
+			interpolationSystem.Evaluate(GetNetworkClock());
 			foreach (NetPlayer player in players) {
 				player?.Update();
 			}
+
+			SendConditionedPackets(GetNetworkClock());
+
+			statistics.RecordUpdateTime((Stopwatch.GetTimestamp() - updateStart) * 1000000 / Stopwatch.Frequency);
 		}
 
 #if !PUBLIC_RELEASE
@@ -672,6 +1015,10 @@ namespace MSCMP.Network {
 			}
 
 			remoteClock = msg.clock;
+			if (!hasClockOffsetSample) {
+				// Rough estimate until the first heartbeat measures the ping.
+				remoteClockOffset = (long)msg.clock - (long)GetNetworkClock();
+			}
 			players[1].hasHandshake = true;
 		}
 
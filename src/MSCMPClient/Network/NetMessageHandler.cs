@@ -34,6 +34,7 @@ namespace MSCMP.Network {
 		/// <param name="Handler">The handler lambda.</param>
 		public void BindMessageHandler<T>(MessageHandler<T> Handler) where T : INetMessage, new() {
 			T message = new T();
+			netManager.Statistics.RegisterMessageName(message.MessageId, typeof(T).Name.Replace("Message", ""));
 
 			messageHandlers.Add(message.MessageId, (Steamworks.CSteamID sender, BinaryReader reader) => {
 				if (!message.Read(reader)) {
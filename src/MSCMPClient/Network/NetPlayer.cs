@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using UnityEngine;
 
 namespace MSCMP.Network {
@@ -53,19 +54,32 @@ namespace MSCMP.Network {
 		Math.TransformInterpolator pickedUpObjectInterpolator = new Math.TransformInterpolator();
 
 		/// <summary>
-		/// Interpolation time in miliseconds.
+		/// Network time when sync packet was received.
 		/// </summary>
-		public const ulong INTERPOLATION_TIME = NetLocalPlayer.SYNC_INTERVAL;
+		private ulong syncReceiveTime = 0;
 
 		/// <summary>
-		/// Network time when sync packet was received.
+		/// Received animation state waiting for its playback time.
 		/// </summary>
-		private ulong syncReceiveTime = 0;
+		struct PendingAnimSync {
+			public ulong playTime;
+			public Messages.AnimSyncMessage msg;
+		}
+
+		/// <summary>
+		/// Animation states delayed like the transforms so they stay in step with the movement.
+		/// </summary>
+		Queue<PendingAnimSync> pendingAnimSyncs = new Queue<PendingAnimSync>();
+
+		/// <summary>
+		/// Local network time when the last queued animation state was taken by the remote player.
+		/// </summary>
+		ulong lastAnimSyncTime = 0;
 
 		/// <summary>
 		/// Name of the game object we use as prefab for characters.
 		/// </summary>
-		private const string CHARACTER_PREFAB_NAME = "Assets/MPPlayerModel/MPPlayerModel.fbx";
+		public const string CHARACTER_PREFAB_NAME = "Assets/MPPlayerModel/MPPlayerModel.fbx";
 
 		/// <summary>
 		/// Current player state.
@@ -135,6 +149,11 @@ namespace MSCMP.Network {
 			GameObject loadedModel = Client.LoadAsset<GameObject>(CHARACTER_PREFAB_NAME);
 			characterGameObject = (GameObject)GameObject.Instantiate((GameObject)loadedModel, interpolator.CurrentPosition, interpolator.CurrentRotation);
 
+			if (interpolator.Slot == Math.TransformInterpolator.NO_SLOT) {
+				netManager.InterpolationSystem.Add(interpolator);
+				netManager.InterpolationSystem.Add(pickedUpObjectInterpolator);
+			}
+
 			// If character will disappear we uncomment this
 			// GameObject.DontDestroyOnLoad(go);
 
@@ -173,6 +192,9 @@ namespace MSCMP.Network {
 				GameObject.Destroy(characterGameObject);
 				characterGameObject = null;
 			}
+
+			netManager.InterpolationSystem.Remove(interpolator);
+			netManager.InterpolationSystem.Remove(pickedUpObjectInterpolator);
 		}
 
 		/// <summary>
@@ -191,31 +213,31 @@ namespace MSCMP.Network {
 		/// </summary>
 		public virtual void Update() {
 
-			// Some naive interpolation.
+			// Play back received states with the jitter buffer delay.
+			ulong now = netManager.GetNetworkClock();
+			while (pendingAnimSyncs.Count > 0 && pendingAnimSyncs.Peek().playTime <= now) {
+				ApplyAnimSync(pendingAnimSyncs.Dequeue().msg);
+			}
 
+			// Interpolators were evaluated by the NetManager's TransformInterpolationSystem.
 			if (characterGameObject && syncReceiveTime > 0) {
-				float progress = (float)(netManager.GetNetworkClock() - syncReceiveTime) / INTERPOLATION_TIME;
-
 				float speed = 0.0f;
-				if (progress <= 2.0f) {
-					Vector3 oldPos = interpolator.CurrentPosition;
-					Vector3 currentPos = Vector3.zero;
-					Quaternion currentRot = Quaternion.identity;
-					interpolator.Evaluate(ref currentPos, ref currentRot, progress);
-					Vector3 delta = (currentPos - oldPos);
+				if (interpolator.Updated) {
+					Vector3 delta = (interpolator.CurrentPosition - interpolator.PreviousPosition);
 					delta.y = 0.0f;
 					speed = delta.magnitude;
 
 					UpdateCharacterPosition();
+				}
 
-					pickedUpObjectInterpolator.Evaluate(progress);
+				if (pickedUpObjectInterpolator.Updated) {
 					UpdatePickedupPosition();
 				}
 
 				if (animManager != null) {
 					animManager.HandleOnFootMovementAnimations(speed);
 					animManager.CheckBlendedOutAnimationStates();
-					animManager.SyncVerticalHeadLook(characterGameObject, progress);
+					animManager.SyncVerticalHeadLook();
 				}
 			}
 
@@ -249,17 +271,18 @@ namespace MSCMP.Network {
 			Vector3 targetPos = Utils.NetVec3ToGame(msg.position);
 			Quaternion targetRot = Utils.NetQuatToGame(msg.rotation);
 
-			interpolator.SetTarget(targetPos, targetRot);
+			if (!IsSpawned) {
+				Teleport(targetPos, targetRot);
+			}
+
 			syncReceiveTime = netManager.GetNetworkClock();
+			ulong senderTime = netManager.RemoteTickToClock(msg.tick);
+
+			interpolator.AddSnapshot(senderTime, syncReceiveTime, targetPos, targetRot);
 
 			if (msg.HasPickedUpData) {
 				var pickedUpData = msg.PickedUpData;
-				pickedUpObjectInterpolator.SetTarget(Utils.NetVec3ToGame(pickedUpData.position), Utils.NetQuatToGame(pickedUpData.rotation));
-			}
-
-			if (!IsSpawned) {
-				Teleport(targetPos, targetRot);
-				return;
+				pickedUpObjectInterpolator.AddSnapshot(senderTime, syncReceiveTime, Utils.NetVec3ToGame(pickedUpData.position), Utils.NetQuatToGame(pickedUpData.rotation));
 			}
 		}
 
@@ -268,6 +291,24 @@ namespace MSCMP.Network {
 		/// </summary>
 		/// <param name="msg">The received synchronization message.</param>
 		public void HandleAnimSynchronize(Messages.AnimSyncMessage msg) {
+			// Drop states reordered behind the already queued ones.
+			ulong stateTime = netManager.GetRemoteStateTime(msg.tick, netManager.GetNetworkClock());
+			if (stateTime < lastAnimSyncTime) {
+				return;
+			}
+			lastAnimSyncTime = stateTime;
+
+			PendingAnimSync pending;
+			pending.playTime = stateTime + (ulong)interpolator.Buffer.Delay;
+			pending.msg = msg;
+			pendingAnimSyncs.Enqueue(pending);
+		}
+
+		/// <summary>
+		/// Apply animation state once its playback time came.
+		/// </summary>
+		/// <param name="msg">The animation synchronization message.</param>
+		private void ApplyAnimSync(Messages.AnimSyncMessage msg) {
 			if (animManager != null) animManager.HandleAnimations(msg);
 		}
 
@@ -1,3 +1,4 @@
+using System.Diagnostics;
 using UnityEngine;
 using MSCMP.Utilities;
 
@@ -7,11 +8,35 @@ namespace MSCMP.Network {
 	/// </summary>
 	class NetStatistics {
 
-		const int HISTORY_SIZE = 100;
-		long[] bytesReceivedHistory = new long[HISTORY_SIZE];
-		long[] bytesSentHistory = new long[HISTORY_SIZE];
-		long maxBytesReceivedInHistory = 0;
-		long maxBytesSentInHistory = 0;
+		/// <summary>
+		/// The default size of the history in frames.
+		/// </summary>
+		public const int DEFAULT_HISTORY_SIZE = 100;
+
+		/// <summary>
+		/// Bytes received per frame history.
+		/// </summary>
+		SlidingWindow bytesReceivedHistory = new SlidingWindow(DEFAULT_HISTORY_SIZE);
+
+		/// <summary>
+		/// Bytes sent per frame history.
+		/// </summary>
+		SlidingWindow bytesSentHistory = new SlidingWindow(DEFAULT_HISTORY_SIZE);
+
+		/// <summary>
+		/// Frame time history in microseconds.
+		/// </summary>
+		SlidingWindow frameTimeHistory = new SlidingWindow(DEFAULT_HISTORY_SIZE);
+
+		/// <summary>
+		/// Network manager update time history in microseconds.
+		/// </summary>
+		SlidingWindow updateTimeHistory = new SlidingWindow(DEFAULT_HISTORY_SIZE);
+
+		/// <summary>
+		/// The timestamp of the last frame start. (see <see cref="Stopwatch.GetTimestamp"/>)
+		/// </summary>
+		long lastFrameTimestamp = 0;
 
 		int packetsSendTotal = 0;
 		int packetsReceivedTotal = 0;
@@ -31,6 +56,49 @@ namespace MSCMP.Network {
 		long bytesSentCurrentFrame = 0;
 		long bytesReceivedCurrentFrame = 0;
 
+		/// <summary>
+		/// The maximum amount of message types. (Message id is sent as byte)
+		/// </summary>
+		public const int MAX_MESSAGE_TYPES = 256;
+
+		long[] packetsSentPerMessage = new long[MAX_MESSAGE_TYPES];
+		long[] packetsReceivedPerMessage = new long[MAX_MESSAGE_TYPES];
+
+		long[] bytesSentPerMessage = new long[MAX_MESSAGE_TYPES];
+		long[] bytesReceivedPerMessage = new long[MAX_MESSAGE_TYPES];
+
+		/// <summary>
+		/// Names of the message types registered via <see cref="RegisterMessageName"/>.
+		/// </summary>
+		string[] messageNames = new string[MAX_MESSAGE_TYPES];
+
+		public long BytesSentTotal {
+			get { return bytesSentTotal; }
+		}
+		public long BytesReceivedTotal {
+			get { return bytesReceivedTotal; }
+		}
+		public long PacketsSentTotal {
+			get { return packetsSendTotal; }
+		}
+		public long PacketsReceivedTotal {
+			get { return packetsReceivedTotal; }
+		}
+
+		/// <summary>
+		/// Frame time history in microseconds.
+		/// </summary>
+		public SlidingWindow FrameTimeHistory {
+			get { return frameTimeHistory; }
+		}
+
+		/// <summary>
+		/// Network manager update time history in microseconds.
+		/// </summary>
+		public SlidingWindow UpdateTimeHistory {
+			get { return updateTimeHistory; }
+		}
+
 		/// <summary>
 		/// Network manager owning this object.
 		/// </summary>
@@ -70,24 +138,67 @@ namespace MSCMP.Network {
 			bytesSentLastFrame = bytesSentCurrentFrame;
 			bytesReceivedLastFrame = bytesReceivedCurrentFrame;
 
-			maxBytesReceivedInHistory = bytesSentCurrentFrame;
-			maxBytesSentInHistory = bytesReceivedCurrentFrame;
-			for (int i = 0; i < HISTORY_SIZE - 1; ++i) {
-				bytesSentHistory[i] = bytesSentHistory[i + 1];
-				if (maxBytesSentInHistory < bytesSentHistory[i]) {
-					maxBytesSentInHistory = bytesSentHistory[i];
-				}
-				bytesReceivedHistory[i] = bytesReceivedHistory[i + 1];
-				if (maxBytesReceivedInHistory < bytesReceivedHistory[i]) {
-					maxBytesReceivedInHistory = bytesReceivedHistory[i];
-				}
-			}
-
-			bytesSentHistory[HISTORY_SIZE - 1] = bytesSentCurrentFrame;
-			bytesReceivedHistory[HISTORY_SIZE - 1] = bytesReceivedCurrentFrame;
+			bytesSentHistory.Push(bytesSentCurrentFrame);
+			bytesReceivedHistory.Push(bytesReceivedCurrentFrame);
 
 			bytesSentCurrentFrame = 0;
 			bytesReceivedCurrentFrame = 0;
+
+			long timestamp = Stopwatch.GetTimestamp();
+			if (lastFrameTimestamp != 0) {
+				frameTimeHistory.Push((timestamp - lastFrameTimestamp) * 1000000 / Stopwatch.Frequency);
+			}
+			lastFrameTimestamp = timestamp;
+		}
+
+		/// <summary>
+		/// Change the size of the statistics history.
+		/// </summary>
+		/// <param name="frames">The new history size in frames.</param>
+		public void SetHistorySize(int frames) {
+			bytesSentHistory.Resize(frames);
+			bytesReceivedHistory.Resize(frames);
+			frameTimeHistory.Resize(frames);
+			updateTimeHistory.Resize(frames);
+		}
+
+		/// <summary>
+		/// Records how long network manager update took.
+		/// </summary>
+		/// <param name="microseconds">The update time in microseconds.</param>
+		public void RecordUpdateTime(long microseconds) {
+			updateTimeHistory.Push(microseconds);
+		}
+
+		/// <summary>
+		/// Register display name of the message type.
+		/// </summary>
+		/// <param name="messageId">The message id.</param>
+		/// <param name="name">The name of the message.</param>
+		public void RegisterMessageName(int messageId, string name) {
+			messageNames[messageId] = name;
+		}
+
+		/// <summary>
+		/// Get display name of the message type.
+		/// </summary>
+		/// <param name="messageId">The message id.</param>
+		/// <returns>Registered name of the message or its id if name is not known.</returns>
+		public string GetMessageName(int messageId) {
+			return messageNames[messageId] ?? messageId.ToString();
+		}
+
+		public long GetPacketsSent(int messageId) {
+			return packetsSentPerMessage[messageId];
+		}
+		public long GetPacketsReceived(int messageId) {
+			return packetsReceivedPerMessage[messageId];
+		}
+		public long GetBytesSent(int messageId) {
+			return bytesSentPerMessage[messageId];
+		}
+		public long GetBytesReceived(int messageId) {
+			return bytesReceivedPerMessage[messageId];
 		}
 
 		/// <summary>
@@ -101,6 +212,9 @@ namespace MSCMP.Network {
 
 			packetsSendCurrentFrame++;
 			packetsSendTotal++;
+
+			bytesSentPerMessage[messageId] += bytes;
+			packetsSentPerMessage[messageId]++;
 		}
 
 		/// <summary>
@@ -114,6 +228,9 @@ namespace MSCMP.Network {
 
 			packetsReceivedCurrentFrame++;
 			packetsReceivedTotal++;
+
+			bytesReceivedPerMessage[messageId] += bytes;
+			packetsReceivedPerMessage[messageId]++;
 		}
 
 		/// <summary>
@@ -171,6 +288,40 @@ namespace MSCMP.Network {
 			GL.Vertex3(end.x, Screen.height - end.y, 0.0f);
 		}
 
+		/// <summary>
+		/// Draw graph boundaries.
+		/// </summary>
+		/// <param name="drawRect">Rectangle where graph should drawn.</param>
+		void DrawGraphBoundaries(Rect drawRect) {
+			DrawLineHelper(new Vector2(drawRect.x, drawRect.y), new Vector2(drawRect.x + drawRect.width, drawRect.y), Color.gray);
+			DrawLineHelper(new Vector2(drawRect.x, drawRect.y), new Vector2(drawRect.x, drawRect.y + drawRect.height), Color.gray);
+			DrawLineHelper(new Vector2(drawRect.x + drawRect.width, drawRect.y), new Vector2(drawRect.x + drawRect.width, drawRect.y + drawRect.height), Color.gray);
+			DrawLineHelper(new Vector2(drawRect.x, drawRect.y + drawRect.height), new Vector2(drawRect.x + drawRect.width, drawRect.y + drawRect.height), Color.gray);
+		}
+
+		/// <summary>
+		/// Draw single history series.
+		/// </summary>
+		/// <param name="drawRect">Rectangle where graph should drawn.</param>
+		/// <param name="history">The history to draw.</param>
+		/// <param name="color">The color of the series line.</param>
+		void DrawSeries(Rect drawRect, SlidingWindow history, Color color) {
+			float stepWidth = drawRect.width / history.Capacity;
+			float scale = Mathf.Max(1, history.Max);
+
+			// Align newest value to the right edge of the graph.
+			int offset = history.Capacity - history.Count;
+
+			float previousY = drawRect.y + drawRect.height;
+			for (int i = 0; i < history.Count; ++i) {
+				float currentY = drawRect.y + drawRect.height * Mathf.Clamp01(1.0f - (history.GetFromOldest(i) / scale));
+				var start = new Vector2(drawRect.x + stepWidth * Mathf.Max(offset + i - 1, 0), previousY);
+				var end = new Vector2(drawRect.x + stepWidth * (offset + i), currentY);
+				DrawLineHelper(start, end, color);
+				previousY = currentY;
+			}
+		}
+
 		/// <summary>
 		/// Draw network graph.
 		/// </summary>
@@ -183,37 +334,53 @@ namespace MSCMP.Network {
 			GL.LoadPixelMatrix();
 			GL.Begin(GL.LINES);
 
-			// draw graph boundaries
+			DrawGraphBoundaries(drawRect);
+			DrawSeries(drawRect, bytesSentHistory, Color.red);
+			DrawSeries(drawRect, bytesReceivedHistory, Color.green);
 
-			DrawLineHelper(new Vector2(drawRect.x, drawRect.y), new Vector2(drawRect.x + drawRect.width, drawRect.y), Color.gray);
-			DrawLineHelper(new Vector2(drawRect.x, drawRect.y), new Vector2(drawRect.x, drawRect.y + drawRect.height), Color.gray);
-			DrawLineHelper(new Vector2(drawRect.x + drawRect.width, drawRect.y), new Vector2(drawRect.x + drawRect.width, drawRect.y + drawRect.height), Color.gray);
-			DrawLineHelper(new Vector2(drawRect.x, drawRect.y + drawRect.height), new Vector2(drawRect.x + drawRect.width, drawRect.y + drawRect.height), Color.gray);
+			GL.End();
+			GL.PopMatrix();
+		}
 
-			float stepWidth = drawRect.width / HISTORY_SIZE;
+		/// <summary>
+		/// Draw frame time graph.
+		/// </summary>
+		/// <param name="drawRect">Rectangle where graph should drawn.</param>
+		void DrawFrameTimeGraph(Rect drawRect) {
+			SetupLineMaterial();
 
-			for (int i = 0; i < HISTORY_SIZE; ++i) {
-				// draw send
+			lineMaterial.SetPass(0);
+			GL.PushMatrix();
+			GL.LoadPixelMatrix();
+			GL.Begin(GL.LINES);
 
-				long previousHistoryValue = i > 0 ? bytesSentHistory[i - 1] : 0;
-				float previousY = drawRect.y + drawRect.height * Mathf.Clamp01(1.0f - ((float)previousHistoryValue / Mathf.Max(1, maxBytesSentInHistory)));
-				var start = new Vector2(drawRect.x + stepWidth * Mathf.Max(i - 1, 0), previousY);
-				float currentY = drawRect.y + drawRect.height * Mathf.Clamp01(1.0f - ((float)bytesSentHistory[i] / Mathf.Max(1, maxBytesSentInHistory)));
-				var end = new Vector2(drawRect.x + stepWidth * i, currentY);
-				DrawLineHelper(start, end, Color.red);
+			DrawGraphBoundaries(drawRect);
+			DrawSeries(drawRect, frameTimeHistory, Color.yellow);
 
-				// draw receive
+			GL.End();
+			GL.PopMatrix();
+		}
 
-				previousHistoryValue = i > 0 ? bytesReceivedHistory[i - 1] : 0;
-				previousY = drawRect.y + drawRect.height * Mathf.Clamp01(1.0f - ((float)previousHistoryValue / Mathf.Max(1, maxBytesReceivedInHistory)));
-				start = new Vector2(drawRect.x + stepWidth * Mathf.Max(i - 1, 0), previousY);
-				currentY = drawRect.y + drawRect.height *  Mathf.Clamp01(1.0f - ((float)bytesReceivedHistory[i] / Mathf.Max(1, maxBytesReceivedInHistory)));
-				end = new Vector2(drawRect.x + stepWidth * i, currentY);
-				DrawLineHelper(start, end, Color.green);
+		/// <summary>
+		/// Helper used to format percentiles of the history.
+		/// </summary>
+		/// <param name="history">The history to get percentiles from.</param>
+		/// <param name="bytes">Is the history representing bytes?</param>
+		/// <returns>Formatted p50/p95/p99 string.</returns>
+		string FormatPercentiles(SlidingWindow history, bool bytes) {
+			if (bytes) {
+				return $"{FormatBytes(history.Percentile(50))} / {FormatBytes(history.Percentile(95))} / {FormatBytes(history.Percentile(99))}";
 			}
+			return $"{FormatMicroseconds(history.Percentile(50))} / {FormatMicroseconds(history.Percentile(95))} / {FormatMicroseconds(history.Percentile(99))}";
+		}
 
-			GL.End();
-			GL.PopMatrix();
+		/// <summary>
+		/// Helper used to format microseconds as milliseconds.
+		/// </summary>
+		/// <param name="microseconds">The microseconds.</param>
+		/// <returns>Formatted milliseconds string.</returns>
+		string FormatMicroseconds(long microseconds) {
+			return $"{microseconds / 1000.0f:0.0} ms";
 		}
 
 		/// <summary>
@@ -239,14 +406,14 @@ namespace MSCMP.Network {
 		public void Draw() {
 			GUI.color = Color.white;
 			const int WINDOW_WIDTH = 300;
-			const int WINDOW_HEIGHT = 600;
+			const int WINDOW_HEIGHT = 800;
 			Rect statsWindowRect = new Rect(Screen.width - WINDOW_WIDTH - 10, Screen.height - WINDOW_HEIGHT - 10, WINDOW_WIDTH, WINDOW_HEIGHT);
 			GUI.Window(666, statsWindowRect, (int window) => {
 
 				// Draw traffic graph title.
 
 				var rct = new Rect(10, 20, 200, 25);
-				GUI.Label(rct, $"Traffic graph (last {HISTORY_SIZE} frames):");
+				GUI.Label(rct, $"Traffic graph (last {bytesSentHistory.Capacity} frames):");
 				rct.y += 25;
 
 				var graphRect = new Rect(rct.x, rct.y, WINDOW_WIDTH - 20, 100);
@@ -265,15 +432,39 @@ namespace MSCMP.Network {
 				GUI.color = Color.white;
 				rct.y += 5;
 				rct.x += 5;
-				IMGUIUtils.DrawSmallLabel($"{FormatBytes(maxBytesSentInHistory)} sent/frame", rct, Color.red, true);
+				IMGUIUtils.DrawSmallLabel($"{FormatBytes(bytesSentHistory.Max)} sent/frame", rct, Color.red, true);
 				rct.y += 12;
 
-				IMGUIUtils.DrawSmallLabel($"{FormatBytes(maxBytesReceivedInHistory)} recv/frame", rct, Color.green, true);
+				IMGUIUtils.DrawSmallLabel($"{FormatBytes(bytesReceivedHistory.Max)} recv/frame", rct, Color.green, true);
 				rct.y -= 12 - 5;
 				rct.x -= 5;
 
 				rct.y += graphRect.height;
 
+				// Draw frame time graph.
+
+				GUI.color = Color.white;
+				GUI.Label(rct, "Frame time graph:");
+				rct.y += 25;
+
+				var frameGraphRect = new Rect(rct.x, rct.y, WINDOW_WIDTH - 20, 60);
+
+				GUI.color = new Color(0.0f, 0.0f, 0.0f, 0.35f);
+				IMGUIUtils.DrawPlainColorRect(frameGraphRect);
+
+				frameGraphRect.x += statsWindowRect.x;
+				frameGraphRect.y += statsWindowRect.y;
+				DrawFrameTimeGraph(frameGraphRect);
+
+				GUI.color = Color.white;
+				rct.y += 5;
+				rct.x += 5;
+				IMGUIUtils.DrawSmallLabel($"{FormatMicroseconds(frameTimeHistory.Max)} max, {FormatMicroseconds(frameTimeHistory.Min)} min", rct, Color.yellow, true);
+				rct.y -= 5;
+				rct.x -= 5;
+
+				rct.y += frameGraphRect.height;
+
 				rct.height = 20;
 
 				// Draw separator
@@ -301,6 +492,10 @@ namespace MSCMP.Network {
 				DrawStatHelper(ref rct, "bytesReceivedLastFrame", bytesReceivedLastFrame, 1000, true);
 				DrawStatHelper(ref rct, "bytesSendCurrentFrame", bytesSentCurrentFrame, 1000, true);
 				DrawStatHelper(ref rct, "bytesReceivedCurrentFrame", bytesReceivedCurrentFrame, 1000, true);
+				DrawTextHelper(ref rct, "sent/frame p50/95/99", FormatPercentiles(bytesSentHistory, true));
+				DrawTextHelper(ref rct, "recv/frame p50/95/99", FormatPercentiles(bytesReceivedHistory, true));
+				DrawTextHelper(ref rct, "frame time p50/95/99", FormatPercentiles(frameTimeHistory, false));
+				DrawTextHelper(ref rct, "update time p50/95/99", FormatPercentiles(updateTimeHistory, false));
 
 				// Draw separator
 
@@ -39,6 +39,31 @@ namespace MSCMP.Network {
 		/// </summary>
 		public bool playerIsLoading = true;
 
+		/// <summary>
+		/// World state being captured for the joining player. (null if none)
+		/// </summary>
+		WorldSnapshotWriter worldSnapshotWriter = null;
+
+		/// <summary>
+		/// Captured world state being encoded for the joining player. (null if none)
+		/// </summary>
+		WorldStateEncoder worldStateEncoder = null;
+
+		/// <summary>
+		/// Id of the next world state transfer.
+		/// </summary>
+		byte nextWorldStateId = 0;
+
+		/// <summary>
+		/// World state being received from the host. (null if none)
+		/// </summary>
+		WorldStateDecoder worldStateDecoder = null;
+
+		/// <summary>
+		/// Digest of the local world sent with the world state request. (null if none)
+		/// </summary>
+		WorldDigest requestDigest = null;
+
 		/// <summary>
 		/// Instance.
 		/// </summary>
@@ -190,17 +215,21 @@ namespace MSCMP.Network {
 		/// <param name="netMessageHandler">The network message handler to register messages to.</param>
 		void RegisterNetworkMessagesHandlers(NetMessageHandler netMessageHandler) {
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.PickupableSetPositionMessage msg) => {
-				Client.Assert(ObjectSyncManager.Instance.ObjectIDs.ContainsKey(msg.id), $"Tried to move pickupable that is not spawned {msg.id}.");
-				GameObject gameObject = ObjectSyncManager.Instance.ObjectIDs[msg.id].gameObject;
-				gameObject.transform.position = Utils.NetVec3ToGame(msg.position);
+				ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.id);
+				if (osc == null) {
+					Logger.Debug($"Tried to move pickupable that is not spawned {msg.id}, ignoring.");
+					return;
+				}
+				osc.transform.position = Utils.NetVec3ToGame(msg.position);
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.PickupableActivateMessage msg) => {
-				GameObject gameObject = null;
-				if (ObjectSyncManager.Instance.ObjectIDs.ContainsKey(msg.id)) {
-					gameObject = ObjectSyncManager.Instance.ObjectIDs[msg.id].gameObject;
+				ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.id);
+				if (osc == null) {
+					Logger.Debug($"Tried to activate pickupable that is not spawned {msg.id}, ignoring.");
+					return;
 				}
-				Client.Assert(gameObject != null, "Tried to activate pickupable but its not spawned!");
+				GameObject gameObject = osc.gameObject;
 
 				if (msg.activate) {
 					gameObject.SetActive(true);
@@ -217,20 +246,12 @@ namespace MSCMP.Network {
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.PickupableDestroyMessage msg) => {
-				if (!ObjectSyncManager.Instance.ObjectIDs.ContainsKey(msg.id)) {
-					return;
-				}
-
-				GameObject go;
-				try {
-					go = ObjectSyncManager.Instance.ObjectIDs[msg.id].gameObject;
-				}
-				catch {
-					Logger.Error("Failed to remove object: OSC found but can't get GameObject.");
+				ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.id);
+				if (osc == null) {
 					return;
 				}
 
-				GameObject.Destroy(ObjectSyncManager.Instance.ObjectIDs[msg.id].gameObject);
+				GameObject.Destroy(osc.gameObject);
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.WorldPeriodicalUpdateMessage msg) => {
@@ -276,37 +297,39 @@ namespace MSCMP.Network {
 				doors.Open(msg.open);
 			});
 
-			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.FullWorldSyncMessage msg) => {
-				NetPlayer player = netManager.GetPlayer(sender);
-
-				// This one should never happen - if happens there is something done miserably wrong.
-				Client.Assert(player != null, $"There is no player matching given steam id {sender}.");
-
-				// Handle full world state synchronization.
-
-				HandleFullWorldSync(msg);
-
-				// Spawn host character.
-
-				player.Spawn();
-
-				// Set player state.
-
-				player.Teleport(Utils.NetVec3ToGame(msg.spawnPosition), Utils.NetQuatToGame(msg.spawnRotation));
-
-				if (msg.pickedUpObject != NetPickupable.INVALID_ID) {
-					player.PickupObject(msg.pickedUpObject);
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.WorldStateChunkMessage msg) => {
+				if (!netManager.IsHostPlayer(sender)) {
+					Logger.Error($"Received world state chunk from {sender} who is not the host.");
+					return;
 				}
-
-				// World is loaded! Notify network manager about that.
-
-				netManager.OnNetworkWorldLoaded();
+				if (msg.index == 0) {
+					// Restarting the transfer would leave the world half-applied, finish the current one instead.
+					if (worldStateDecoder != null && worldStateDecoder.Applying) {
+						Logger.Error($"Received world state {msg.stateId} while applying world state {worldStateDecoder.StateId}, ignoring it.");
+						return;
+					}
+					worldStateDecoder = new WorldStateDecoder(sender, msg.stateId);
+				}
+				else if (worldStateDecoder == null || worldStateDecoder.StateId != msg.stateId) {
+					// Chunk of the transfer restarted by the host.
+					return;
+				}
+				worldStateDecoder.AddChunk(msg);
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.AskForWorldStateMessage msg) => {
-				var msgF = new Messages.FullWorldSyncMessage();
-				WriteFullWorldSync(msgF);
-				netManager.BroadcastMessage(msgF, Steamworks.EP2PSend.k_EP2PSendReliable);
+				// Captured across frames in Update, repeated request starts over.
+				// 'Player is loading' is only applicable for remote client.
+				playerIsLoading = false;
+				WorldDigest playerDigest = null;
+				if (msg.HasDigest) {
+					playerDigest = WorldDigest.FromLeaves(msg.Digest);
+					if (playerDigest == null) {
+						Logger.Error($"Player sent world digest of {msg.Digest.Length} buckets, sending the whole world.");
+					}
+				}
+				worldSnapshotWriter = new WorldSnapshotWriter(playerDigest);
+				worldStateEncoder = null;
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.VehicleEnterMessage msg) => {
@@ -316,7 +339,7 @@ namespace MSCMP.Network {
 					return;
 				}
 
-				ObjectSyncComponent vehicle = ObjectSyncManager.Instance.ObjectIDs[msg.objectID];
+				ObjectSyncComponent vehicle = ObjectSyncManager.Instance.GetObject(msg.objectID);
 				if (vehicle == null) {
 					Logger.Error("Player " + player.SteamId + " tried to enter vehicle with Object ID " + msg.objectID + " but there is no vehicle with such id.");
 					return;
@@ -334,15 +357,15 @@ namespace MSCMP.Network {
 				player.LeaveVehicle();
 			});
 
-			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.VehicleStateMessage msg) => {
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.VehicleStateMessage msg) => {
 				float startTime = -1;
 
-				ObjectSyncComponent vehicle = ObjectSyncManager.Instance.ObjectIDs[msg.objectID];
+				ObjectSyncComponent vehicle = ObjectSyncManager.Instance.GetObject(msg.objectID);
 				if (vehicle == null) {
 					Logger.Log("Remote player tried to set state of vehicle " + msg.objectID + " but there is no vehicle with such id.");
 					return;
-				}
-
+				}
+
 				if (msg.HasStartTime) {
 					startTime = msg.StartTime;
 				}
@@ -351,15 +374,15 @@ namespace MSCMP.Network {
 				subType.SetEngineState((PlayerVehicle.EngineStates)msg.state, (PlayerVehicle.DashboardStates)msg.dashstate, startTime);
 			});
 
-			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.VehicleSwitchMessage msg) => {
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.VehicleSwitchMessage msg) => {
 				float newValueFloat = -1;
 
-				PlayerVehicle vehicle = ObjectSyncManager.Instance.ObjectIDs[msg.objectID].GetObjectSubtype() as PlayerVehicle;
+				PlayerVehicle vehicle = ObjectSyncManager.Instance.GetObject(msg.objectID)?.GetObjectSubtype() as PlayerVehicle;
 				if (vehicle == null) {
 					Logger.Log("Remote player tried to change a switch in vehicle " + msg.objectID + " but there is no vehicle with such id.");
 					return;
-				}
-
+				}
+
 				if (msg.HasSwitchValueFloat) {
 					newValueFloat = msg.SwitchValueFloat;
 				}
@@ -372,67 +395,108 @@ namespace MSCMP.Network {
 				light.TurnOn(msg.toggle);
 			});
 
-			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSyncMessage msg) => {
-				ObjectSyncComponent osc;
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSyncMessage msg) => {
 				ObjectSyncManager.SyncTypes type = (ObjectSyncManager.SyncTypes)msg.SyncType;
-				try {
-					osc = ObjectSyncManager.Instance.ObjectIDs[msg.objectID];
-				}
-				catch {
-					Logger.Log($"Specified object is not yet added to the ObjectID's Dictionary! (Object ID: {msg.objectID})");
-					return;
-				}
-				if (osc != null) {
-					// Set owner.
-					if (type == ObjectSyncManager.SyncTypes.SetOwner) {
-						if (osc.Owner == ObjectSyncManager.NO_OWNER || osc.Owner == sender.m_SteamID) {
-							osc.OwnerSetToRemote(sender.m_SteamID);
-							netManager.GetLocalPlayer().SendObjectSyncResponse(osc.ObjectID, true);
-						}
-						else {
-							Logger.Debug($"Set owner request rejected for object: {osc.transform.name} (Owner: {osc.Owner} Sender: {sender.m_SteamID})");
-						}
-					}
-					// Remove owner.
-					else if (type == ObjectSyncManager.SyncTypes.RemoveOwner) {
-						if (osc.Owner == sender.m_SteamID) {
-							osc.OwnerRemoved();
-						}
-					}
-					// Force set owner.
-					else if (type == ObjectSyncManager.SyncTypes.ForceSetOwner) {
-						osc.Owner = sender.m_SteamID;
+				ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.objectID);
+				if (osc == null) {
+					Logger.Log($"Specified object is not spawned or was already removed! (Object ID: {msg.objectID})");
+					return;
+				}
+				// Set owner or force set owner.
+				if (type == ObjectSyncManager.SyncTypes.SetOwner || type == ObjectSyncManager.SyncTypes.ForceSetOwner) {
+					var claim = new OwnershipClaim(sender.m_SteamID, msg.HasClaimTime ? msg.ClaimTime : 0, type == ObjectSyncManager.SyncTypes.ForceSetOwner);
+					ObjectOwnership.Result result = osc.HandleOwnershipClaim(claim, false);
+					if (result == ObjectOwnership.Result.Accepted || result == ObjectOwnership.Result.LostOwnership) {
 						netManager.GetLocalPlayer().SendObjectSyncResponse(osc.ObjectID, true);
-						osc.SyncTakenByForce();
-						osc.SyncEnabled = false;
 					}
+					else if (result == ObjectOwnership.Result.Rejected || result == ObjectOwnership.Result.RejectedByOwner) {
+						Logger.Debug($"Set owner request rejected for object: {osc.transform.name} (Owner: {osc.Owner} Sender: {sender.m_SteamID})");
+						netManager.GetLocalPlayer().SendObjectSyncRejected(osc.ObjectID, osc.OwnershipClaim);
 
-					// Set object's position and variables
-					if (osc.Owner == sender.m_SteamID || type == ObjectSyncManager.SyncTypes.PeriodicSync) {
-						if (msg.HasSyncedVariables == true) {
-							osc.HandleSyncedVariables(msg.SyncedVariables);
+						// Sender already moved the object as the owner, roll it back to our state.
+						if (result == ObjectOwnership.Result.RejectedByOwner) {
+							osc.SendObjectSync(ObjectSyncManager.SyncTypes.GenericSync, true, true);
 						}
-						osc.SetPositionAndRotation(Utils.NetVec3ToGame(msg.position), Utils.NetQuatToGame(msg.rotation));
-					}
+					}
 				}
-			});
-
-			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSyncResponseMessage msg) => {
-				ObjectSyncComponent osc = ObjectSyncManager.Instance.ObjectIDs[msg.objectID];
-				if (msg.accepted) {
-					osc.SyncEnabled = true;
-					osc.Owner = Steamworks.SteamUser.GetSteamID().m_SteamID;
+				// Remove owner.
+				else if (type == ObjectSyncManager.SyncTypes.RemoveOwner) {
+					if (osc.Owner == sender.m_SteamID) {
+						osc.OwnerRemoved();
+					}
+				}
+
+				// Set object's position and variables
+				if (osc.Owner == sender.m_SteamID || type == ObjectSyncManager.SyncTypes.PeriodicSync) {
+					if (msg.HasSyncedVariables == true) {
+						osc.HandleSyncedVariables(msg.SyncedVariables, 0, msg.SyncedVariables.Length);
+					}
+					Vector3 velocity = msg.HasVelocity ? Utils.NetVec3ToGame(msg.Velocity) : Vector3.zero;
+					Vector3 angularVelocity = msg.HasAngularVelocity ? Utils.NetVec3ToGame(msg.AngularVelocity) : Vector3.zero;
+					ulong now = netManager.GetNetworkClock();
+					ulong stateTime = netManager.GetRemoteStateTime(msg.tick, now);
+					float age = (now >= stateTime ? now - stateTime : 0) / 1000.0f;
+					osc.HandleObjectState(Utils.NetVec3ToGame(msg.position), Utils.NetQuatToGame(msg.rotation), msg.HasVelocity, velocity, angularVelocity, age);
 				}
 			});
 
-			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSyncRequestMessage msg) => {
-				try {
-					ObjectSyncComponent osc = ObjectSyncManager.Instance.ObjectIDs[msg.objectID];
-					osc.SendObjectSync(ObjectSyncManager.SyncTypes.GenericSync, true, true);
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSnapshotMessage msg) => {
+				var snapshot = new ObjectSnapshotReader(msg);
+				ulong now = netManager.GetNetworkClock();
+				ulong stateTime = netManager.GetRemoteStateTime(msg.tick, now);
+				float age = (now >= stateTime ? now - stateTime : 0) / 1000.0f;
+				int missingObjects = 0;
+				while (snapshot.Next()) {
+					ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(snapshot.ObjectId);
+					if (osc == null) {
+						missingObjects++;
+						continue;
+					}
+					if (osc.Owner != sender.m_SteamID) {
+						continue;
+					}
+					if (snapshot.HasSyncedVariables) {
+						osc.HandleSyncedVariables(snapshot.Data, snapshot.SyncedVariablesOffset, snapshot.SyncedVariablesLength);
+					}
+					if (snapshot.AtRest) {
+						osc.HandleObjectAtRest(snapshot.Position, snapshot.Rotation);
+					}
+					else {
+						osc.HandleObjectState(snapshot.Position, snapshot.Rotation, snapshot.HasVelocity, snapshot.Velocity, snapshot.AngularVelocity, age);
+					}
+				}
+
+				if (snapshot.Failed) {
+					Logger.Error($"Received malformed object snapshot from {sender.m_SteamID}.");
+				}
+				if (missingObjects > 0) {
+					Logger.Log($"Object snapshot contained {missingObjects} objects that are not spawned or were already removed.");
+				}
+			});
+
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSyncResponseMessage msg) => {
+				ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.objectID);
+				if (osc == null) {
+					Logger.Debug($"Received sync response for object that was already removed, Object ID: {msg.objectID}");
+					return;
+				}
+				// Ownership is taken before the claim is sent, only rejection needs handling. Winner's claim is resolved
+				// the same way the remote player did it, if we lose the winner's state follows this message.
+				if (!msg.accepted && msg.HasClaimOwner) {
+					var claim = new OwnershipClaim(msg.ClaimOwner, msg.HasClaimTime ? msg.ClaimTime : 0, msg.HasForceClaim && msg.ForceClaim);
+					if (osc.HandleOwnershipClaim(claim, true) == ObjectOwnership.Result.LostOwnership) {
+						Logger.Debug($"Lost ownership conflict of object: {osc.transform.name} (Owner: {osc.Owner})");
+					}
 				}
-				catch {
+			});
+
+			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.ObjectSyncRequestMessage msg) => {
+				ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.objectID);
+				if (osc == null) {
 					Logger.Error($"Remote client tried to request object sync of an unknown object, Object ID: {msg.objectID}");
+					return;
 				}
+				osc.SendObjectSync(ObjectSyncManager.SyncTypes.GenericSync, true, true);
 			});
 
 			netMessageHandler.BindMessageHandler((Steamworks.CSteamID sender, Messages.EventHookSyncMessage msg) => {
@@ -455,10 +519,38 @@ namespace MSCMP.Network {
 		/// </summary>
 		public void Update() {
 
+			if (worldStateDecoder != null) {
+				if (!netManager.IsNetworkPlayerConnected()) {
+					worldStateDecoder = null;
+				}
+				else if (worldStateDecoder.Step(this, WorldStateDecoder.FRAME_BUDGET)) {
+					NetPlayer player = netManager.GetPlayer(worldStateDecoder.Sender);
+					Client.Assert(player != null, $"There is no player matching given steam id {worldStateDecoder.Sender}.");
+					OnFullWorldSyncHandled(player, worldStateDecoder.Message);
+					worldStateDecoder = null;
+				}
+			}
+
 			if (netManager.IsPlayer || !netManager.IsNetworkPlayerConnected()) {
+				worldSnapshotWriter = null;
+				worldStateEncoder = null;
 				return;
 			}
 
+			if (worldSnapshotWriter != null && worldSnapshotWriter.Step(netManager.GetLocalPlayer(), WorldSnapshotWriter.FRAME_BUDGET)) {
+				worldStateEncoder = new WorldStateEncoder(worldSnapshotWriter, nextWorldStateId++);
+				worldSnapshotWriter = null;
+			}
+
+			if (worldStateEncoder != null && worldStateEncoder.Poll()) {
+				if (worldStateEncoder.Chunks != null) {
+					foreach (Messages.WorldStateChunkMessage chunk in worldStateEncoder.Chunks) {
+						netManager.BroadcastMessage(chunk, Steamworks.EP2PSend.k_EP2PSendReliable);
+					}
+				}
+				worldStateEncoder = null;
+			}
+
 			timeToSendPeriodicalUpdate -= Time.deltaTime;
 
 			if (timeToSendPeriodicalUpdate <= 0.0f) {
@@ -496,129 +588,18 @@ namespace MSCMP.Network {
 		/// Called when game world gets unloaded.
 		/// </summary>
 		private void OnGameWorldUnload() {
-			ObjectSyncManager.Instance.ObjectIDs.Clear();
-		}
-
-		/// <summary>
-		/// Write full world synchronization message.
-		/// </summary>
-		/// <param name="msg">The message to write to.</param>
-		public void WriteFullWorldSync(Messages.FullWorldSyncMessage msg) {
-			Logger.Debug("Writing full world synchronization message.");
-			var watch = System.Diagnostics.Stopwatch.StartNew();
-			
-			// 'Player is loading' is only applicable for remote client.
-			playerIsLoading = false;
-
-			// Write time
-
-			Game.GameWorld gameWorld = Game.GameWorld.Instance;
-			msg.dayTime = gameWorld.WorldTime;
-			msg.day = gameWorld.WorldDay;
-
-			// Write mailbox name
-
-			msg.mailboxName = gameWorld.PlayerLastName;
-
-			// Write doors
-
-			List<GameDoor> doors = GameDoorsManager.Instance.doors;
-			int doorsCount = doors.Count;
-			msg.doors = new Messages.DoorsInitMessage[doorsCount];
-
-			Logger.Debug($"Writing state of {doorsCount} doors.");
-			for (int i = 0; i < doorsCount; ++i) {
-				var doorMsg = new Messages.DoorsInitMessage();
-				GameDoor door = doors[i];
-				doorMsg.position = Utils.GameVec3ToNet(door.Position);
-				doorMsg.open = door.IsOpen;
-				msg.doors[i] = doorMsg;
-			}
-
-			// Write light switches.
-
-
-			List<LightSwitch> lights = Game.LightSwitchManager.Instance.lightSwitches;
-			int lightCount = lights.Count;
-			msg.lights = new Messages.LightSwitchMessage[lightCount];
-
-			Logger.Debug($"Writing light switches state of {lightCount}");
-			for (int i = 0; i < lightCount; i++) {
-				var lightMsg = new Messages.LightSwitchMessage();
-				LightSwitch light = lights[i];
-				lightMsg.pos = Utils.GameVec3ToNet(light.Position);
-				lightMsg.toggle = light.SwitchStatus;
-				msg.lights[i] = lightMsg;
-			}
-
-			// Write weather
-
-			GameWeatherManager.Instance.WriteWeather(msg.currentWeather);
-
-			// Write objects. (Pickupables, Player vehicles, AI vehicles)
-
-			var pickupableMessages = new List<Messages.PickupableSpawnMessage>();
-			Logger.Debug($"Writing state of {ObjectSyncManager.Instance.ObjectIDs.Count} objects");
-			foreach (var kv in ObjectSyncManager.Instance.ObjectIDs) {
-				ObjectSyncComponent osc = kv.Value;
-				if (osc == null) {
-					continue;
-				}
-				if (osc.ObjectType != ObjectSyncManager.ObjectTypes.Pickupable) {
-					continue;
-				}
-				bool wasActive = true;
-				if (!osc.gameObject.activeSelf) {
-					wasActive = false;
-					osc.gameObject.SetActive(true);
-				}
-				Logger.Log($"Writing object: {osc.gameObject.name}");
-
-				var pickupableMsg = new Messages.PickupableSpawnMessage();
-
-				var metaData = osc.gameObject.GetComponent<PickupableMetaDataComponent>();
-				Client.Assert(metaData != null && metaData.PrefabDescriptor != null, $"Object with broken meta data -- {osc.gameObject.name}.");
-
-				pickupableMsg.prefabId = metaData.prefabId;
-
-				Transform transform = osc.gameObject.transform;
-				pickupableMsg.transform.position = Utils.GameVec3ToNet(transform.position);
-				pickupableMsg.transform.rotation = Utils.GameQuatToNet(transform.rotation);
-
-				pickupableMsg.active = osc.gameObject.activeSelf;
-
-				// ObjectID
-				pickupableMsg.id = osc.gameObject.GetComponent<ObjectSyncComponent>().ObjectID;
-
-				List<float> data = new List<float>();
-
-				if (data.Count != 0) {
-					pickupableMsg.Data = data.ToArray();
-				}
-				if (!wasActive) {
-					osc.gameObject.SetActive(false);
-				}
-				pickupableMessages.Add(pickupableMsg);
-			}
-
-			msg.pickupables = pickupableMessages.ToArray();
-
-			netManager.GetLocalPlayer().WriteSpawnState(msg);
-
-			watch.Stop();
-			Logger.Debug("World state has been written. Took " + watch.ElapsedMilliseconds + "ms");
+			worldSnapshotWriter = null;
+			worldStateEncoder = null;
+			worldStateDecoder = null;
+			requestDigest = null;
+			ObjectSyncManager.Instance.ClearObjects();
 		}
 
-
 		/// <summary>
-		/// Handle full world sync message.
+		/// Apply the world state of the full world sync except the pickupables.
 		/// </summary>
-		/// <param name="msg">The message to handle.</param>
-
-		public void HandleFullWorldSync(Messages.FullWorldSyncMessage msg) {
-			Logger.Debug("Handling full world synchronization message.");
-			var watch = System.Diagnostics.Stopwatch.StartNew();
-
+		/// <param name="msg">The full world sync message.</param>
+		public void ApplyWorldState(Messages.FullWorldSyncMessage msg) {
 			// Read time
 
 			Game.GameWorld gameWorld = Game.GameWorld.Instance;
@@ -654,12 +635,19 @@ namespace MSCMP.Network {
 			// Weather.
 
 			GameWeatherManager.Instance.SetWeather(msg.currentWeather);
+		}
 
-			// Pickupables
+		/// <summary>
+		/// Finish the full world sync once all pickupables are spawned.
+		/// </summary>
+		/// <param name="msg">The full world sync message.</param>
+		public void FinishWorldState(Messages.FullWorldSyncMessage msg) {
+			// Remove pickupables of the synced buckets that the host does not have.
 
-			foreach (Messages.PickupableSpawnMessage pickupableMsg in msg.pickupables) {
-				SpawnPickupable(pickupableMsg);
+			if (msg.HasSyncedBuckets) {
+				DestroyUnsyncedPickupables(msg);
 			}
+			requestDigest = null;
 
 			// Remove spawned (and active) pickupables that we did not get info about.
 
@@ -671,9 +659,65 @@ namespace MSCMP.Network {
 			
 			GamePickupableDatabase.Instance.Pickupables.Clear();
 			playerIsLoading = false;
-			
-			watch.Stop();
-			Logger.Debug("Full world synchronization message has been handled. Took " + watch.ElapsedMilliseconds + "ms");
+		}
+
+		/// <summary>
+		/// Destroy the local pickupables in the synced buckets of the partial world sync that were not sent.
+		/// Only the pickupables of the request digest are considered - pickupables spawned by the host while it
+		/// was capturing the state can arrive before the state and are not part of it.
+		/// </summary>
+		/// <param name="msg">The full world sync message.</param>
+		void DestroyUnsyncedPickupables(Messages.FullWorldSyncMessage msg) {
+			var sentIds = new HashSet<int>();
+			foreach (Messages.PickupableSpawnMessage pickupableMsg in msg.pickupables) {
+				sentIds.Add(pickupableMsg.id);
+			}
+
+			if (requestDigest == null) {
+				Logger.Error("Received partial world state without requesting it.");
+				return;
+			}
+
+			byte[] syncedBuckets = msg.SyncedBuckets;
+			var objects = ObjectSyncManager.Instance.ObjectIDs;
+			var unsyncedIds = new List<int>();
+			for (int i = 0; i < objects.Count; ++i) {
+				ObjectSyncComponent osc = objects.GetAt(i);
+				int id = objects.GetIdAt(i);
+				if (osc != null && osc.ObjectType == ObjectSyncManager.ObjectTypes.Pickupable && requestDigest.IsCaptured(id) && WorldDigest.IsSet(syncedBuckets, WorldDigest.GetBucket(id)) && !sentIds.Contains(id)) {
+					unsyncedIds.Add(id);
+				}
+			}
+
+			foreach (int id in unsyncedIds) {
+				DestroyPickupableLocal(id);
+			}
+			if (unsyncedIds.Count > 0) {
+				Logger.Log($"Destroyed {unsyncedIds.Count} pickupables the host does not have.");
+			}
+		}
+
+		/// <summary>
+		/// Spawn the host once the full world sync is handled.
+		/// </summary>
+		/// <param name="player">The host.</param>
+		/// <param name="msg">The full world sync message.</param>
+		void OnFullWorldSyncHandled(NetPlayer player, Messages.FullWorldSyncMessage msg) {
+			// Spawn host character.
+
+			player.Spawn();
+
+			// Set player state.
+
+			player.Teleport(Utils.NetVec3ToGame(msg.spawnPosition), Utils.NetQuatToGame(msg.spawnRotation));
+
+			if (msg.pickedUpObject != NetPickupable.INVALID_ID) {
+				player.PickupObject(msg.pickedUpObject);
+			}
+
+			// World is loaded! Notify network manager about that.
+
+			netManager.OnNetworkWorldLoaded();
 		}
 
 		/// <summary>
@@ -681,6 +725,14 @@ namespace MSCMP.Network {
 		/// </summary>
 		public void AskForFullWorldSync() {
 			Messages.AskForWorldStateMessage msg = new Messages.AskForWorldStateMessage();
+
+			// Host sends only the parts of the world that differ from the local one.
+
+			var watch = System.Diagnostics.Stopwatch.StartNew();
+			requestDigest = WorldDigest.Capture();
+			msg.Digest = requestDigest.Leaves;
+			Logger.Debug($"World digest captured in {watch.Elapsed.TotalMilliseconds:0.00} ms.");
+
 			netManager.BroadcastMessage(msg, Steamworks.EP2PSend.k_EP2PSendReliable);
 		}
 
@@ -699,8 +751,9 @@ namespace MSCMP.Network {
 		/// <param name="objectID">Object id of the pickupable.</param>
 		/// <returns>Game object representing the given pickupable or null if there is no pickupable matching this network id.</returns>
 		public GameObject GetPickupableGameObject(int objectID) {
-			if (ObjectSyncManager.Instance.ObjectIDs.ContainsKey(objectID)) {
-				return ObjectSyncManager.Instance.ObjectIDs[objectID].gameObject;
+			ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(objectID);
+			if (osc != null) {
+				return osc.gameObject;
 			}
 			return null;
 		}
@@ -711,18 +764,11 @@ namespace MSCMP.Network {
 		/// <param name="go">Game object to get object id for.</param>
 		/// <returns>The object id of pickupable or invalid id of the pickupable if no object ID is found for given game object.</returns>
 		public ObjectSyncComponent GetPickupableByGameObject(GameObject go) {
-			foreach (var osc in ObjectSyncManager.Instance.ObjectIDs) {
-				try {
-					if (osc.Value.gameObject == go) {
-						return osc.Value;
-					}
-				}
-				catch {
-
-				}
+			ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObjectByGameObject(go);
+			if (osc == null) {
+				Logger.Error("GetPickupableByGameObject: Couldn't find GameObject!");
 			}
-			Logger.Error("GetPickupableByGameObject: Couldn't find GameObject!");
-			return null;
+			return osc;
 		}
 
 		/// <summary>
@@ -731,10 +777,9 @@ namespace MSCMP.Network {
 		/// <param name="go">Game object to get object ID for.</param>
 		/// <returns>The object ID of pickupable or invalid ID of the pickupable if no object ID is found for given game object.</returns>
 		public int GetPickupableObjectId(GameObject go) {
-			foreach (var osc in ObjectSyncManager.Instance.ObjectIDs) {
-				if (osc.Value.gameObject == go) {
-					return osc.Value.ObjectID;
-				}
+			ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObjectByGameObject(go);
+			if (osc != null) {
+				return osc.ObjectID;
 			}
 			return NetPickupable.INVALID_ID;
 		}
@@ -758,6 +803,35 @@ namespace MSCMP.Network {
 			}
 		}
 
+		/// <summary>
+		/// Apply pickupable state of the full world sync. Pickupable of the same prefab under the id is only moved,
+		/// pickupable of other prefab is replaced.
+		/// </summary>
+		/// <param name="msg">The pickupable state.</param>
+		public void ApplyPickupable(Messages.PickupableSpawnMessage msg) {
+			ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.id);
+			if (osc != null) {
+				if (osc.ObjectType != ObjectSyncManager.ObjectTypes.Pickupable) {
+					Logger.Error($"Pickupable {msg.id} of the world sync collides with {osc.gameObject.name}.");
+					return;
+				}
+
+				var metaData = osc.GetComponent<PickupableMetaDataComponent>();
+				if (metaData != null && metaData.prefabId == msg.prefabId) {
+					GameObject gameObject = osc.gameObject;
+					gameObject.SetActive(msg.active);
+					gameObject.transform.position = Utils.NetVec3ToGame(msg.transform.position);
+					gameObject.transform.rotation = Utils.NetQuatToGame(msg.transform.rotation);
+					return;
+				}
+
+				// Destroy is deferred, release the id right away so the pickupable can be spawned under it.
+				ObjectSyncManager.Instance.RemoveObject(osc);
+				GameObject.Destroy(osc.gameObject);
+			}
+			SpawnPickupable(msg);
+		}
+
 		/// <summary>
 		/// Spawn pickupable from network message.
 		/// </summary>
@@ -766,8 +840,8 @@ namespace MSCMP.Network {
 			Vector3 position = Utils.NetVec3ToGame(msg.transform.position);
 			Quaternion rotation = Utils.NetQuatToGame(msg.transform.rotation);
 
-			if (ObjectSyncManager.Instance.ObjectIDs.ContainsKey(msg.id)) {
-				ObjectSyncComponent osc = ObjectSyncManager.Instance.ObjectIDs[msg.id];
+			ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(msg.id);
+			if (osc != null) {
 				// Ignore spawn requests for items that are already spawned.
 				if (osc.ObjectID == msg.id) {
 					return;
@@ -778,16 +852,12 @@ namespace MSCMP.Network {
 					var metaData = gameObject.GetComponent<PickupableMetaDataComponent>();
 					// Incorrect prefab found.
 					if (msg.prefabId != metaData.prefabId) {
-						bool resolved = false;
-						foreach (var go in ObjectSyncManager.Instance.ObjectIDs) {
-							if (go.Value.gameObject.GetComponent<PickupableMetaDataComponent>().prefabId == msg.prefabId) {
-								gameObject = go.Value.gameObject;
-								Logger.Log("Prefab mismatch was resolved.");
-								resolved = true;
-								break;
-							}
+						ObjectSyncComponent candidate = ObjectSyncManager.Instance.GetAnyPickupableOfPrefab(msg.prefabId);
+						if (candidate != null) {
+							gameObject = candidate.gameObject;
+							Logger.Log("Prefab mismatch was resolved.");
 						}
-						if (!resolved) {
+						else {
 							Client.Assert(true, "Prefab ID mismatch couldn't be resolved!");
 						}
 					}
@@ -818,12 +888,9 @@ namespace MSCMP.Network {
 		/// </summary>
 		/// <param name="id">The object ID of the pickupable to destroy.</param>
 		private void DestroyPickupableLocal(int id) {
-			if (!ObjectSyncManager.Instance.ObjectIDs.ContainsKey(id)) {
-				return;
-			}
-			var gameObject = ObjectSyncManager.Instance.ObjectIDs[id].gameObject;
-			if (gameObject != null) {
-				GameObject.Destroy(gameObject);
+			ObjectSyncComponent osc = ObjectSyncManager.Instance.GetObject(id);
+			if (osc != null) {
+				GameObject.Destroy(osc.gameObject);
 			}
 		}
 
@@ -0,0 +1,170 @@
+using System.IO;
+using MSCMP.Math;
+using UnityEngine;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Decodes object states encoded by the ObjectSnapshotWriter.
+	/// </summary>
+	class ObjectSnapshotReader {
+
+		byte[] data;
+		BinaryReader reader;
+
+		/// <summary>
+		/// Amount of objects left to read.
+		/// </summary>
+		int remaining;
+
+		/// <summary>
+		/// Was the snapshot malformed?
+		/// </summary>
+		public bool Failed {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Object id of the current object.
+		/// </summary>
+		public int ObjectId { get; private set; }
+
+		/// <summary>
+		/// Position of the current object.
+		/// </summary>
+		public Vector3 Position { get; private set; }
+
+		/// <summary>
+		/// Rotation of the current object.
+		/// </summary>
+		public Quaternion Rotation { get; private set; }
+
+		/// <summary>
+		/// Were the velocities of the current object sent? (Zero otherwise)
+		/// </summary>
+		public bool HasVelocity { get; private set; }
+
+		/// <summary>
+		/// Did current object come to rest? (Position and rotation are exact, velocities are zero)
+		/// </summary>
+		public bool AtRest { get; private set; }
+
+		/// <summary>
+		/// Linear velocity of the current object.
+		/// </summary>
+		public Vector3 Velocity { get; private set; }
+
+		/// <summary>
+		/// Angular velocity of the current object.
+		/// </summary>
+		public Vector3 AngularVelocity { get; private set; }
+
+		/// <summary>
+		/// Does current object have synced variables? (See SyncedVariablesOffset and SyncedVariablesLength)
+		/// </summary>
+		public bool HasSyncedVariables { get; private set; }
+
+		/// <summary>
+		/// Buffer containing the encoded synced variables.
+		/// </summary>
+		public byte[] Data {
+			get { return data; }
+		}
+
+		/// <summary>
+		/// Offset of the synced variables of the current object in the Data.
+		/// </summary>
+		public int SyncedVariablesOffset { get; private set; }
+
+		/// <summary>
+		/// Size of the synced variables of the current object in bytes.
+		/// </summary>
+		public int SyncedVariablesLength { get; private set; }
+
+		/// <summary>
+		/// Constructor. Call Next to read the first object.
+		/// </summary>
+		/// <param name="msg">The received snapshot.</param>
+		public ObjectSnapshotReader(Messages.ObjectSnapshotMessage msg) {
+			data = msg.data;
+			reader = new BinaryReader(new MemoryStream(data, false));
+			remaining = msg.objectCount;
+		}
+
+		/// <summary>
+		/// Read state of the next object.
+		/// </summary>
+		/// <returns>false if there are no more objects or the snapshot is malformed. (See Failed)</returns>
+		public bool Next() {
+			if (remaining <= 0 || Failed) {
+				return false;
+			}
+			remaining--;
+
+			try {
+				uint delta = VarInt.ReadUInt(reader);
+				if (delta == 0 || delta > int.MaxValue - ObjectId) {
+					Failed = true;
+					return false;
+				}
+				ObjectId += (int)delta;
+
+				byte flags = reader.ReadByte();
+
+				AtRest = (flags & ObjectSnapshotWriter.FLAG_AT_REST) != 0;
+				if (AtRest) {
+					Position = new Vector3(reader.ReadSingle(), reader.ReadSingle(), reader.ReadSingle());
+					Rotation = new Quaternion(reader.ReadSingle(), reader.ReadSingle(), reader.ReadSingle(), reader.ReadSingle());
+				}
+				else {
+					float x = Quantization.DequantizePosition(ReadUInt24());
+					float y = Quantization.DequantizePosition(ReadUInt24());
+					float z = Quantization.DequantizePosition(ReadUInt24());
+					Position = new Vector3(x, y, z);
+					Rotation = Quantization.DequantizeRotation(reader.ReadUInt32());
+				}
+
+				HasVelocity = (flags & ObjectSnapshotWriter.FLAG_VELOCITY) != 0;
+				if (HasVelocity) {
+					Velocity = new Vector3(
+						Quantization.DequantizeSigned(reader.ReadInt16(), Quantization.VELOCITY_RANGE),
+						Quantization.DequantizeSigned(reader.ReadInt16(), Quantization.VELOCITY_RANGE),
+						Quantization.DequantizeSigned(reader.ReadInt16(), Quantization.VELOCITY_RANGE));
+					AngularVelocity = new Vector3(
+						Quantization.DequantizeSigned(reader.ReadInt16(), Quantization.ANGULAR_VELOCITY_RANGE),
+						Quantization.DequantizeSigned(reader.ReadInt16(), Quantization.ANGULAR_VELOCITY_RANGE),
+						Quantization.DequantizeSigned(reader.ReadInt16(), Quantization.ANGULAR_VELOCITY_RANGE));
+				}
+				else {
+					Velocity = Vector3.zero;
+					AngularVelocity = Vector3.zero;
+				}
+
+				// Variables are decoded by the receiving object, skip them.
+				HasSyncedVariables = (flags & ObjectSnapshotWriter.FLAG_SYNCED_VARIABLES) != 0;
+				if (HasSyncedVariables) {
+					uint length = VarInt.ReadUInt(reader);
+					int offset = (int)reader.BaseStream.Position;
+					if (length > data.Length - offset) {
+						Failed = true;
+						return false;
+					}
+					SyncedVariablesOffset = offset;
+					SyncedVariablesLength = (int)length;
+					reader.BaseStream.Position = offset + length;
+				}
+			}
+			catch (EndOfStreamException) {
+				Failed = true;
+				return false;
+			}
+			return true;
+		}
+
+		int ReadUInt24() {
+			int b0 = reader.ReadByte();
+			int b1 = reader.ReadByte();
+			int b2 = reader.ReadByte();
+			return b0 | (b1 << 8) | (b2 << 16);
+		}
+	}
+}
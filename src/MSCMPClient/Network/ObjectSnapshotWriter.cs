@@ -0,0 +1,171 @@
+using System.IO;
+using MSCMP.Game;
+using MSCMP.Math;
+using UnityEngine;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Encodes states of many synced objects into the single ObjectSnapshotMessage.
+	/// </summary>
+	/// <remarks>
+	/// Objects must be written sorted by the object id. Each entry starts with the difference from the previous
+	/// object id as varint, followed by flags byte, 24 bit quantized position coordinates and smallest three
+	/// rotation. (See Quantization) Velocities are 16 bit per component, synced variables are prefixed by their
+	/// size in bytes as varint so the receiver can skip them. (See SyncedVariables) Entries of objects that came
+	/// to rest carry the exact transform as raw floats and no velocities. Typical entry with velocities takes
+	/// ~27 bytes compared to ~70 bytes of standalone ObjectSyncMessage including the packet header.
+	/// </remarks>
+	class ObjectSnapshotWriter {
+
+		/// <summary>
+		/// Size of the payload after which the snapshot should be sent and new one started.
+		/// </summary>
+		public const int MAX_PAYLOAD_SIZE = 1024;
+
+		/// <summary>
+		/// Entry flag - linear and angular velocity follow the transform.
+		/// </summary>
+		public const byte FLAG_VELOCITY = 1 << 0;
+
+		/// <summary>
+		/// Entry flag - synced variables follow the transform.
+		/// </summary>
+		public const byte FLAG_SYNCED_VARIABLES = 1 << 1;
+
+		/// <summary>
+		/// Entry flag - object came to rest, transform is not quantized.
+		/// </summary>
+		public const byte FLAG_AT_REST = 1 << 2;
+
+		MemoryStream stream = new MemoryStream();
+		BinaryWriter writer;
+
+		/// <summary>
+		/// Synced variables of the current entry. (Their size is written before them)
+		/// </summary>
+		MemoryStream variablesStream = new MemoryStream();
+		BinaryWriter variablesWriter;
+
+		/// <summary>
+		/// Id of the last written object.
+		/// </summary>
+		int lastObjectId = 0;
+
+		/// <summary>
+		/// Amount of objects written since the last reset.
+		/// </summary>
+		public int Count {
+			get; private set;
+		}
+
+		/// <summary>
+		/// Size of the encoded payload in bytes.
+		/// </summary>
+		public int Length {
+			get { return (int)stream.Length; }
+		}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		public ObjectSnapshotWriter() {
+			writer = new BinaryWriter(stream);
+			variablesWriter = new BinaryWriter(variablesStream);
+		}
+
+		/// <summary>
+		/// Start new snapshot.
+		/// </summary>
+		public void Reset() {
+			stream.SetLength(0);
+			lastObjectId = 0;
+			Count = 0;
+		}
+
+		/// <summary>
+		/// Write state of the object.
+		/// </summary>
+		/// <param name="objectId">The object id. (Must be greater than id of the previously written object)</param>
+		/// <param name="position">The object's position.</param>
+		/// <param name="rotation">The object's rotation.</param>
+		/// <param name="hasVelocity">Should the velocities be written?</param>
+		/// <param name="velocity">The object's linear velocity.</param>
+		/// <param name="angularVelocity">The object's angular velocity.</param>
+		/// <param name="syncedVariables">Synced variables of the object. (can be null)</param>
+		/// <param name="allVariables">Write all synced variables, not only the changed ones.</param>
+		/// <param name="atRest">Is this the final state of the object that came to rest?</param>
+		public void Write(int objectId, Vector3 position, Quaternion rotation, bool hasVelocity, Vector3 velocity, Vector3 angularVelocity, SyncedVariables syncedVariables, bool allVariables, bool atRest) {
+			Client.Assert(objectId > lastObjectId, $"Snapshot objects must be sorted by id. ({objectId} written after {lastObjectId})");
+
+			VarInt.WriteUInt(writer, (uint)(objectId - lastObjectId));
+			lastObjectId = objectId;
+
+			byte flags = 0;
+			if (atRest) {
+				flags |= FLAG_AT_REST;
+				hasVelocity = false;
+			}
+			if (hasVelocity) {
+				flags |= FLAG_VELOCITY;
+			}
+			bool writeVariables = syncedVariables != null && (allVariables || syncedVariables.HasChanges);
+			if (writeVariables) {
+				flags |= FLAG_SYNCED_VARIABLES;
+			}
+			writer.Write(flags);
+
+			if (atRest) {
+				// Receiver puts the object to sleep at this transform, quantization error would stay visible.
+				writer.Write(position.x);
+				writer.Write(position.y);
+				writer.Write(position.z);
+				writer.Write(rotation.x);
+				writer.Write(rotation.y);
+				writer.Write(rotation.z);
+				writer.Write(rotation.w);
+			}
+			else {
+				WriteUInt24(Quantization.QuantizePosition(position.x));
+				WriteUInt24(Quantization.QuantizePosition(position.y));
+				WriteUInt24(Quantization.QuantizePosition(position.z));
+				writer.Write(Quantization.QuantizeRotation(rotation));
+			}
+
+			if (hasVelocity) {
+				writer.Write(Quantization.QuantizeSigned(velocity.x, Quantization.VELOCITY_RANGE));
+				writer.Write(Quantization.QuantizeSigned(velocity.y, Quantization.VELOCITY_RANGE));
+				writer.Write(Quantization.QuantizeSigned(velocity.z, Quantization.VELOCITY_RANGE));
+				writer.Write(Quantization.QuantizeSigned(angularVelocity.x, Quantization.ANGULAR_VELOCITY_RANGE));
+				writer.Write(Quantization.QuantizeSigned(angularVelocity.y, Quantization.ANGULAR_VELOCITY_RANGE));
+				writer.Write(Quantization.QuantizeSigned(angularVelocity.z, Quantization.ANGULAR_VELOCITY_RANGE));
+			}
+
+			if (writeVariables) {
+				// Size of the variables is not known until they are written.
+				variablesStream.SetLength(0);
+				syncedVariables.Write(variablesWriter, allVariables);
+				variablesWriter.Flush();
+				VarInt.WriteUInt(writer, (uint)variablesStream.Length);
+				writer.Write(variablesStream.GetBuffer(), 0, (int)variablesStream.Length);
+			}
+
+			Count++;
+		}
+
+		/// <summary>
+		/// Fill the message with the written snapshot.
+		/// </summary>
+		/// <param name="msg">The message to fill.</param>
+		public void WriteTo(Messages.ObjectSnapshotMessage msg) {
+			writer.Flush();
+			msg.objectCount = Count;
+			msg.data = stream.ToArray();
+		}
+
+		void WriteUInt24(int value) {
+			writer.Write((byte)value);
+			writer.Write((byte)(value >> 8));
+			writer.Write((byte)(value >> 16));
+		}
+	}
+}
@@ -0,0 +1,232 @@
+using HutongGames.PlayMaker;
+using UnityEngine;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Game state of the local player read by the animation synchronization.
+	/// </summary>
+	/// <remarks>
+	/// The FSMs, their variables and the transforms are looked up once when bound to the player object and are
+	/// only looked up again when the player object changes or the bound FSMs were destroyed with it. Reading the
+	/// state is then just a few field reads instead of the component searches and hierarchy walks. If the player
+	/// object is not fully set up yet, resolving is retried every RESOLVE_RETRY_INTERVAL seconds.
+	/// </remarks>
+	class PlayerAnimBindings {
+
+		const string FPS_CAMERA_PATH = "Pivot/Camera/FPSCamera";
+		const string HAND_HANDLE_PATH = "Pivot/Camera/FPSCamera/FPSCamera";
+		const string DRINK_HAND_PATH = "Pivot/Camera/FPSCamera/FPSCamera/Drink/Hand";
+
+		/// <summary>
+		/// Time in seconds between the attempts to resolve the bindings that failed.
+		/// </summary>
+		const float RESOLVE_RETRY_INTERVAL = 1.0f;
+
+		/// <summary>
+		/// Player object the bindings were resolved for.
+		/// </summary>
+		GameObject boundObject = null;
+
+		/// <summary>
+		/// Were all bindings resolved?
+		/// </summary>
+		bool valid = false;
+
+		/// <summary>
+		/// Time of the next attempt to resolve the bindings if they are not valid.
+		/// </summary>
+		float nextResolveTime = 0.0f;
+
+		CharacterMotor motor = null;
+		PlayMakerFSM runningFsm = null;
+		PlayMakerFSM speechFsm = null;
+		FsmFloat leanPosition = null;
+		FsmFloat crouchPosition = null;
+		FsmFloat drunkYMax = null;
+		FsmInt fingerRandomInt = null;
+		FsmInt speechRandomInt = null;
+		Transform aimTransform = null;
+		GameObject[] handStateObjects = null;
+		GameObject[] drinkObjects = null;
+
+		/// <summary>
+		/// Character motor of the player. (Destroyed when the player is dying)
+		/// </summary>
+		public CharacterMotor Motor {
+			get { return motor; }
+		}
+
+		public PlayMakerFSM RunningFsm {
+			get { return runningFsm; }
+		}
+
+		public PlayMakerFSM SpeechFsm {
+			get { return speechFsm; }
+		}
+
+		/// <summary>
+		/// Lean position of the "Reach" FSM.
+		/// </summary>
+		public FsmFloat LeanPosition {
+			get { return leanPosition; }
+		}
+
+		/// <summary>
+		/// Position of the "Crouch" FSM.
+		/// </summary>
+		public FsmFloat CrouchPosition {
+			get { return crouchPosition; }
+		}
+
+		/// <summary>
+		/// Camera shake of the "Drunk Mode" FSM.
+		/// </summary>
+		public FsmFloat DrunkYMax {
+			get { return drunkYMax; }
+		}
+
+		/// <summary>
+		/// Random swear of the middle finger gesture. ("PlayerFunctions" FSM)
+		/// </summary>
+		public FsmInt FingerRandomInt {
+			get { return fingerRandomInt; }
+		}
+
+		/// <summary>
+		/// Random sentence of the "Speech" FSM.
+		/// </summary>
+		public FsmInt SpeechRandomInt {
+			get { return speechRandomInt; }
+		}
+
+		/// <summary>
+		/// Transform of the first person camera. (Its pitch is the aim rotation)
+		/// </summary>
+		public Transform AimTransform {
+			get { return aimTransform; }
+		}
+
+		/// <summary>
+		/// Drink objects held in the hand indexed by the drink id. (See PlayerAnimManager.DrinkObjectNames)
+		/// </summary>
+		public GameObject[] DrinkObjects {
+			get { return drinkObjects; }
+		}
+
+		/// <summary>
+		/// Bind to the player object. Bindings are resolved only if the object differs from the bound one.
+		/// </summary>
+		/// <param name="playerObject">The player object.</param>
+		/// <returns>true if the bindings are valid and the player is alive, false otherwise.</returns>
+		public bool Bind(GameObject playerObject) {
+			// Destroyed Unity objects compare equal to null.
+			if (boundObject != playerObject || (valid && runningFsm == null) || (!valid && Time.time >= nextResolveTime)) {
+				Resolve(playerObject);
+			}
+			if (!valid) {
+				return false;
+			}
+			if (motor == null) {
+				// Motor is removed when the player is dying, it may be added again.
+				motor = playerObject.GetComponentInChildren<CharacterMotor>();
+			}
+			return motor != null;
+		}
+
+		/// <summary>
+		/// Get the active hand state.
+		/// </summary>
+		/// <returns>The ID of the active state or else 255 if none.</returns>
+		public byte GetActiveHandState() {
+			for (byte i = 0; i < handStateObjects.Length; i++) {
+				if (handStateObjects[i].activeInHierarchy) return i;
+			}
+			return 255;
+		}
+
+		/// <summary>
+		/// Get the drink the player is using.
+		/// </summary>
+		/// <returns>255 if player is not drinking, or else its ID</returns>
+		public byte GetDrinkingObject() {
+			for (byte i = 0; i < drinkObjects.Length; i++) {
+				if (drinkObjects[i].activeInHierarchy) return i;
+			}
+			return 255;
+		}
+
+		/// <summary>
+		/// Look up all bindings of the player object.
+		/// </summary>
+		/// <param name="playerObject">The player object.</param>
+		void Resolve(GameObject playerObject) {
+			// Report the failure only once per player object, retries are expected to fail until it is set up.
+			bool retry = boundObject == playerObject && !valid;
+			boundObject = playerObject;
+			valid = false;
+			nextResolveTime = Time.time + RESOLVE_RETRY_INTERVAL;
+
+			// Single search for all FSMs of the player instead of one per FSM.
+			PlayMakerFSM reachFsm = null;
+			PlayMakerFSM crouchFsm = null;
+			PlayMakerFSM functionsFsm = null;
+			PlayMakerFSM drunkFsm = null;
+			runningFsm = null;
+			speechFsm = null;
+			foreach (PlayMakerFSM fsm in playerObject.GetComponentsInChildren<PlayMakerFSM>()) {
+				switch (fsm.FsmName) {
+					case "Running": if (runningFsm == null) runningFsm = fsm; break;
+					case "Reach": if (reachFsm == null) reachFsm = fsm; break;
+					case "Crouch": if (crouchFsm == null) crouchFsm = fsm; break;
+					case "PlayerFunctions": if (functionsFsm == null) functionsFsm = fsm; break;
+					case "Speech": if (speechFsm == null) speechFsm = fsm; break;
+				}
+			}
+
+			aimTransform = playerObject.transform.FindChild(FPS_CAMERA_PATH);
+			Transform handHandle = playerObject.transform.FindChild(HAND_HANDLE_PATH);
+			Transform drinkHand = playerObject.transform.FindChild(DRINK_HAND_PATH);
+			if (handHandle != null) {
+				drunkFsm = Utils.GetPlaymakerScriptByName(handHandle.gameObject, "Drunk Mode");
+			}
+
+			if (runningFsm == null || reachFsm == null || crouchFsm == null || functionsFsm == null || speechFsm == null || drunkFsm == null ||
+				aimTransform == null || handHandle == null || drinkHand == null) {
+				if (!retry) Logger.Error($"Failed to bind animation state of the player object '{playerObject.name}'.");
+				return;
+			}
+
+			leanPosition = reachFsm.Fsm.GetFsmFloat("Position");
+			crouchPosition = crouchFsm.Fsm.GetFsmFloat("Position");
+			drunkYMax = drunkFsm.Fsm.GetFsmFloat("DrunkYmax");
+			fingerRandomInt = functionsFsm.Fsm.GetFsmInt("RandomInt");
+			speechRandomInt = speechFsm.Fsm.GetFsmInt("RandomInt");
+
+			handStateObjects = FindChildren(handHandle, PlayerAnimManager.HandStateNames);
+			drinkObjects = FindChildren(drinkHand, PlayerAnimManager.DrinkObjectNames);
+			if (handStateObjects == null || drinkObjects == null) {
+				if (!retry) Logger.Error($"Failed to bind hand objects of the player object '{playerObject.name}'.");
+				return;
+			}
+
+			motor = playerObject.GetComponentInChildren<CharacterMotor>();
+			valid = true;
+		}
+
+		/// <summary>
+		/// Find the children by name.
+		/// </summary>
+		/// <returns>The children in the order of the names or null if any is missing.</returns>
+		static GameObject[] FindChildren(Transform parent, string[] names) {
+			var children = new GameObject[names.Length];
+			for (int i = 0; i < names.Length; i++) {
+				Transform child = parent.FindChild(names[i]);
+				if (child == null) {
+					return null;
+				}
+				children[i] = child.gameObject;
+			}
+			return children;
+		}
+	}
+}
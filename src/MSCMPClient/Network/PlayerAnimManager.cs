@@ -1,41 +1,38 @@
-using System.Collections.Generic;
 using UnityEngine;
 
 namespace MSCMP.Network {
 	/// <summary>
-	/// Class managing the animations of the player.
+	/// Class managing the animations of the player character.
 	/// </summary>
+	/// <remarks>
+	/// Every character has its own instance. Animation states of the character are resolved once in the
+	/// SetupAnimations from the animation table, the action animations are driven by the action table - each row
+	/// is one bit of the active actions mask and only the rows whose bit changed are started or stopped.
+	/// </remarks>
 	class PlayerAnimManager {
-		public static PlayerAnimManager Instance = null;
 
-		public PlayerAnimManager() {
-			Instance = this;
-		}
-
-		~PlayerAnimManager() {
-			Instance = null;
-		}
-
-		static List<AnimState> states = new List<AnimState>();
-
-		static GameObject characterGameObject = null;
-		static Animation characterAnimationComponent = null;
+		/// <summary>
+		/// The game object and the animation component of the character.
+		/// </summary>
+		GameObject characterGameObject = null;
+		Animation characterAnimationComponent = null;
 
 		/// <summary>
-		/// Currently played animation id.
+		/// Animation states of the character indexed by the animation id.
 		/// </summary>
-		public AnimationId currentAnim = AnimationId.Standing;
-		public AnimationState activeAnimationState = null;
+		AnimationState[] animationStates = null;
 
 		/// <summary>
-		/// The amount of movement packets needed left to send animation sync packet
+		/// Bones the drink and the head look are applied to.
 		/// </summary>
-		public int PACKETS_LEFT_TO_SYNC = 0;
+		Transform headTransform = null;
+		Transform fingersTransform = null;
 
 		/// <summary>
-		/// The total amount of movement packets we need
+		/// Currently played animation id.
 		/// </summary>
-		public int PACKETS_TOTAL_FOR_SYNC = 2;
+		public AnimationId currentAnim = AnimationId.Standing;
+		public AnimationState activeAnimationState = null;
 
 		#region Animations
 		/// <summary>
@@ -59,22 +56,40 @@ namespace MSCMP.Network {
 			Drinking
 		}
 
-		private string[] AnimationNames = new string[] {
-			"Walk",
-			"Idle",
-			"Jump",
-			"Drunk",
-			"Lean",
-			"Finger",
-			"Hitchhike",
-			"Crouch",
-			"CrouchLow",
-			"CrouchWalk",
-			"CrouchLowWalk",
-			"Run",
-			"Hit",
-			"Push",
-			"Drink"
+		/// <summary>
+		/// Animation of the character model.
+		/// </summary>
+		struct AnimationDesc {
+			public readonly string name;
+			public readonly int layer;
+			public readonly bool additive;
+
+			public AnimationDesc(string name, int layer, bool additive) {
+				this.name = name;
+				this.layer = layer;
+				this.additive = additive;
+			}
+		}
+
+		/// <summary>
+		/// The animations indexed by the animation id.
+		/// </summary>
+		static readonly AnimationDesc[] Animations = new AnimationDesc[] {
+			new AnimationDesc("Walk", 0, false),
+			new AnimationDesc("Idle", 0, false),
+			new AnimationDesc("Jump", 1, false),
+			new AnimationDesc("Drunk", 2, true),
+			new AnimationDesc("Lean", 3, true),
+			new AnimationDesc("Finger", 3, true),
+			new AnimationDesc("Hitchhike", 3, true),
+			new AnimationDesc("Crouch", 0, false),
+			new AnimationDesc("CrouchLow", 0, false),
+			new AnimationDesc("CrouchWalk", 0, false),
+			new AnimationDesc("CrouchLowWalk", 0, false),
+			new AnimationDesc("Run", 0, false),
+			new AnimationDesc("Hit", 3, true),
+			new AnimationDesc("Push", 3, true),
+			new AnimationDesc("Drink", 3, true)
 		};
 
 		/// <summary>
@@ -82,8 +97,8 @@ namespace MSCMP.Network {
 		/// </summary>
 		/// <param name="animation">The id of the animation.</param>
 		/// <returns>Name of the animation.</returns>
-		private string GetAnimationName(AnimationId animation) {
-			return AnimationNames[(int)animation];
+		private static string GetAnimationName(AnimationId animation) {
+			return Animations[(int)animation].name;
 		}
 		#endregion
 		#region Stances (Stand/Crouch/Crouch Low)
@@ -129,7 +144,7 @@ namespace MSCMP.Network {
 		/// <summary>
 		/// The hand state GameObject names.
 		/// </summary>
-		private string[] HandStateNames = new string[] {
+		public static readonly string[] HandStateNames = new string[] {
 			"MiddleFinger",
 			"Lift",
 			"Fist",
@@ -142,36 +157,115 @@ namespace MSCMP.Network {
 		/// </summary>
 		/// <param name="handState">The id of the hand state.</param>
 		/// <returns>Name of the hand state.</returns>
-		public HandStateId GetHandState(byte handState) {
+		public static HandStateId GetHandState(byte handState) {
 			return (HandStateId)handState;
 		}
 
+		#endregion
+		#region Actions
+		/// <summary>
+		/// How the action animation is played.
+		/// </summary>
+		enum ActionKind {
+			/// <summary>
+			/// Played forward when started and backward when stopped. (See PlayActionAnim)
+			/// </summary>
+			Action,
+
+			/// <summary>
+			/// Cross faded on its layer when started and blended out when stopped.
+			/// </summary>
+			Overlay
+		}
+
+		/// <summary>
+		/// Condition of the animation state activating the action.
+		/// </summary>
+		enum ActionCondition {
+			Leaning,
+			InAir,
+			Drunk,
+			HandState
+		}
+
+		/// <summary>
+		/// Row of the action table.
+		/// </summary>
+		struct ActionDesc {
+			public readonly AnimationId animation;
+			public readonly ActionKind kind;
+			public readonly ActionCondition condition;
+			public readonly HandStateId handState;
+
+			public ActionDesc(AnimationId animation, ActionKind kind, ActionCondition condition, HandStateId handState = HandStateId.MiddleFingering) {
+				this.animation = animation;
+				this.kind = kind;
+				this.condition = condition;
+				this.handState = handState;
+			}
+
+			public bool IsActive(PlayerAnimState animState) {
+				switch (condition) {
+					case ActionCondition.Leaning: return animState.isLeaning;
+					case ActionCondition.InAir: return !animState.isGrounded;
+					case ActionCondition.Drunk: return animState.isDrunk;
+					default: return animState.activeHandState == (byte)handState;
+				}
+			}
+		}
+
 		/// <summary>
-		/// Gets the active hand state of the gameObject
+		/// The action table. (Row index is the bit of the active actions mask)
 		/// </summary>
-		/// <param name="gameObject">The object to get it from.</param>
-		/// <returns>The ID of the active state or else 255 if none.</returns>
-		public byte GetActiveHandState(GameObject gameObject) {
-			GameObject HandHandleObject = gameObject.transform.FindChild("Pivot/Camera/FPSCamera/FPSCamera").gameObject;
+		static readonly ActionDesc[] Actions = new ActionDesc[] {
+			new ActionDesc(AnimationId.Leaning, ActionKind.Action, ActionCondition.Leaning),
+			new ActionDesc(AnimationId.Jumping, ActionKind.Overlay, ActionCondition.InAir),
+			new ActionDesc(AnimationId.Finger, ActionKind.Action, ActionCondition.HandState, HandStateId.MiddleFingering),
+			new ActionDesc(AnimationId.Hitchhike, ActionKind.Action, ActionCondition.HandState, HandStateId.Lifting),
+			new ActionDesc(AnimationId.Drunk, ActionKind.Overlay, ActionCondition.Drunk),
+			new ActionDesc(AnimationId.Hitting, ActionKind.Action, ActionCondition.HandState, HandStateId.Hitting),
+			new ActionDesc(AnimationId.Pushing, ActionKind.Action, ActionCondition.HandState, HandStateId.Pushing)
+		};
 
-			for (byte i = 0; i < HandStateNames.Length; i++) {
-				string HandStateName = HandStateNames[i];
-				GameObject HandStateObject = HandHandleObject.transform.FindChild(HandStateName).gameObject;
+		/// <summary>
+		/// Mask of the currently active rows of the action table.
+		/// </summary>
+		int activeActions = 0;
 
-				if (HandStateObject.activeInHierarchy) return i;
+		/// <summary>
+		/// Start or stop the actions whose condition changed.
+		/// </summary>
+		/// <param name="animState">Received animation state.</param>
+		private void UpdateActions(PlayerAnimState animState) {
+			int active = 0;
+			for (int i = 0; i < Actions.Length; i++) {
+				if (Actions[i].IsActive(animState)) active |= 1 << i;
 			}
 
-			return 255;
+			int changed = active ^ activeActions;
+			activeActions = active;
+			for (int i = 0; changed != 0; i++, changed >>= 1) {
+				if ((changed & 1) == 0) continue;
+
+				ActionDesc action = Actions[i];
+				bool start = (active & (1 << i)) != 0;
+				if (action.kind == ActionKind.Action) PlayActionAnim(action.animation, start);
+				else if (start) PlayAnimation(action.animation, false, false);
+				else BlendOutAnimation(action.animation);
+			}
 		}
 		#endregion
 		#region Drink States
-		static List<GameObject> Drinks = new List<GameObject>();
+		/// <summary>
+		/// Drink objects of the local player indexed by the drink id, instantiated into the hands of the characters.
+		/// </summary>
+		static GameObject[] drinkTemplates = null;
 		GameObject ourDrinkObject = null;
 
 		/// <summary>
 		/// The drink GameObject names.
 		/// </summary>
-		private string[] DrinkObjectNames = new string[] {
+		public static readonly string[] DrinkObjectNames = new string[] {
 			"HandJuice",
 			"HandMilk",
 			"HandSpray",
@@ -183,7 +277,7 @@ namespace MSCMP.Network {
 			"MilkGlass"
 		};
 
-		private float[,] DrinkOffsets = new float[,] {
+		private static readonly float[,] DrinkOffsets = new float[,] {
 			{ -0.008f, -0.016f, 0.005f },
 			{ -0.025f, -0.02f, 0.015f },
 			{ -0.01f, 0.0f, 0.01f },
@@ -195,7 +289,7 @@ namespace MSCMP.Network {
 			{ -0.02f, 0.005f, 0.012f }
 		};
 
-		private float[,] DrinkRotations = new float[,] {
+		private static readonly float[,] DrinkRotations = new float[,] {
 			{ 5, 140, 295 },
 			{ 5, 140, 295 },
 			{ 350, 190, 210 },
@@ -207,45 +301,22 @@ namespace MSCMP.Network {
 			{ 310, 150, 273 }
 		};
 
-		public bool AreDrinksPreloaded() { return Drinks.Count != 0; }
+		public static bool AreDrinksPreloaded() { return drinkTemplates != null; }
 
 		/// <summary>
 		/// Preloads the drink game objects of the game player to use them later while drinking
 		/// </summary>
-		/// <param name="character">The player object to get the drink objects from</param>
-		public void PreloadDrinkObjects(GameObject character) {
-			GameObject HandHandleObject = character.transform.FindChild("Pivot/Camera/FPSCamera/FPSCamera/Drink/Hand").gameObject;
-
-			for (byte i = 0; i < DrinkObjectNames.Length; i++) {
-				GameObject DrinkObject = HandHandleObject.transform.FindChild(DrinkObjectNames[i]).gameObject;
-				Client.Assert(DrinkObject, "Unable to find drink object - " + DrinkObjectNames[i]);
-				Drinks.Add(DrinkObject);
-			}
-		}
-
-		/// <summary>
-		/// Gets the drink game object player is using
-		/// </summary>
-		/// <param name="character">The player object to get the drink object from</param>
-		/// <returns>255 if player is not drinking, or else its ID</returns>
-		public byte GetDrinkingObject(GameObject character) {
-			GameObject HandHandleObject = character.transform.FindChild("Pivot/Camera/FPSCamera/FPSCamera/Drink/Hand").gameObject;
-
-			for (byte i = 0; i < DrinkObjectNames.Length; i++) {
-				GameObject DrinkObject = HandHandleObject.transform.FindChild(DrinkObjectNames[i]).gameObject;
-				if (DrinkObject.activeInHierarchy) return i;
-			}
-
-			return 255;
+		/// <param name="drinkObjects">The drink objects of the player (See PlayerAnimBindings.DrinkObjects)</param>
+		public static void PreloadDrinkObjects(GameObject[] drinkObjects) {
+			drinkTemplates = drinkObjects;
 		}
 
 		/// <summary>
 		/// Sets the drinking object for the specific player
 		/// </summary>
-		/// <param name="character">The player object to set the drink object</param>
-		/// /// <param name="drinkingObjectId">The id of the drink object</param>
+		/// <param name="drinkingObjectId">The id of the drink object</param>
 		public void SetDrinkingObject(byte drinkingObjectId) {
-			if (drinkingObjectId == 255) {
+			if (drinkingObjectId == PlayerAnimState.NONE) {
 				PlayActionAnim(AnimationId.Drinking, false);
 
 				if (ourDrinkObject != null) {
@@ -255,20 +326,16 @@ namespace MSCMP.Network {
 				return;
 			}
 
-			string drinkObjectName = DrinkObjectNames[(int)drinkingObjectId];
-
-			GameObject ourDrinkObjectToSpawn = null;
-			foreach (GameObject drink in Drinks) {
-				if (drink.name == drinkObjectName) ourDrinkObjectToSpawn = drink;
+			if (drinkTemplates == null || drinkingObjectId >= drinkTemplates.Length || drinkTemplates[drinkingObjectId] == null) {
+				Logger.Error($"Drink object {drinkingObjectId} is not loaded.");
+				return;
 			}
 
 			if (ourDrinkObject != null) GameObject.DestroyObject(ourDrinkObject);
-			ourDrinkObject = GameObject.Instantiate(ourDrinkObjectToSpawn);
+			ourDrinkObject = GameObject.Instantiate(drinkTemplates[drinkingObjectId]);
 
 			ourDrinkObject.SetActive(true);
-
-			Transform playerFingers = characterGameObject.transform.FindChild("pelvis/spine_mid/shoulders/collar_left/shoulder(leftx)/arm(leftx)/hand_left/finger_left");
-			ourDrinkObject.transform.SetParent(playerFingers);
+			ourDrinkObject.transform.SetParent(fingersTransform);
 
 			ourDrinkObject.transform.localPosition = new Vector3(DrinkOffsets[drinkingObjectId, 0], DrinkOffsets[drinkingObjectId, 1], DrinkOffsets[drinkingObjectId, 2]);
 			ourDrinkObject.transform.localEulerAngles = new Vector3(DrinkRotations[drinkingObjectId, 0], DrinkRotations[drinkingObjectId, 1], DrinkRotations[drinkingObjectId, 2]);
@@ -290,30 +357,24 @@ namespace MSCMP.Network {
 		#endregion
 
 		/// <summary>
-		/// Sets up the animation component and the layers for each animation. Also registers the animation states.
+		/// Sets up the animation component and the layers for each animation.
 		/// </summary>
-		/// <param name="animComponent">The animation component of the player.</param>
+		/// <param name="character">The character game object.</param>
 		public void SetupAnimations(GameObject character) {
 			characterGameObject = character;
 			characterAnimationComponent = characterGameObject.GetComponentInChildren<Animation>();
-
-			characterAnimationComponent["Jump"].layer = 1;
-			characterAnimationComponent["Drunk"].layer = 2;
-			characterAnimationComponent["Drunk"].blendMode = AnimationBlendMode.Additive;
-			characterAnimationComponent["Lean"].layer = 3;
-			characterAnimationComponent["Lean"].blendMode = AnimationBlendMode.Additive;
-			characterAnimationComponent["Finger"].layer = 3;
-			characterAnimationComponent["Finger"].blendMode = AnimationBlendMode.Additive;
-			characterAnimationComponent["Hitchhike"].layer = 3;
-			characterAnimationComponent["Hitchhike"].blendMode = AnimationBlendMode.Additive;
-			characterAnimationComponent["Hit"].layer = 3;
-			characterAnimationComponent["Hit"].blendMode = AnimationBlendMode.Additive;
-			characterAnimationComponent["Push"].layer = 3;
-			characterAnimationComponent["Push"].blendMode = AnimationBlendMode.Additive;
-			characterAnimationComponent["Drink"].layer = 3;
-			characterAnimationComponent["Drink"].blendMode = AnimationBlendMode.Additive;
-
-			RegisterAnimStates();
+			headTransform = character.transform.FindChild("pelvis/spine_mid/shoulders/head");
+			fingersTransform = character.transform.FindChild("pelvis/spine_mid/shoulders/collar_left/shoulder(leftx)/arm(leftx)/hand_left/finger_left");
+
+			animationStates = new AnimationState[Animations.Length];
+			for (int i = 0; i < Animations.Length; i++) {
+				AnimationState state = characterAnimationComponent[Animations[i].name];
+				Client.Assert(state != null, "Unable to find character animation - " + Animations[i].name);
+				if (Animations[i].layer != 0) state.layer = Animations[i].layer;
+				if (Animations[i].additive) state.blendMode = AnimationBlendMode.Additive;
+				animationStates[i] = state;
+			}
+			activeActions = 0;
 		}
 
 		/// <summary>
@@ -333,7 +394,7 @@ namespace MSCMP.Network {
 
 			if (mainLayer) {
 				currentAnim = animation;
-				activeAnimationState = characterAnimationComponent[animName];
+				activeAnimationState = animationStates[(int)animation];
 			}
 		}
 
@@ -349,151 +410,109 @@ namespace MSCMP.Network {
 		/// <summary>
 		/// Plays an Action Animation from start to end, or the opposite
 		/// </summary>
-		/// <param name="animName">The name of the animation</param>
+		/// <param name="animation">The id of the animation</param>
 		/// <param name="play">Start or Stop the animation</param>
 		private void PlayActionAnim(AnimationId animation, bool play) {
 			if (characterAnimationComponent == null) return;
-			string animName = GetAnimationName(animation);
+			AnimationState state = animationStates[(int)animation];
 
 			if (play) {
-				characterAnimationComponent[animName].wrapMode = WrapMode.ClampForever;
-				characterAnimationComponent[animName].speed = 1;
-				characterAnimationComponent[animName].enabled = true;
-				characterAnimationComponent[animName].weight = 1.0f;
+				state.wrapMode = WrapMode.ClampForever;
+				state.speed = 1;
+				state.enabled = true;
+				state.weight = 1.0f;
 			}
 			else {
-				characterAnimationComponent[animName].wrapMode = WrapMode.Once;
-				if (characterAnimationComponent[animName].time > characterAnimationComponent[animName].length) {
-					characterAnimationComponent[animName].time = characterAnimationComponent[animName].length;
+				state.wrapMode = WrapMode.Once;
+				if (state.time > state.length) {
+					state.time = state.length;
 				}
-				characterAnimationComponent[animName].speed = -1;
-				characterAnimationComponent[animName].weight = 1.0f;
+				state.speed = -1;
+				state.weight = 1.0f;
 			}
 		}
 
 		/// <summary>
-		/// Check if an animation has been blended with 0 weight and disables it
+		/// Check if an overlay animation has been blended with 0 weight and disables it
 		/// </summary>
 		public void CheckBlendedOutAnimationStates() {
 			if (characterAnimationComponent == null) return;
 
-			if (characterAnimationComponent["Jump"].time != 0.0f && characterAnimationComponent["Jump"].weight == 0.0f) {
-				characterAnimationComponent["Jump"].enabled = false;
-				characterAnimationComponent["Jump"].time = 0;
-			}
+			for (int i = 0; i < Actions.Length; i++) {
+				if (Actions[i].kind != ActionKind.Overlay) continue;
 
-			if (characterAnimationComponent["Drunk"].time != 0.0f && characterAnimationComponent["Drunk"].weight == 0.0f) {
-				characterAnimationComponent["Drunk"].enabled = false;
-				characterAnimationComponent["Drunk"].time = 0;
+				AnimationState state = animationStates[(int)Actions[i].animation];
+				if (state.time != 0.0f && state.weight == 0.0f) {
+					state.enabled = false;
+					state.time = 0;
+				}
 			}
 		}
 
-		private class AnimState : PlayerAnimManager {
-			bool isActive = false;
-
-			public virtual bool CanActivate(Messages.AnimSyncMessage msg) {
-				// condition if this state can be activated (must also return true if state is active)
-				return false;
-			}
-
-			public virtual void Activate() {
-				// start anim here
-			}
-
-			public virtual void Deactivate() {
-				// stop anim here
+		/// <summary>
+		/// Value received with the animation state, interpolated from the previous one over the time between them.
+		/// </summary>
+		struct InterpolatedValue {
+			float from;
+			float to;
+			float startTime;
+			float duration;
+
+			public void Set(float value, float time, float duration) {
+				from = Evaluate(time);
+				to = value;
+				startTime = time;
+				this.duration = duration;
 			}
 
-			public void TryActivate(Messages.AnimSyncMessage msg) {
-				bool canActivate = CanActivate(msg);
-				if (!isActive && canActivate) {
-					Activate();
-					isActive = true;
-				}
-				else if (isActive && !canActivate) {
-					Deactivate();
-					isActive = false;
+			public float Evaluate(float time) {
+				if (duration <= 0.0f) {
+					return to;
 				}
+				return Mathf.Lerp(from, to, (time - startTime) / duration);
 			}
 		}
 
-		private class LeaningState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return msg.isLeaning; }
-			public override void Activate() { PlayActionAnim(AnimationId.Leaning, true); }
-			public override void Deactivate() { PlayActionAnim(AnimationId.Leaning, false); }
-		}
-
-		private class JumpState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return !msg.isGrounded; }
-			public override void Activate() { PlayAnimation(AnimationId.Jumping, false, false); }
-			public override void Deactivate() { BlendOutAnimation(AnimationId.Jumping); }
-		}
-
-		private class FingerState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return GetHandState(msg.activeHandState) == HandStateId.MiddleFingering; }
-			public override void Activate() { PlayActionAnim(AnimationId.Finger, true); }
-			public override void Deactivate() { PlayActionAnim(AnimationId.Finger, false); }
-		}
-
-		private class HitchhikeState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return GetHandState(msg.activeHandState) == HandStateId.Lifting; }
-			public override void Activate() { PlayActionAnim(AnimationId.Hitchhike, true); }
-			public override void Deactivate() { PlayActionAnim(AnimationId.Hitchhike, false); }
-		}
-
-		private class DrunkState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return msg.isDrunk; }
-			public override void Activate() { PlayAnimation(AnimationId.Drunk, false, false); }
-			public override void Deactivate() { BlendOutAnimation(AnimationId.Drunk); }
-		}
-
-		private class HitState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return GetHandState(msg.activeHandState) == HandStateId.Hitting; }
-			public override void Activate() { PlayActionAnim(AnimationId.Hitting, true); }
-			public override void Deactivate() { PlayActionAnim(AnimationId.Hitting, false); }
-		}
-
-		private class PushState : AnimState {
-			public override bool CanActivate(Messages.AnimSyncMessage msg) { return GetHandState(msg.activeHandState) == HandStateId.Pushing; }
-			public override void Activate() { PlayActionAnim(AnimationId.Pushing, true); }
-			public override void Deactivate() { PlayActionAnim(AnimationId.Pushing, false); }
-		}
-
-		private static void RegisterAnimStates() {
-			states.Add(new LeaningState());
-			states.Add(new JumpState());
-			states.Add(new FingerState());
-			states.Add(new HitchhikeState());
-			states.Add(new DrunkState());
-			states.Add(new HitState());
-			states.Add(new PushState());
-		}
+		/// <summary>
+		/// Longest interpolation of the continuous values in seconds. (Interval of their updates)
+		/// </summary>
+		const float MAX_INTERPOLATION_TIME = NetLocalPlayer.ANIM_SYNC_CONTINUOUS_INTERVAL / 1000.0f;
 
 		//Animation Variables
 		bool isRunning = false;
-		float aimRot = 0.0f;
+		InterpolatedValue aimRot;
+		InterpolatedValue crouchPosition;
+		float lastAnimationsTime = -1.0f;
 		StanceId currentStance = StanceId.Standing;
-		byte currentDrinkId = 255;
+		byte currentDrinkId = PlayerAnimState.NONE;
 
 		/// <summary>
 		/// Handles the Action Animations
 		/// </summary>
 		public void HandleAnimations(Messages.AnimSyncMessage msg) {
-			isRunning = msg.isRunning;
-			aimRot = msg.aimRot;
-			HandleCrouchStates(msg.crouchPosition);
-			HandleDrinking(msg.drinkId);
-			HandleSwearing(msg.swearId);
-
-			foreach (AnimState state in states) {
-				state.TryActivate(msg);
-			}
+			PlayerAnimState animState = PlayerAnimState.Read(msg);
+
+			// Continuous values are interpolated over the time since the previous state.
+			float time = Time.time;
+			float duration = lastAnimationsTime < 0.0f ? 0.0f : Mathf.Min(time - lastAnimationsTime, MAX_INTERPOLATION_TIME);
+			lastAnimationsTime = time;
+			aimRot.Set(animState.aimRot, time, duration);
+			crouchPosition.Set(animState.crouchPosition, time, duration);
+
+			isRunning = animState.isRunning;
+			HandleDrinking(animState.drinkId);
+			HandleSwearing(animState.swearId);
+			UpdateActions(animState);
 		}
 
 		/// <summary>
 		/// Handles the Foot Movement Animations
 		/// </summary>
 		public void HandleOnFootMovementAnimations(float speed) {
+			if (lastAnimationsTime >= 0.0f) {
+				HandleCrouchStates(crouchPosition.Evaluate(Time.time));
+			}
+
 			if (speed > 0.001f) { //Moving
 				if (isRunning) PlayAnimation(AnimationId.Running); //Running
 				else PlayAnimation(GetAnimationFromStance(currentStance, false)); //Walking
@@ -504,10 +523,9 @@ namespace MSCMP.Network {
 		/// <summary>
 		/// Moves the head according to the vertical look position
 		/// </summary>
-		public void SyncVerticalHeadLook(GameObject characterGameObject, float progress) {
-			Transform head = characterGameObject.transform.FindChild("pelvis/spine_mid/shoulders/head");
-			//float newAimRot = Mathf.LerpAngle(head.rotation.eulerAngles.z, aimRot, progress); COMMENTED OUT CAUSE IT DOESNT WORK! NEED NEW INTERPOLATION
-			head.rotation *= Quaternion.Euler(0, 0, -aimRot);
+		public void SyncVerticalHeadLook() {
+			if (headTransform == null) return;
+			headTransform.rotation *= Quaternion.Euler(0, 0, -aimRot.Evaluate(Time.time));
 		}
 
 		/// <summary>
@@ -534,18 +552,18 @@ namespace MSCMP.Network {
 		/// </summary>
 		/// <param name="SwearID"></param>
 		private void HandleSwearing(int SwearID) {
-			if (SwearID != int.MaxValue && SwearID != currentSwearId) {
-				if (SwearID >= DrunkSpeaking_Offset) MasterAudio.PlaySound3DFollowTransformAndForget("Drunk", characterGameObject.transform, 1, 1, 0, SwearID.ToString());
-				else if (SwearID >= Agreeing_Offset) MasterAudio.PlaySound3DFollowTransformAndForget("Yes", characterGameObject.transform, 8, 1, 0, SwearID.ToString());
-				else if (SwearID >= Swears_Offset) MasterAudio.PlaySound3DFollowTransformAndForget("Swearing", characterGameObject.transform, 1, 1, 0, SwearID.ToString());
+			if (SwearID != PlayerAnimState.NO_SWEAR && SwearID != currentSwearId) {
+				if (SwearID >= DRUNK_SPEAKING_OFFSET) MasterAudio.PlaySound3DFollowTransformAndForget("Drunk", characterGameObject.transform, 1, 1, 0, SwearID.ToString());
+				else if (SwearID >= AGREEING_OFFSET) MasterAudio.PlaySound3DFollowTransformAndForget("Yes", characterGameObject.transform, 8, 1, 0, SwearID.ToString());
+				else if (SwearID >= SWEARS_OFFSET) MasterAudio.PlaySound3DFollowTransformAndForget("Swearing", characterGameObject.transform, 1, 1, 0, SwearID.ToString());
 				else MasterAudio.PlaySound3DFollowTransformAndForget("Fuck", characterGameObject.transform, 1, 1, 0, SwearID.ToString());
 			}
 			currentSwearId = SwearID;
 		}
-		int currentSwearId = int.MaxValue;
+		int currentSwearId = PlayerAnimState.NO_SWEAR;
 
-		public int Swears_Offset = 100;
-		public int Agreeing_Offset = 200;
-		public int DrunkSpeaking_Offset = 300;
+		public const int SWEARS_OFFSET = 100;
+		public const int AGREEING_OFFSET = 200;
+		public const int DRUNK_SPEAKING_OFFSET = 300;
 	}
 }
@@ -0,0 +1,136 @@
+using UnityEngine;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Animation state of the player in the form sent by the AnimSyncMessage.
+	/// </summary>
+	/// <remarks>
+	/// Discrete part is packed into 16 bits - four flags, 3 bit hand state and 4 bit drink id. Continuous values
+	/// are quantized to 8 bits and interpolated by the receiver. Sender compares the packed and quantized form to
+	/// decide if the state changed.
+	/// </remarks>
+	struct PlayerAnimState {
+
+		/// <summary>
+		/// Value of the hand state, drink and swear when there is none.
+		/// </summary>
+		public const byte NONE = 255;
+		public const int NO_SWEAR = int.MaxValue;
+
+		/// <summary>
+		/// Range of the vertical aim in degrees. (-90 looking up, 90 looking down)
+		/// </summary>
+		public const float AIM_RANGE = 90.0f;
+
+		/// <summary>
+		/// Maximal crouch position. (Standing player is below it)
+		/// </summary>
+		public const float CROUCH_MAX = 2.0f;
+
+		const ushort FLAG_RUNNING = 1 << 0;
+		const ushort FLAG_LEANING = 1 << 1;
+		const ushort FLAG_GROUNDED = 1 << 2;
+		const ushort FLAG_DRUNK = 1 << 3;
+		const int HAND_STATE_SHIFT = 4;
+		const int HAND_STATE_MASK = 0x7;
+		const int DRINK_SHIFT = 7;
+		const int DRINK_MASK = 0xF;
+
+		public bool isRunning;
+		public bool isLeaning;
+		public bool isGrounded;
+		public bool isDrunk;
+		public byte activeHandState;
+		public byte drinkId;
+		public int swearId;
+
+		/// <summary>
+		/// Vertical aim in degrees.
+		/// </summary>
+		public float aimRot;
+		public float crouchPosition;
+
+		/// <summary>
+		/// Pack the discrete part of the state.
+		/// </summary>
+		/// <returns>Packed state.</returns>
+		public ushort Pack() {
+			int packed = 0;
+			if (isRunning) packed |= FLAG_RUNNING;
+			if (isLeaning) packed |= FLAG_LEANING;
+			if (isGrounded) packed |= FLAG_GROUNDED;
+			if (isDrunk) packed |= FLAG_DRUNK;
+			packed |= PackId(activeHandState, HAND_STATE_MASK) << HAND_STATE_SHIFT;
+			packed |= PackId(drinkId, DRINK_MASK) << DRINK_SHIFT;
+			return (ushort)packed;
+		}
+
+		/// <summary>
+		/// Quantize vertical aim. (Euler angle is wrapped to the signed range first)
+		/// </summary>
+		public static byte QuantizeAim(float aimRot) {
+			return Math.Quantization.QuantizeByte(Mathf.DeltaAngle(0.0f, aimRot), -AIM_RANGE, AIM_RANGE);
+		}
+
+		public static byte QuantizeCrouch(float crouchPosition) {
+			return Math.Quantization.QuantizeByte(crouchPosition, 0.0f, CROUCH_MAX);
+		}
+
+		/// <summary>
+		/// Check if any part of the state differs from the other one once sent.
+		/// </summary>
+		/// <param name="other">The other state.</param>
+		/// <param name="continuous">Compare also the continuous values?</param>
+		/// <returns>true if the states differ, false otherwise.</returns>
+		public bool Differs(PlayerAnimState other, bool continuous) {
+			if (Pack() != other.Pack() || swearId != other.swearId) {
+				return true;
+			}
+			return continuous && (QuantizeAim(aimRot) != QuantizeAim(other.aimRot) || QuantizeCrouch(crouchPosition) != QuantizeCrouch(other.crouchPosition));
+		}
+
+		/// <summary>
+		/// Write the state into the message.
+		/// </summary>
+		/// <param name="msg">The message.</param>
+		public void Write(Messages.AnimSyncMessage msg) {
+			msg.state = Pack();
+			msg.aimRot = QuantizeAim(aimRot);
+			msg.crouchPosition = QuantizeCrouch(crouchPosition);
+			if (swearId != NO_SWEAR) {
+				msg.SwearId = (ushort)swearId;
+			}
+		}
+
+		/// <summary>
+		/// Read the state from the message.
+		/// </summary>
+		/// <param name="msg">The message.</param>
+		/// <returns>The state.</returns>
+		public static PlayerAnimState Read(Messages.AnimSyncMessage msg) {
+			PlayerAnimState state;
+			state.isRunning = (msg.state & FLAG_RUNNING) != 0;
+			state.isLeaning = (msg.state & FLAG_LEANING) != 0;
+			state.isGrounded = (msg.state & FLAG_GROUNDED) != 0;
+			state.isDrunk = (msg.state & FLAG_DRUNK) != 0;
+			state.activeHandState = UnpackId(msg.state >> HAND_STATE_SHIFT, HAND_STATE_MASK);
+			state.drinkId = UnpackId(msg.state >> DRINK_SHIFT, DRINK_MASK);
+			state.swearId = msg.HasSwearId ? msg.SwearId : NO_SWEAR;
+			state.aimRot = Math.Quantization.DequantizeByte(msg.aimRot, -AIM_RANGE, AIM_RANGE);
+			state.crouchPosition = Math.Quantization.DequantizeByte(msg.crouchPosition, 0.0f, CROUCH_MAX);
+			return state;
+		}
+
+		/// <summary>
+		/// Pack the id, NONE is stored as the all set mask.
+		/// </summary>
+		static int PackId(byte id, int mask) {
+			return id >= mask ? mask : id;
+		}
+
+		static byte UnpackId(int packed, int mask) {
+			packed &= mask;
+			return packed == mask ? NONE : (byte)packed;
+		}
+	}
+}
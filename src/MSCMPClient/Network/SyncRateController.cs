@@ -0,0 +1,200 @@
+namespace MSCMP.Network {
+	/// <summary>
+	/// Decides when the state of the local player should be sent.
+	/// </summary>
+	/// <remarks>
+	/// While the player moves the state is sent at least every MOVING_INTERVAL and additionally every time it
+	/// moved or turned more than the thresholds since the last sent state - so fast movement and turning raise
+	/// the rate up to 1 / MIN_INTERVAL. When the state stops changing it is only sent every KEEPALIVE_INTERVAL,
+	/// and the first change after that is sent right away so the receiver sees the exact moment the player
+	/// started moving.
+	///
+	/// The additional sends are limited by the token bucket of the bandwidth budget, the mandatory sends
+	/// (moving interval, keepalive, wake up) only consume the tokens.
+	///
+	/// Controller does not depend on Unity - the caller measures the change since the last sent state.
+	/// </remarks>
+	class SyncRateController {
+
+		/// <summary>
+		/// Minimal time between two sends in milliseconds.
+		/// </summary>
+		public const ulong MIN_INTERVAL = 40;
+
+		/// <summary>
+		/// Maximal time between two sends while the state changes in milliseconds.
+		/// </summary>
+		public const ulong MOVING_INTERVAL = 100;
+
+		/// <summary>
+		/// Time between two sends while the state does not change in milliseconds.
+		/// </summary>
+		public const ulong KEEPALIVE_INTERVAL = 1000;
+
+		/// <summary>
+		/// Movement in meters since the last sent state requesting the additional send.
+		/// </summary>
+		public const float DISTANCE_THRESHOLD = 0.3f;
+
+		/// <summary>
+		/// Rotation in degrees since the last sent state requesting the additional send.
+		/// </summary>
+		public const float ANGLE_THRESHOLD = 10.0f;
+
+		/// <summary>
+		/// Smaller movement in meters is not considered as change of the state.
+		/// </summary>
+		public const float IDLE_DISTANCE = 0.01f;
+
+		/// <summary>
+		/// Smaller rotation in degrees is not considered as change of the state.
+		/// </summary>
+		public const float IDLE_ANGLE = 1.0f;
+
+		/// <summary>
+		/// Size of the token bucket in seconds of the budget.
+		/// </summary>
+		const float BURST_TIME = 0.25f;
+
+		/// <summary>
+		/// Budget in bytes per second.
+		/// </summary>
+		readonly float budget;
+
+		/// <summary>
+		/// Bytes that can be spent by the additional sends. (Negative when mandatory sends went over the budget)
+		/// </summary>
+		float tokens;
+
+		ulong lastSendTime = 0;
+		ulong lastRefillTime = 0;
+		bool hasSent = false;
+
+		/// <summary>
+		/// Was the state unchanged when it was last sent?
+		/// </summary>
+		bool idle = false;
+
+		/// <summary>
+		/// Was the send requested by the caller?
+		/// </summary>
+		bool forced = false;
+
+		/// <summary>
+		/// Amount of sends by the reason.
+		/// </summary>
+		public long MovingSends { get; private set; }
+		public long ThresholdSends { get; private set; }
+		public long KeepaliveSends { get; private set; }
+		public long WakeSends { get; private set; }
+
+		/// <summary>
+		/// Amount of additional sends postponed because of the budget.
+		/// </summary>
+		public long Throttled { get; private set; }
+
+		/// <summary>
+		/// Is the state currently sent at the keepalive rate?
+		/// </summary>
+		public bool Idle {
+			get { return idle; }
+		}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="budget">Bandwidth budget in bytes per second.</param>
+		public SyncRateController(float budget) {
+			this.budget = budget;
+			tokens = budget * BURST_TIME;
+		}
+
+		/// <summary>
+		/// Send the state as soon as possible. (e.g. a discrete change like picking up an object)
+		/// </summary>
+		public void ForceNextSend() {
+			forced = true;
+		}
+
+		/// <summary>
+		/// Check if the state should be sent now.
+		/// </summary>
+		/// <param name="time">Current time in milliseconds.</param>
+		/// <param name="distance">Movement in meters since the last sent state.</param>
+		/// <param name="angle">Rotation in degrees since the last sent state.</param>
+		/// <returns>true if the state should be sent, call Sent once it is.</returns>
+		public bool ShouldSend(ulong time, float distance, float angle) {
+			Refill(time);
+			if (!hasSent) {
+				return true;
+			}
+
+			ulong elapsed = time - lastSendTime;
+			if (elapsed < MIN_INTERVAL) {
+				return false;
+			}
+
+			if (forced) {
+				WakeSends++;
+				return true;
+			}
+
+			// The first unchanged state is sent at the moving rate so the receiver sees the player stopped
+			// instead of extrapolating the last motion.
+			bool changed = distance > IDLE_DISTANCE || angle > IDLE_ANGLE;
+			if (!changed) {
+				if (elapsed >= KEEPALIVE_INTERVAL || (!idle && elapsed >= MOVING_INTERVAL)) {
+					KeepaliveSends++;
+					return true;
+				}
+				return false;
+			}
+
+			if (idle) {
+				WakeSends++;
+				return true;
+			}
+
+			if (elapsed >= MOVING_INTERVAL) {
+				MovingSends++;
+				return true;
+			}
+
+			if (distance >= DISTANCE_THRESHOLD || angle >= ANGLE_THRESHOLD) {
+				if (tokens <= 0.0f) {
+					Throttled++;
+					return false;
+				}
+				ThresholdSends++;
+				return true;
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Record the sent state.
+		/// </summary>
+		/// <param name="time">Current time in milliseconds.</param>
+		/// <param name="distance">Movement in meters since the previously sent state.</param>
+		/// <param name="angle">Rotation in degrees since the previously sent state.</param>
+		/// <param name="bytes">Size of the sent message in bytes.</param>
+		public void Sent(ulong time, float distance, float angle, long bytes) {
+			Refill(time);
+			idle = hasSent && !forced && distance <= IDLE_DISTANCE && angle <= IDLE_ANGLE;
+			tokens = System.Math.Max(tokens - bytes, -budget * BURST_TIME);
+			lastSendTime = time;
+			hasSent = true;
+			forced = false;
+		}
+
+		/// <summary>
+		/// Add the tokens for the time elapsed since the last refill.
+		/// </summary>
+		void Refill(ulong time) {
+			if (time > lastRefillTime) {
+				tokens = System.Math.Min(tokens + budget * (time - lastRefillTime) / 1000.0f, budget * BURST_TIME);
+			}
+			lastRefillTime = time;
+		}
+	}
+}
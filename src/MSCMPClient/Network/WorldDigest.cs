@@ -0,0 +1,288 @@
+using System.Collections.Generic;
+using UnityEngine;
+using MSCMP.Game;
+using MSCMP.Game.Components;
+using MSCMP.Game.Objects;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Merkle tree of hashes of the world state compared by the host to send the joining player only the parts
+	/// of the world that differ.
+	/// </summary>
+	/// <remarks>
+	/// Pickupables are hashed by their object id, prefab id, quantized transform and activation into the buckets
+	/// selected by their object id. Doors and lights are hashed into the world bucket. Hashes of the objects in
+	/// the bucket are summed so the order of the objects does not matter. The tree is stored in the heap layout,
+	/// node 1 is the root and the buckets are the leaves. Client sends only the leaves, comparing the trees
+	/// descends only into the subtrees that differ.
+	///
+	/// Capture reads the game objects and is main thread only, the host builds its digest on the encoder thread.
+	/// </remarks>
+	class WorldDigest {
+
+		/// <summary>
+		/// Amount of the buckets. (Leaves of the tree)
+		/// </summary>
+		public const int BUCKET_COUNT = 256;
+
+		/// <summary>
+		/// Bucket of the doors and lights.
+		/// </summary>
+		public const int WORLD_BUCKET = 0;
+
+		/// <summary>
+		/// Quantization of the hashed positions. (Steps per meter)
+		/// </summary>
+		const float POSITION_STEPS = 100.0f;
+
+		/// <summary>
+		/// Quantization of the hashed rotation components. (Steps per unit)
+		/// </summary>
+		const float ROTATION_STEPS = 1000.0f;
+
+		const uint FNV_OFFSET = 2166136261;
+		const uint FNV_PRIME = 16777619;
+
+		/// <summary>
+		/// The tree nodes. (Node 0 is unused)
+		/// </summary>
+		uint[] nodes = new uint[BUCKET_COUNT * 2];
+
+		/// <summary>
+		/// Object ids of the pickupables hashed by Capture. (Empty for the digest built from the other data)
+		/// </summary>
+		HashSet<int> capturedIds = new HashSet<int>();
+
+		/// <summary>
+		/// Hashes of the buckets.
+		/// </summary>
+		public uint[] Leaves {
+			get {
+				var leaves = new uint[BUCKET_COUNT];
+				System.Array.Copy(nodes, BUCKET_COUNT, leaves, 0, BUCKET_COUNT);
+				return leaves;
+			}
+		}
+
+		/// <summary>
+		/// Create the digest from the bucket hashes sent by the client.
+		/// </summary>
+		/// <param name="leaves">The bucket hashes.</param>
+		/// <returns>The digest or null if the amount of the buckets does not match.</returns>
+		public static WorldDigest FromLeaves(uint[] leaves) {
+			if (leaves.Length != BUCKET_COUNT) {
+				return null;
+			}
+			var digest = new WorldDigest();
+			System.Array.Copy(leaves, 0, digest.nodes, BUCKET_COUNT, BUCKET_COUNT);
+			digest.Build();
+			return digest;
+		}
+
+		/// <summary>
+		/// Capture the digest of the local world.
+		/// </summary>
+		/// <returns>The built digest.</returns>
+		public static WorldDigest Capture() {
+			var digest = new WorldDigest();
+
+			foreach (GameDoor door in GameDoorsManager.Instance.doors) {
+				Vector3 position = door.Position;
+				digest.AddDoor(position.x, position.y, position.z, door.IsOpen);
+			}
+
+			foreach (LightSwitch light in LightSwitchManager.Instance.lightSwitches) {
+				Vector3 position = light.Position;
+				digest.AddLight(position.x, position.y, position.z, light.SwitchStatus);
+			}
+
+			var objects = ObjectSyncManager.Instance.ObjectIDs;
+			int count = objects.Count;
+			for (int i = 0; i < count; ++i) {
+				ObjectSyncComponent osc = objects.GetAt(i);
+				if (osc == null || osc.ObjectType != ObjectSyncManager.ObjectTypes.Pickupable) {
+					continue;
+				}
+				var metaData = osc.GetComponent<PickupableMetaDataComponent>();
+				if (metaData == null || metaData.prefabId == -1) {
+					continue;
+				}
+				Transform transform = osc.transform;
+				Vector3 position = transform.position;
+				Quaternion rotation = transform.rotation;
+				int objectId = objects.GetIdAt(i);
+				digest.AddPickupable(objectId, metaData.prefabId, position.x, position.y, position.z, rotation.x, rotation.y, rotation.z, rotation.w, osc.gameObject.activeSelf);
+				digest.capturedIds.Add(objectId);
+			}
+
+			digest.Build();
+			return digest;
+		}
+
+		/// <summary>
+		/// Get the bucket of the pickupable.
+		/// </summary>
+		/// <param name="objectId">Object id of the pickupable.</param>
+		/// <returns>The bucket.</returns>
+		public static int GetBucket(int objectId) {
+			return 1 + (int)(Avalanche((uint)objectId) % (BUCKET_COUNT - 1));
+		}
+
+		/// <summary>
+		/// Check if the pickupable was hashed by Capture.
+		/// </summary>
+		/// <param name="objectId">Object id of the pickupable.</param>
+		/// <returns>true if the pickupable is part of the digest, false otherwise.</returns>
+		public bool IsCaptured(int objectId) {
+			return capturedIds.Contains(objectId);
+		}
+
+		/// <summary>
+		/// Check if the bucket is set in the bucket mask.
+		/// </summary>
+		/// <param name="mask">The bucket mask. (See Diff)</param>
+		/// <param name="bucket">The bucket.</param>
+		/// <returns>true if the bucket is set, false otherwise.</returns>
+		public static bool IsSet(byte[] mask, int bucket) {
+			return (mask[bucket >> 3] & (1 << (bucket & 7))) != 0;
+		}
+
+		/// <summary>
+		/// Hash the pickupable into its bucket.
+		/// </summary>
+		/// <param name="objectId">Object id of the pickupable.</param>
+		/// <param name="prefabId">Prefab id of the pickupable.</param>
+		/// <param name="px">Position x.</param>
+		/// <param name="py">Position y.</param>
+		/// <param name="pz">Position z.</param>
+		/// <param name="rx">Rotation x.</param>
+		/// <param name="ry">Rotation y.</param>
+		/// <param name="rz">Rotation z.</param>
+		/// <param name="rw">Rotation w.</param>
+		/// <param name="active">Is the pickupable active?</param>
+		public void AddPickupable(int objectId, int prefabId, float px, float py, float pz, float rx, float ry, float rz, float rw, bool active) {
+			// q and -q is the same rotation.
+			if (rw < 0.0f) {
+				rx = -rx;
+				ry = -ry;
+				rz = -rz;
+				rw = -rw;
+			}
+
+			uint hash = FNV_OFFSET;
+			hash = Mix(hash, objectId);
+			hash = Mix(hash, prefabId);
+			hash = Mix(hash, Quantize(px, POSITION_STEPS));
+			hash = Mix(hash, Quantize(py, POSITION_STEPS));
+			hash = Mix(hash, Quantize(pz, POSITION_STEPS));
+			hash = Mix(hash, Quantize(rx, ROTATION_STEPS));
+			hash = Mix(hash, Quantize(ry, ROTATION_STEPS));
+			hash = Mix(hash, Quantize(rz, ROTATION_STEPS));
+			hash = Mix(hash, Quantize(rw, ROTATION_STEPS));
+			hash = Mix(hash, active ? 1 : 0);
+			AddToBucket(GetBucket(objectId), Avalanche(hash));
+		}
+
+		/// <summary>
+		/// Hash the door into the world bucket.
+		/// </summary>
+		/// <param name="x">Position x.</param>
+		/// <param name="y">Position y.</param>
+		/// <param name="z">Position z.</param>
+		/// <param name="open">Is the door open?</param>
+		public void AddDoor(float x, float y, float z, bool open) {
+			AddSwitch(1, x, y, z, open);
+		}
+
+		/// <summary>
+		/// Hash the light switch into the world bucket.
+		/// </summary>
+		/// <param name="x">Position x.</param>
+		/// <param name="y">Position y.</param>
+		/// <param name="z">Position z.</param>
+		/// <param name="on">Is the light on?</param>
+		public void AddLight(float x, float y, float z, bool on) {
+			AddSwitch(2, x, y, z, on);
+		}
+
+		/// <summary>
+		/// Compute the inner nodes of the tree once all objects are added.
+		/// </summary>
+		public void Build() {
+			for (int node = BUCKET_COUNT - 1; node > 0; --node) {
+				nodes[node] = Avalanche(Mix(Mix(FNV_OFFSET, (int)nodes[node * 2]), (int)nodes[node * 2 + 1]));
+			}
+		}
+
+		/// <summary>
+		/// Find the buckets that differ from the other digest.
+		/// </summary>
+		/// <param name="other">The other digest. (Both have to be built)</param>
+		/// <param name="mask">Bit mask of the differing buckets. (BUCKET_COUNT bits)</param>
+		/// <returns>Amount of the differing buckets.</returns>
+		public int Diff(WorldDigest other, out byte[] mask) {
+			mask = new byte[BUCKET_COUNT / 8];
+			var stack = new Stack<int>();
+			stack.Push(1);
+			int differing = 0;
+			while (stack.Count > 0) {
+				int node = stack.Pop();
+				if (nodes[node] == other.nodes[node]) {
+					continue;
+				}
+				if (node < BUCKET_COUNT) {
+					stack.Push(node * 2);
+					stack.Push(node * 2 + 1);
+					continue;
+				}
+				int bucket = node - BUCKET_COUNT;
+				mask[bucket >> 3] |= (byte)(1 << (bucket & 7));
+				differing++;
+			}
+			return differing;
+		}
+
+		void AddSwitch(int kind, float x, float y, float z, bool state) {
+			uint hash = FNV_OFFSET;
+			hash = Mix(hash, kind);
+			hash = Mix(hash, Quantize(x, POSITION_STEPS));
+			hash = Mix(hash, Quantize(y, POSITION_STEPS));
+			hash = Mix(hash, Quantize(z, POSITION_STEPS));
+			hash = Mix(hash, state ? 1 : 0);
+			AddToBucket(WORLD_BUCKET, Avalanche(hash));
+		}
+
+		void AddToBucket(int bucket, uint hash) {
+			unchecked {
+				nodes[BUCKET_COUNT + bucket] += hash;
+			}
+		}
+
+		static int Quantize(float value, float steps) {
+			return (int)System.Math.Floor(value * steps + 0.5f);
+		}
+
+		/// <summary>
+		/// FNV-1a step over the whole value.
+		/// </summary>
+		static uint Mix(uint hash, int value) {
+			unchecked {
+				return (hash ^ (uint)value) * FNV_PRIME;
+			}
+		}
+
+		/// <summary>
+		/// Avalanche the hash so the sums of the object hashes do not collide. (MurmurHash3 finalizer)
+		/// </summary>
+		static uint Avalanche(uint hash) {
+			unchecked {
+				hash ^= hash >> 16;
+				hash *= 0x85ebca6b;
+				hash ^= hash >> 13;
+				hash *= 0xc2b2ae35;
+				hash ^= hash >> 16;
+				return hash;
+			}
+		}
+	}
+}
@@ -0,0 +1,258 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using MSCMP.Game;
+using MSCMP.Game.Components;
+using MSCMP.Game.Objects;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Captures the full world state for the joining player across multiple frames.
+	/// </summary>
+	/// <remarks>
+	/// World time, doors, lights and weather are written in the first step. Ids of the synced objects are copied
+	/// then too and the pickupables are captured in the following steps until the frame budget runs out. Objects
+	/// removed during the capture resolve to null and are skipped, objects spawned during it are sent to the
+	/// player by their own spawn messages. Transforms of the inactive objects are read directly, their
+	/// activation is never changed. The local player's spawn state is written in the last step.
+	///
+	/// Pickupables are only copied into flat arrays on the main thread, building their messages, serialization
+	/// and compression is left to the WorldStateEncoder.
+	/// </remarks>
+	class WorldSnapshotWriter {
+
+		/// <summary>
+		/// Time the capture may take every frame in milliseconds.
+		/// </summary>
+		public const double FRAME_BUDGET = 2.0;
+
+		/// <summary>
+		/// Floats of the captured transform. (Position and rotation)
+		/// </summary>
+		public const int TRANSFORM_STRIDE = 7;
+
+		/// <summary>
+		/// The message being written. (Without the pickupables)
+		/// </summary>
+		Messages.FullWorldSyncMessage msg = new Messages.FullWorldSyncMessage();
+
+		/// <summary>
+		/// Ids of the objects to capture. (Copied in the first step, null before)
+		/// </summary>
+		int[] objectIds = null;
+		int nextObject = 0;
+
+		/// <summary>
+		/// Captured pickupables. (Allocated for all objects in the first step)
+		/// </summary>
+		int pickupableCount = 0;
+		int[] pickupableIds = null;
+		int[] prefabIds = null;
+
+		/// <summary>
+		/// Position and rotation of the pickupables. (TRANSFORM_STRIDE floats per pickupable)
+		/// </summary>
+		float[] transforms = null;
+		bool[] active = null;
+
+		bool finished = false;
+
+		/// <summary>
+		/// Digest of the joining player's world. (null if the whole world is sent)
+		/// </summary>
+		WorldDigest playerDigest = null;
+
+		/// <summary>
+		/// Statistics of the capture.
+		/// </summary>
+		int frames = 0;
+		double captureTime = 0.0;
+		double longestFrame = 0.0;
+		Stopwatch totalWatch = Stopwatch.StartNew();
+
+		/// <summary>
+		/// The written message without the pickupables. (Complete once Step returns true)
+		/// </summary>
+		public Messages.FullWorldSyncMessage Message {
+			get { return msg; }
+		}
+
+		/// <summary>
+		/// Amount of the captured pickupables. (Valid entries of the arrays below)
+		/// </summary>
+		public int PickupableCount {
+			get { return pickupableCount; }
+		}
+
+		/// <summary>
+		/// Object ids of the captured pickupables.
+		/// </summary>
+		public int[] PickupableIds {
+			get { return pickupableIds; }
+		}
+
+		/// <summary>
+		/// Prefab ids of the captured pickupables.
+		/// </summary>
+		public int[] PrefabIds {
+			get { return prefabIds; }
+		}
+
+		/// <summary>
+		/// Position (x, y, z) and rotation (x, y, z, w) of the pickupables.
+		/// </summary>
+		public float[] Transforms {
+			get { return transforms; }
+		}
+
+		/// <summary>
+		/// Activation of the captured pickupables.
+		/// </summary>
+		public bool[] Active {
+			get { return active; }
+		}
+
+		/// <summary>
+		/// Digest of the joining player's world. (null if the whole world is sent)
+		/// </summary>
+		public WorldDigest PlayerDigest {
+			get { return playerDigest; }
+		}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="playerDigest">Digest of the joining player's world or null to send the whole world.</param>
+		public WorldSnapshotWriter(WorldDigest playerDigest) {
+			this.playerDigest = playerDigest;
+		}
+
+		/// <summary>
+		/// Continue the capture until the budget runs out.
+		/// </summary>
+		/// <param name="localPlayer">The local player. (Writes its spawn state at the end)</param>
+		/// <param name="budget">Time the step may take in milliseconds.</param>
+		/// <returns>true if the capture is finished, false otherwise.</returns>
+		public bool Step(NetLocalPlayer localPlayer, double budget) {
+			if (finished) {
+				return true;
+			}
+
+			var watch = Stopwatch.StartNew();
+			if (objectIds == null) {
+				WriteWorld();
+			}
+
+			var objects = ObjectSyncManager.Instance.ObjectIDs;
+			while (nextObject < objectIds.Length && watch.Elapsed.TotalMilliseconds < budget) {
+				ObjectSyncComponent osc = objects.Get(objectIds[nextObject++]);
+				if (osc != null) {
+					WritePickupable(osc);
+				}
+			}
+
+			if (nextObject == objectIds.Length) {
+				localPlayer.WriteSpawnState(msg);
+				finished = true;
+			}
+
+			double elapsed = watch.Elapsed.TotalMilliseconds;
+			captureTime += elapsed;
+			longestFrame = System.Math.Max(longestFrame, elapsed);
+			frames++;
+
+			if (finished) {
+				Logger.Log($"World state of {pickupableCount} pickupables captured in {frames} frames, {captureTime:0.0} ms on the main thread (longest frame {longestFrame:0.00} ms), {totalWatch.ElapsedMilliseconds} ms total.");
+			}
+			return finished;
+		}
+
+		/// <summary>
+		/// Write the world state that is not captured incrementally and copy the object ids.
+		/// </summary>
+		void WriteWorld() {
+			// Write time
+
+			GameWorld gameWorld = GameWorld.Instance;
+			msg.dayTime = gameWorld.WorldTime;
+			msg.day = gameWorld.WorldDay;
+
+			// Write mailbox name
+
+			msg.mailboxName = gameWorld.PlayerLastName;
+
+			// Write doors
+
+			List<GameDoor> doors = GameDoorsManager.Instance.doors;
+			int doorsCount = doors.Count;
+			msg.doors = new Messages.DoorsInitMessage[doorsCount];
+			for (int i = 0; i < doorsCount; ++i) {
+				var doorMsg = new Messages.DoorsInitMessage();
+				GameDoor door = doors[i];
+				doorMsg.position = Utils.GameVec3ToNet(door.Position);
+				doorMsg.open = door.IsOpen;
+				msg.doors[i] = doorMsg;
+			}
+
+			// Write light switches.
+
+			List<LightSwitch> lights = LightSwitchManager.Instance.lightSwitches;
+			int lightCount = lights.Count;
+			msg.lights = new Messages.LightSwitchMessage[lightCount];
+			for (int i = 0; i < lightCount; i++) {
+				var lightMsg = new Messages.LightSwitchMessage();
+				LightSwitch light = lights[i];
+				lightMsg.pos = Utils.GameVec3ToNet(light.Position);
+				lightMsg.toggle = light.SwitchStatus;
+				msg.lights[i] = lightMsg;
+			}
+
+			// Write weather
+
+			GameWeatherManager.Instance.WriteWeather(msg.currentWeather);
+
+			// Ids of the objects, dense array of the slot map is reordered by removals so it can't be walked across frames.
+
+			var objects = ObjectSyncManager.Instance.ObjectIDs;
+			objectIds = new int[objects.Count];
+			for (int i = 0; i < objectIds.Length; ++i) {
+				objectIds[i] = objects.GetIdAt(i);
+			}
+
+			pickupableIds = new int[objectIds.Length];
+			prefabIds = new int[objectIds.Length];
+			transforms = new float[objectIds.Length * TRANSFORM_STRIDE];
+			active = new bool[objectIds.Length];
+		}
+
+		/// <summary>
+		/// Copy spawn state of the pickupable.
+		/// </summary>
+		/// <param name="osc">The object.</param>
+		void WritePickupable(ObjectSyncComponent osc) {
+			if (osc.ObjectType != ObjectSyncManager.ObjectTypes.Pickupable) {
+				return;
+			}
+
+			var metaData = osc.GetComponent<PickupableMetaDataComponent>();
+			Client.Assert(metaData != null && metaData.PrefabDescriptor != null, $"Object with broken meta data -- {osc.gameObject.name}.");
+
+			int index = pickupableCount++;
+			pickupableIds[index] = osc.ObjectID;
+			prefabIds[index] = metaData.prefabId;
+
+			// Transforms are valid on the inactive objects as well.
+			UnityEngine.Transform transform = osc.transform;
+			UnityEngine.Vector3 position = transform.position;
+			UnityEngine.Quaternion rotation = transform.rotation;
+			int offset = index * TRANSFORM_STRIDE;
+			transforms[offset] = position.x;
+			transforms[offset + 1] = position.y;
+			transforms[offset + 2] = position.z;
+			transforms[offset + 3] = rotation.x;
+			transforms[offset + 4] = rotation.y;
+			transforms[offset + 5] = rotation.z;
+			transforms[offset + 6] = rotation.w;
+			active[index] = osc.gameObject.activeSelf;
+		}
+	}
+}
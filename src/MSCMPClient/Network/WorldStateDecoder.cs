@@ -0,0 +1,230 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.IO.Compression;
+using System.Threading;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Assembles the world state chunks sent by the host and applies the decoded state across multiple frames.
+	/// </summary>
+	/// <remarks>
+	/// Chunks are appended into the assembly buffer as they arrive. Once the last one is received the decoder
+	/// thread inflates the data, reads the FullWorldSyncMessage and splits the pickupables into the apply batches.
+	/// Main thread applies the world state first and then spawns the batches until the frame budget runs out.
+	/// </remarks>
+	class WorldStateDecoder {
+
+		/// <summary>
+		/// Time the apply may take every frame in milliseconds.
+		/// </summary>
+		public const double FRAME_BUDGET = 4.0;
+
+		/// <summary>
+		/// Amount of the pickupables in one apply batch.
+		/// </summary>
+		const int APPLY_BATCH_SIZE = 16;
+
+		/// <summary>
+		/// The host sending the state.
+		/// </summary>
+		Steamworks.CSteamID sender;
+
+		byte stateId;
+		int chunkCount = 0;
+		int nextChunk = 0;
+		int uncompressedSize = 0;
+
+		/// <summary>
+		/// The received chunk data.
+		/// </summary>
+		MemoryStream assembly = new MemoryStream();
+
+		/// <summary>
+		/// The decoded state. (Owned by the decoder thread until decoded)
+		/// </summary>
+		Messages.FullWorldSyncMessage msg = new Messages.FullWorldSyncMessage();
+		Queue<Messages.PickupableSpawnMessage[]> batches = new Queue<Messages.PickupableSpawnMessage[]>();
+
+		/// <summary>
+		/// The error reported by the decoder thread. (Logger is not thread safe so it is logged from the main thread)
+		/// </summary>
+		string threadError = null;
+
+		bool decoding = false;
+		bool decoded = false;
+		bool worldApplied = false;
+
+		/// <summary>
+		/// Lock guarding <see cref="decoded"/> and <see cref="threadError"/>.
+		/// </summary>
+		object syncLock = new object();
+
+		/// <summary>
+		/// Statistics of the transfer.
+		/// </summary>
+		int frames = 0;
+		double decodeTime = 0.0;
+		double applyTime = 0.0;
+		double longestFrame = 0.0;
+		Stopwatch totalWatch = Stopwatch.StartNew();
+
+		public Steamworks.CSteamID Sender {
+			get { return sender; }
+		}
+
+		public byte StateId {
+			get { return stateId; }
+		}
+
+		/// <summary>
+		/// Did the decoder start applying the state? (The world is partially applied from then on)
+		/// </summary>
+		public bool Applying {
+			get { return worldApplied; }
+		}
+
+		/// <summary>
+		/// The decoded message. (Complete once Step returns true)
+		/// </summary>
+		public Messages.FullWorldSyncMessage Message {
+			get { return msg; }
+		}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="sender">The host sending the state.</param>
+		/// <param name="stateId">Id of the transfer.</param>
+		public WorldStateDecoder(Steamworks.CSteamID sender, byte stateId) {
+			this.sender = sender;
+			this.stateId = stateId;
+		}
+
+		/// <summary>
+		/// Append the chunk. Starts the decoder thread once all chunks are received.
+		/// </summary>
+		/// <param name="chunk">The chunk of this transfer.</param>
+		public void AddChunk(Messages.WorldStateChunkMessage chunk) {
+			if (nextChunk == 0) {
+				chunkCount = chunk.count;
+				uncompressedSize = chunk.uncompressedSize;
+			}
+
+			// Chunks are sent reliably so they can't be missing or reordered.
+			Client.Assert(!decoding && chunk.index == nextChunk && chunk.count == chunkCount, $"Unexpected world state chunk {chunk.index}/{chunk.count}, expected {nextChunk}/{chunkCount}.");
+
+			assembly.Write(chunk.data, 0, chunk.data.Length);
+			if (++nextChunk < chunkCount) {
+				return;
+			}
+
+			decoding = true;
+			var thread = new Thread(DecoderThread);
+			thread.IsBackground = true;
+			thread.Name = "MSCMP world state decoder";
+			thread.Start();
+		}
+
+		/// <summary>
+		/// Continue applying the decoded state until the budget runs out.
+		/// </summary>
+		/// <param name="world">The world to apply the state to.</param>
+		/// <param name="budget">Time the step may take in milliseconds.</param>
+		/// <returns>true if the whole state is applied, false otherwise.</returns>
+		public bool Step(NetWorld world, double budget) {
+			lock (syncLock) {
+				if (!decoded) {
+					return false;
+				}
+			}
+			if (threadError != null) {
+				Client.FatalError($"Failed to decode world state: {threadError}");
+				return false;
+			}
+
+			var watch = Stopwatch.StartNew();
+			if (!worldApplied) {
+				world.ApplyWorldState(msg);
+				worldApplied = true;
+			}
+
+			while (batches.Count > 0 && watch.Elapsed.TotalMilliseconds < budget) {
+				foreach (Messages.PickupableSpawnMessage pickupableMsg in batches.Dequeue()) {
+					world.ApplyPickupable(pickupableMsg);
+				}
+			}
+
+			bool finished = batches.Count == 0;
+			if (finished) {
+				world.FinishWorldState(msg);
+			}
+
+			double elapsed = watch.Elapsed.TotalMilliseconds;
+			applyTime += elapsed;
+			longestFrame = System.Math.Max(longestFrame, elapsed);
+			frames++;
+
+			if (finished) {
+				Logger.Log($"World state of {msg.pickupables.Length} pickupables ({assembly.Length} bytes in {chunkCount} chunks) decoded in {decodeTime:0.0} ms on the decoder thread, applied in {frames} frames, {applyTime:0.0} ms on the main thread (longest frame {longestFrame:0.00} ms), {totalWatch.ElapsedMilliseconds} ms total.");
+			}
+			return finished;
+		}
+
+		/// <summary>
+		/// Decoder thread.
+		/// </summary>
+		void DecoderThread() {
+			var watch = Stopwatch.StartNew();
+			string error = null;
+			try {
+				byte[] serialized = assembly.ToArray();
+				if (uncompressedSize > 0) {
+					serialized = Decompress(serialized, uncompressedSize);
+				}
+
+				if (!msg.Read(new BinaryReader(new MemoryStream(serialized)))) {
+					throw new InvalidDataException("Failed to read the full world sync message.");
+				}
+
+				Messages.PickupableSpawnMessage[] pickupables = msg.pickupables;
+				for (int i = 0; i < pickupables.Length; i += APPLY_BATCH_SIZE) {
+					var batch = new Messages.PickupableSpawnMessage[System.Math.Min(APPLY_BATCH_SIZE, pickupables.Length - i)];
+					Array.Copy(pickupables, i, batch, 0, batch.Length);
+					batches.Enqueue(batch);
+				}
+			}
+			catch (Exception e) {
+				error = e.Message;
+			}
+
+			lock (syncLock) {
+				decodeTime = watch.Elapsed.TotalMilliseconds;
+				threadError = error;
+				decoded = true;
+			}
+		}
+
+		/// <summary>
+		/// Inflate the received state.
+		/// </summary>
+		/// <param name="compressed">The deflated state.</param>
+		/// <param name="size">Size of the inflated state.</param>
+		/// <returns>The inflated state.</returns>
+		static byte[] Decompress(byte[] compressed, int size) {
+			var serialized = new byte[size];
+			using (var inflate = new DeflateStream(new MemoryStream(compressed), CompressionMode.Decompress)) {
+				int offset = 0;
+				while (offset < size) {
+					int read = inflate.Read(serialized, offset, size - offset);
+					if (read == 0) {
+						throw new InvalidDataException($"World state is truncated. ({offset} of {size} bytes)");
+					}
+					offset += read;
+				}
+			}
+			return serialized;
+		}
+	}
+}
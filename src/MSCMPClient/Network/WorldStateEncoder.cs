@@ -0,0 +1,266 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.IO.Compression;
+using System.Threading;
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Serializes, compresses and chunks the world state captured by the WorldSnapshotWriter.
+	/// </summary>
+	/// <remarks>
+	/// The capture is handed over to the encoder thread and not touched by the main thread anymore. The thread
+	/// builds the pickupable messages from the flat arrays, serializes the FullWorldSyncMessage, deflates it and
+	/// splits it into the WorldStateChunkMessages. Main thread polls the encoder and sends the chunks once done.
+	/// If deflating is not available the data is sent uncompressed.
+	///
+	/// If the joining player sent the digest of its world, the digest of the captured state is compared to it
+	/// and only the pickupables in the differing buckets are sent.
+	/// </remarks>
+	class WorldStateEncoder {
+
+		/// <summary>
+		/// Maximal size of the chunk data in bytes.
+		/// </summary>
+		public const int CHUNK_SIZE = 16 * 1024;
+
+		/// <summary>
+		/// Id of the transfer written into the chunks.
+		/// </summary>
+		byte stateId;
+
+		/// <summary>
+		/// The captured state. (Owned by the encoder thread)
+		/// </summary>
+		Messages.FullWorldSyncMessage msg;
+		int pickupableCount;
+		int[] pickupableIds;
+		int[] prefabIds;
+		float[] transforms;
+		bool[] active;
+		WorldDigest playerDigest;
+
+		/// <summary>
+		/// The encoded chunks. (null until the encoder thread finishes)
+		/// </summary>
+		List<Messages.WorldStateChunkMessage> chunks = null;
+
+		/// <summary>
+		/// Statistics of the encoding.
+		/// </summary>
+		int serializedSize = 0;
+		int compressedSize = 0;
+		double encodeTime = 0.0;
+		int differingBuckets = 0;
+
+		/// <summary>
+		/// The errors reported by the encoder thread. (Logger is not thread safe so it is logged from the main thread)
+		/// </summary>
+		string compressionError = null;
+		string threadError = null;
+
+		bool finished = false;
+
+		/// <summary>
+		/// Lock guarding the encoding results.
+		/// </summary>
+		object syncLock = new object();
+
+		/// <summary>
+		/// The encoded chunks. (Valid once Poll returns true)
+		/// </summary>
+		public List<Messages.WorldStateChunkMessage> Chunks {
+			get { return chunks; }
+		}
+
+		/// <summary>
+		/// Constructor. Starts the encoder thread.
+		/// </summary>
+		/// <param name="writer">The finished world state capture.</param>
+		/// <param name="stateId">Id of the transfer.</param>
+		public WorldStateEncoder(WorldSnapshotWriter writer, byte stateId) {
+			this.stateId = stateId;
+			msg = writer.Message;
+			pickupableCount = writer.PickupableCount;
+			pickupableIds = writer.PickupableIds;
+			prefabIds = writer.PrefabIds;
+			transforms = writer.Transforms;
+			active = writer.Active;
+			playerDigest = writer.PlayerDigest;
+
+			var thread = new Thread(EncoderThread);
+			thread.IsBackground = true;
+			thread.Name = "MSCMP world state encoder";
+			thread.Start();
+		}
+
+		/// <summary>
+		/// Check if the encoding finished. Logs the results once finished.
+		/// </summary>
+		/// <returns>true if the chunks are ready or the encoding failed (Chunks is null then), false otherwise.</returns>
+		public bool Poll() {
+			lock (syncLock) {
+				if (!finished) {
+					return false;
+				}
+			}
+
+			if (compressionError != null) {
+				Logger.Log($"World state compression is not available, sending it uncompressed. ({compressionError})");
+			}
+			if (threadError != null) {
+				Logger.Error($"Failed to encode world state: {threadError}");
+				chunks = null;
+				return true;
+			}
+			if (playerDigest != null) {
+				Logger.Log($"World state differs from the player's one in {differingBuckets} of {WorldDigest.BUCKET_COUNT} buckets, sending {msg.pickupables.Length} of {pickupableCount} pickupables.");
+			}
+			Logger.Log($"World state encoded into {chunks.Count} chunks, {serializedSize} bytes serialized, {compressedSize} bytes sent, {encodeTime:0.0} ms on the encoder thread.");
+			return true;
+		}
+
+		/// <summary>
+		/// Encoder thread.
+		/// </summary>
+		void EncoderThread() {
+			var watch = Stopwatch.StartNew();
+			var encoded = new List<Messages.WorldStateChunkMessage>();
+			string error = null;
+			try {
+				byte[] syncedBuckets = null;
+				if (playerDigest != null) {
+					syncedBuckets = DiffWorld();
+				}
+				msg.pickupables = BuildPickupables(syncedBuckets);
+
+				var stream = new MemoryStream();
+				if (!msg.Write(new BinaryWriter(stream))) {
+					throw new InvalidDataException("Failed to serialize the full world sync message.");
+				}
+				byte[] serialized = stream.ToArray();
+				serializedSize = serialized.Length;
+
+				int uncompressedSize = 0;
+				byte[] payload = Compress(serialized);
+				if (payload != null) {
+					uncompressedSize = serialized.Length;
+				}
+				else {
+					payload = serialized;
+				}
+				compressedSize = payload.Length;
+
+				int count = System.Math.Max((payload.Length + CHUNK_SIZE - 1) / CHUNK_SIZE, 1);
+				if (count > UInt16.MaxValue) {
+					throw new InvalidDataException($"World state is too large. ({payload.Length} bytes)");
+				}
+				for (int i = 0; i < count; ++i) {
+					int offset = i * CHUNK_SIZE;
+					int length = System.Math.Min(CHUNK_SIZE, payload.Length - offset);
+					var chunk = new Messages.WorldStateChunkMessage();
+					chunk.stateId = stateId;
+					chunk.index = (ushort)i;
+					chunk.count = (ushort)count;
+					chunk.uncompressedSize = uncompressedSize;
+					chunk.data = new byte[length];
+					Buffer.BlockCopy(payload, offset, chunk.data, 0, length);
+					encoded.Add(chunk);
+				}
+			}
+			catch (Exception e) {
+				error = e.Message;
+			}
+
+			lock (syncLock) {
+				encodeTime = watch.Elapsed.TotalMilliseconds;
+				threadError = error;
+				chunks = encoded;
+				finished = true;
+			}
+		}
+
+		/// <summary>
+		/// Compare the captured state with the player's digest. Doors and lights are removed from the message if
+		/// the world bucket matches.
+		/// </summary>
+		/// <returns>Bit mask of the differing buckets.</returns>
+		byte[] DiffWorld() {
+			var digest = new WorldDigest();
+			foreach (Messages.DoorsInitMessage door in msg.doors) {
+				digest.AddDoor(door.position.x, door.position.y, door.position.z, door.open);
+			}
+			foreach (Messages.LightSwitchMessage light in msg.lights) {
+				digest.AddLight(light.pos.x, light.pos.y, light.pos.z, light.toggle);
+			}
+			for (int i = 0; i < pickupableCount; ++i) {
+				int offset = i * WorldSnapshotWriter.TRANSFORM_STRIDE;
+				digest.AddPickupable(pickupableIds[i], prefabIds[i], transforms[offset], transforms[offset + 1], transforms[offset + 2], transforms[offset + 3], transforms[offset + 4], transforms[offset + 5], transforms[offset + 6], active[i]);
+			}
+			digest.Build();
+
+			byte[] mask;
+			differingBuckets = digest.Diff(playerDigest, out mask);
+			if (!WorldDigest.IsSet(mask, WorldDigest.WORLD_BUCKET)) {
+				msg.doors = new Messages.DoorsInitMessage[0];
+				msg.lights = new Messages.LightSwitchMessage[0];
+			}
+			msg.SyncedBuckets = mask;
+			return mask;
+		}
+
+		/// <summary>
+		/// Build the pickupable messages from the captured arrays.
+		/// </summary>
+		/// <param name="syncedBuckets">Bit mask of the buckets to send or null to send all pickupables.</param>
+		/// <returns>The pickupable messages.</returns>
+		Messages.PickupableSpawnMessage[] BuildPickupables(byte[] syncedBuckets) {
+			var pickupables = new List<Messages.PickupableSpawnMessage>(pickupableCount);
+			for (int i = 0; i < pickupableCount; ++i) {
+				if (syncedBuckets != null && !WorldDigest.IsSet(syncedBuckets, WorldDigest.GetBucket(pickupableIds[i]))) {
+					continue;
+				}
+
+				var pickupableMsg = new Messages.PickupableSpawnMessage();
+				pickupableMsg.id = pickupableIds[i];
+				pickupableMsg.prefabId = prefabIds[i];
+
+				int offset = i * WorldSnapshotWriter.TRANSFORM_STRIDE;
+				Messages.Vector3Message position = pickupableMsg.transform.position;
+				position.x = transforms[offset];
+				position.y = transforms[offset + 1];
+				position.z = transforms[offset + 2];
+				Messages.QuaternionMessage rotation = pickupableMsg.transform.rotation;
+				rotation.x = transforms[offset + 3];
+				rotation.y = transforms[offset + 4];
+				rotation.z = transforms[offset + 5];
+				rotation.w = transforms[offset + 6];
+
+				pickupableMsg.active = active[i];
+				pickupables.Add(pickupableMsg);
+			}
+			return pickupables.ToArray();
+		}
+
+		/// <summary>
+		/// Deflate the serialized state.
+		/// </summary>
+		/// <param name="serialized">The serialized state.</param>
+		/// <returns>The deflated state or null if deflating is not available.</returns>
+		byte[] Compress(byte[] serialized) {
+			try {
+				var compressed = new MemoryStream();
+				using (var deflate = new DeflateStream(compressed, CompressionMode.Compress)) {
+					deflate.Write(serialized, 0, serialized.Length);
+				}
+				return compressed.ToArray();
+			}
+			catch (Exception e) {
+				// Mono deflate depends on the native MonoPosixHelper library which may be missing.
+				compressionError = e.Message;
+				return null;
+			}
+		}
+	}
+}
@@ -0,0 +1,224 @@
+using System;
+
+namespace MSCMP.Utilities {
+	/// <summary>
+	/// Fixed size history of values with O(1) append and O(1) window minimum/maximum.
+	/// </summary>
+	/// <remarks>
+	/// Values are stored in a ring buffer so nothing is shifted when new value is pushed.
+	/// Window extrema are tracked using monotonic deques of the value sequence numbers.
+	/// </remarks>
+	class SlidingWindow {
+
+		/// <summary>
+		/// The ring buffer containing values.
+		/// </summary>
+		long[] values = null;
+
+		/// <summary>
+		/// How many values were pushed since window creation. (Sequence number of the next value)
+		/// </summary>
+		long pushed = 0;
+
+		/// <summary>
+		/// Deque of sequence numbers of the values in descending order of values.
+		/// </summary>
+		long[] maxQueue = null;
+		long maxHead = 0;
+		long maxTail = 0;
+
+		/// <summary>
+		/// Deque of sequence numbers of the values in ascending order of values.
+		/// </summary>
+		long[] minQueue = null;
+		long minHead = 0;
+		long minTail = 0;
+
+		/// <summary>
+		/// Sorted copy of the window used to calculate percentiles.
+		/// </summary>
+		long[] sortedValues = null;
+
+		/// <summary>
+		/// The value of pushed counter when sorted values were calculated. (-1 if never)
+		/// </summary>
+		long sortedVersion = -1;
+
+		/// <summary>
+		/// Maximum amount of values in the window.
+		/// </summary>
+		public int Capacity {
+			get { return values.Length; }
+		}
+
+		/// <summary>
+		/// Current amount of values in the window.
+		/// </summary>
+		public int Count {
+			get { return (int)System.Math.Min(pushed, values.Length); }
+		}
+
+		/// <summary>
+		/// The biggest value in the window. (0 if window is empty)
+		/// </summary>
+		public long Max {
+			get {
+				if (maxHead == maxTail) {
+					return 0;
+				}
+				return values[Slot(maxQueue[Slot(maxHead)])];
+			}
+		}
+
+		/// <summary>
+		/// The smallest value in the window. (0 if window is empty)
+		/// </summary>
+		public long Min {
+			get {
+				if (minHead == minTail) {
+					return 0;
+				}
+				return values[Slot(minQueue[Slot(minHead)])];
+			}
+		}
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="capacity">Maximum amount of values in the window.</param>
+		public SlidingWindow(int capacity) {
+			Allocate(capacity);
+		}
+
+		/// <summary>
+		/// Allocate window storage.
+		/// </summary>
+		/// <param name="capacity">Maximum amount of values in the window.</param>
+		void Allocate(int capacity) {
+			if (capacity < 1) {
+				throw new ArgumentOutOfRangeException("capacity");
+			}
+
+			values = new long[capacity];
+			maxQueue = new long[capacity];
+			minQueue = new long[capacity];
+			sortedValues = new long[capacity];
+
+			pushed = 0;
+			maxHead = maxTail = 0;
+			minHead = minTail = 0;
+			sortedVersion = -1;
+		}
+
+		/// <summary>
+		/// Convert sequence number into the ring buffer slot.
+		/// </summary>
+		/// <param name="sequence">The sequence number.</param>
+		/// <returns>The slot in ring buffer.</returns>
+		int Slot(long sequence) {
+			return (int)(sequence % values.Length);
+		}
+
+		/// <summary>
+		/// Push new value into the window, dropping the oldest one if window is full.
+		/// </summary>
+		/// <param name="value">The value to push.</param>
+		public void Push(long value) {
+			long sequence = pushed;
+			long expired = sequence - values.Length;
+			values[Slot(sequence)] = value;
+
+			// Remove values that are leaving the window.
+
+			while (maxHead < maxTail && maxQueue[Slot(maxHead)] <= expired) {
+				++maxHead;
+			}
+			while (minHead < minTail && minQueue[Slot(minHead)] <= expired) {
+				++minHead;
+			}
+
+			// Values dominated by the new one can never become extrema again.
+
+			while (maxHead < maxTail && values[Slot(maxQueue[Slot(maxTail - 1)])] <= value) {
+				--maxTail;
+			}
+			maxQueue[Slot(maxTail++)] = sequence;
+
+			while (minHead < minTail && values[Slot(minQueue[Slot(minTail - 1)])] >= value) {
+				--minTail;
+			}
+			minQueue[Slot(minTail++)] = sequence;
+
+			++pushed;
+		}
+
+		/// <summary>
+		/// Get value from the window.
+		/// </summary>
+		/// <param name="index">Index of the value counting from the oldest one.</param>
+		/// <returns>The value.</returns>
+		public long GetFromOldest(int index) {
+			long first = pushed - Count;
+			return values[Slot(first + index)];
+		}
+
+		/// <summary>
+		/// Get the latest pushed value. (0 if window is empty)
+		/// </summary>
+		/// <returns>The latest value.</returns>
+		public long GetLatest() {
+			if (pushed == 0) {
+				return 0;
+			}
+			return values[Slot(pushed - 1)];
+		}
+
+		/// <summary>
+		/// Get percentile of the values in the window.
+		/// </summary>
+		/// <remarks>
+		/// Window is sorted lazily at most once per pushed value, so this is meant for display and reports - not for hot paths.
+		/// </remarks>
+		/// <param name="percentile">The percentile in 0-100 range.</param>
+		/// <returns>The value at given percentile (nearest rank) or 0 if window is empty.</returns>
+		public long Percentile(float percentile) {
+			int count = Count;
+			if (count == 0) {
+				return 0;
+			}
+
+			if (sortedVersion != pushed) {
+				for (int i = 0; i < count; ++i) {
+					sortedValues[i] = GetFromOldest(i);
+				}
+				Array.Sort(sortedValues, 0, count);
+				sortedVersion = pushed;
+			}
+
+			int rank = (int)System.Math.Ceiling(percentile / 100.0f * count) - 1;
+			rank = System.Math.Max(0, System.Math.Min(count - 1, rank));
+			return sortedValues[rank];
+		}
+
+		/// <summary>
+		/// Change capacity of the window keeping the newest values.
+		/// </summary>
+		/// <param name="capacity">New maximum amount of values in the window.</param>
+		public void Resize(int capacity) {
+			if (capacity == values.Length) {
+				return;
+			}
+
+			int keep = System.Math.Min(Count, capacity);
+			long[] kept = new long[keep];
+			for (int i = 0; i < keep; ++i) {
+				kept[i] = GetFromOldest(Count - keep + i);
+			}
+
+			Allocate(capacity);
+			foreach (long value in kept) {
+				Push(value);
+			}
+		}
+	}
+}
@@ -0,0 +1,333 @@
+using System;
+using System.Collections.Generic;
+
+namespace MSCMP.Utilities {
+	/// <summary>
+	/// Map of values addressed by generational ids with O(1) insert, lookup and removal.
+	/// </summary>
+	/// <remarks>
+	/// Id consists of slot index (+1, so that zero is never valid id) in the lower INDEX_BITS bits and of
+	/// the slot generation in the bits above. Generation is increased every time slot is freed so ids of
+	/// removed values never match value that reuses the slot later.
+	///
+	/// Values are kept in dense array (removal swaps the last value into the hole) so iteration over them
+	/// touches only live values.
+	///
+	/// Allocation is deterministic - two maps on which the same sequence of operations was performed
+	/// allocate the same ids. Ids allocated by one map can be inserted into another one using Insert.
+	/// </remarks>
+	/// <typeparam name="T">Type of the values.</typeparam>
+	class SlotMap<T> where T : class {
+
+		/// <summary>
+		/// Amount of bits used for the slot index.
+		/// </summary>
+		public const int INDEX_BITS = 20;
+
+		/// <summary>
+		/// Mask of the slot index part of id.
+		/// </summary>
+		public const int INDEX_MASK = (1 << INDEX_BITS) - 1;
+
+		/// <summary>
+		/// Maximum amount of slots.
+		/// </summary>
+		public const int MAX_SLOTS = INDEX_MASK;
+
+		/// <summary>
+		/// Mask of the generation part of id. (Keeps ids positive)
+		/// </summary>
+		public const int GENERATION_MASK = (1 << (31 - INDEX_BITS)) - 1;
+
+		/// <summary>
+		/// Id that is never valid.
+		/// </summary>
+		public const int INVALID_ID = 0;
+
+		/// <summary>
+		/// Current generation of each slot.
+		/// </summary>
+		int[] generations = new int[16];
+
+		/// <summary>
+		/// Position of each slot's value in the dense array. (-1 if slot is free)
+		/// </summary>
+		int[] slotToDense = new int[16];
+
+		/// <summary>
+		/// Dense array of values.
+		/// </summary>
+		T[] values = new T[16];
+
+		/// <summary>
+		/// Ids of the values in dense array.
+		/// </summary>
+		int[] denseToId = new int[16];
+
+		/// <summary>
+		/// Amount of values.
+		/// </summary>
+		int count = 0;
+
+		/// <summary>
+		/// Amount of slots ever used.
+		/// </summary>
+		int slotCount = 0;
+
+		/// <summary>
+		/// Free slots in the order they were freed. Reusing the oldest freed slot first delays generation wrap.
+		/// </summary>
+		/// <remarks>
+		/// Slot can be taken by Insert while it is in the queue, such entries are skipped when allocating.
+		/// </remarks>
+		Queue<int> freeSlots = new Queue<int>();
+
+		/// <summary>
+		/// Amount of values.
+		/// </summary>
+		public int Count {
+			get { return count; }
+		}
+
+		/// <summary>
+		/// Build id from slot index and generation.
+		/// </summary>
+		/// <param name="index">The slot index.</param>
+		/// <param name="generation">The slot generation.</param>
+		/// <returns>The id.</returns>
+		public static int MakeId(int index, int generation) {
+			return ((generation & GENERATION_MASK) << INDEX_BITS) | (index + 1);
+		}
+
+		/// <summary>
+		/// Get slot index from id.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <returns>Slot index or -1 if id is invalid.</returns>
+		public static int GetIndex(int id) {
+			if (id <= 0) {
+				return -1;
+			}
+			return (id & INDEX_MASK) - 1;
+		}
+
+		/// <summary>
+		/// Get generation from id.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <returns>The generation.</returns>
+		public static int GetGeneration(int id) {
+			return (id >> INDEX_BITS) & GENERATION_MASK;
+		}
+
+		/// <summary>
+		/// Add value to the map under newly allocated id.
+		/// </summary>
+		/// <param name="value">The value to add.</param>
+		/// <returns>The id of the value.</returns>
+		public int Add(T value) {
+			int index = -1;
+			while (freeSlots.Count > 0) {
+				int freeIndex = freeSlots.Dequeue();
+				if (slotToDense[freeIndex] == -1) {
+					index = freeIndex;
+					break;
+				}
+			}
+
+			if (index == -1) {
+				if (slotCount >= MAX_SLOTS) {
+					throw new InvalidOperationException("Slot map is full.");
+				}
+				index = slotCount;
+				GrowSlots(index + 1);
+			}
+
+			int id = MakeId(index, generations[index]);
+			Place(index, id, value);
+			return id;
+		}
+
+		/// <summary>
+		/// Put value into the map under id allocated elsewhere. Value occupying the slot of the id is replaced.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <param name="value">The value.</param>
+		/// <param name="replaced">The value that occupied the slot (of any generation) or default if it was free.</param>
+		/// <returns>true if value was inserted, false if id is invalid.</returns>
+		public bool Insert(int id, T value, out T replaced) {
+			replaced = default(T);
+			int index = GetIndex(id);
+			if (index < 0 || index >= MAX_SLOTS) {
+				return false;
+			}
+
+			if (index >= slotCount) {
+				int oldSlotCount = slotCount;
+				GrowSlots(index + 1);
+				// Slots skipped over are free.
+				for (int i = oldSlotCount; i < index; ++i) {
+					freeSlots.Enqueue(i);
+				}
+			}
+
+			generations[index] = GetGeneration(id);
+
+			int dense = slotToDense[index];
+			if (dense != -1) {
+				replaced = values[dense];
+				values[dense] = value;
+				denseToId[dense] = id;
+			}
+			else {
+				Place(index, id, value);
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Remove value with the given id.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <returns>true if value was removed, false if there is no value with such id.</returns>
+		public bool Remove(int id) {
+			int index = GetIndex(id);
+			if (!IsLive(index, id)) {
+				return false;
+			}
+
+			int dense = slotToDense[index];
+			int last = count - 1;
+			if (dense != last) {
+				values[dense] = values[last];
+				denseToId[dense] = denseToId[last];
+				slotToDense[GetIndex(denseToId[dense])] = dense;
+			}
+			values[last] = null;
+			count--;
+
+			slotToDense[index] = -1;
+			generations[index] = (generations[index] + 1) & GENERATION_MASK;
+			freeSlots.Enqueue(index);
+			return true;
+		}
+
+		/// <summary>
+		/// Remove all values and reset the map to the state it had after construction, so the next allocated
+		/// ids match ids allocated by a new map.
+		/// </summary>
+		public void Clear() {
+			Array.Clear(values, 0, count);
+			Array.Clear(generations, 0, slotCount);
+			count = 0;
+			slotCount = 0;
+			freeSlots.Clear();
+		}
+
+		/// <summary>
+		/// Check if map contains value with the given id.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <returns>true if the id is live.</returns>
+		public bool Contains(int id) {
+			return IsLive(GetIndex(id), id);
+		}
+
+		/// <summary>
+		/// Get value with the given id.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <param name="value">The value or null if there is no value with such id.</param>
+		/// <returns>true if the value was found.</returns>
+		public bool TryGetValue(int id, out T value) {
+			int index = GetIndex(id);
+			if (!IsLive(index, id)) {
+				value = null;
+				return false;
+			}
+			value = values[slotToDense[index]];
+			return true;
+		}
+
+		/// <summary>
+		/// Get value with the given id.
+		/// </summary>
+		/// <param name="id">The id.</param>
+		/// <returns>The value or null if there is no value with such id. (e.g. id is stale)</returns>
+		public T Get(int id) {
+			int index = GetIndex(id);
+			if (!IsLive(index, id)) {
+				return null;
+			}
+			return values[slotToDense[index]];
+		}
+
+		/// <summary>
+		/// Get value at the given position of the dense array. Used for iteration.
+		/// </summary>
+		/// <param name="denseIndex">Position in range [0, Count).</param>
+		/// <returns>The value.</returns>
+		public T GetAt(int denseIndex) {
+			return values[denseIndex];
+		}
+
+		/// <summary>
+		/// Get id of the value at the given position of the dense array.
+		/// </summary>
+		/// <param name="denseIndex">Position in range [0, Count).</param>
+		/// <returns>The id.</returns>
+		public int GetIdAt(int denseIndex) {
+			return denseToId[denseIndex];
+		}
+
+		/// <summary>
+		/// Check if the slot is occupied by value with the given id.
+		/// </summary>
+		/// <param name="index">The slot index.</param>
+		/// <param name="id">The id.</param>
+		/// <returns>true if slot is occupied by the id.</returns>
+		bool IsLive(int index, int id) {
+			if (index < 0 || index >= slotCount) {
+				return false;
+			}
+			int dense = slotToDense[index];
+			return dense != -1 && denseToId[dense] == id;
+		}
+
+		/// <summary>
+		/// Put value into the free slot.
+		/// </summary>
+		/// <param name="index">The slot index.</param>
+		/// <param name="id">The id of the value.</param>
+		/// <param name="value">The value.</param>
+		void Place(int index, int id, T value) {
+			if (count == values.Length) {
+				Array.Resize(ref values, count * 2);
+				Array.Resize(ref denseToId, count * 2);
+			}
+			values[count] = value;
+			denseToId[count] = id;
+			slotToDense[index] = count;
+			count++;
+		}
+
+		/// <summary>
+		/// Make sure there is at least the given amount of slots. New slots are free.
+		/// </summary>
+		/// <param name="newSlotCount">The amount of slots.</param>
+		void GrowSlots(int newSlotCount) {
+			if (newSlotCount > generations.Length) {
+				int capacity = generations.Length;
+				while (capacity < newSlotCount) {
+					capacity *= 2;
+				}
+				Array.Resize(ref generations, capacity);
+				Array.Resize(ref slotToDense, capacity);
+			}
+			for (int i = slotCount; i < newSlotCount; ++i) {
+				slotToDense[i] = -1;
+			}
+			slotCount = newSlotCount;
+		}
+	}
+}
@@ -1,14 +1,26 @@
 namespace MSCMPMessages.Messages {
 	[NetMessageDesc(MessageIds.AnimSync)]
 	class AnimSyncMessage {
-		bool	isRunning;
-		bool	isLeaning;
-		bool	isGrounded;
-		byte	activeHandState;
-		float	aimRot;
-		float	crouchPosition;
-		bool	isDrunk;
-		byte	drinkId;
-		int 	swearId;
+		/// <summary>
+		/// Bit packed discrete animation state. (See PlayerAnimState)
+		/// </summary>
+		ushort	state;
+
+		/// <summary>
+		/// Quantized vertical aim and crouch position. (See PlayerAnimState)
+		/// </summary>
+		byte	aimRot;
+		byte	crouchPosition;
+
+		/// <summary>
+		/// Swear or speech being played. (Not sent when there is none)
+		/// </summary>
+		[Optional]
+		ushort	swearId;
+
+		/// <summary>
+		/// Sender's network clock when the state was taken. (See NetManager.ClockToTick)
+		/// </summary>
+		ushort	tick;
 	}
 }
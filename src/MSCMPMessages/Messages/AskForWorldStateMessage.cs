@@ -1,5 +1,10 @@
 namespace MSCMPMessages.Messages {
 	[NetMessageDesc(MessageIds.AskForWorldState)]
 	class AskForWorldStateMessage {
+		/// <summary>
+		/// Bucket hashes of the player's world. (See WorldDigest, the host sends only the differing buckets)
+		/// </summary>
+		[Optional]
+		uint[]	digest;
 	}
 }
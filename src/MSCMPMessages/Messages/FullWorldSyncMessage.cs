@@ -10,6 +10,10 @@
 		TransformMessage transform;
 	}
 
+	/// <summary>
+	/// World state of the host. Not sent on its own, it is serialized into the WorldStateChunkMessages.
+	/// (See WorldStateEncoder)
+	/// </summary>
 	[NetMessageDesc(MessageIds.FullWorldSync)]
 	class FullWorldSyncMessage {
 		string						mailboxName;
@@ -28,5 +32,12 @@
 		byte occupiedVehicleId;
 		bool passenger;
 		ushort pickedUpObject;
+
+		/// <summary>
+		/// Bit mask of the world digest buckets in the message. Only the pickupables of these buckets are sent,
+		/// doors and lights are sent only with the world bucket. (Whole world is sent if not set)
+		/// </summary>
+		[Optional]
+		byte[] syncedBuckets;
 	}
 }
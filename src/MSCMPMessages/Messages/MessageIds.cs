@@ -30,5 +30,7 @@ namespace MSCMPMessages.Messages {
 		ObjectSyncResponse,
 		EventHookSync,
 		RequestObjectSync,
+		ObjectSnapshot,
+		WorldStateChunk,
 	}
 }
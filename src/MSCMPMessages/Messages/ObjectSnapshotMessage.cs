@@ -0,0 +1,19 @@
+﻿namespace MSCMPMessages.Messages {
+	[NetMessageDesc(MessageIds.ObjectSnapshot)]
+	class ObjectSnapshotMessage {
+		/// <summary>
+		/// Amount of objects in the snapshot.
+		/// </summary>
+		int		objectCount;
+
+		/// <summary>
+		/// States of the objects encoded by ObjectSnapshotWriter.
+		/// </summary>
+		byte[]	data;
+
+		/// <summary>
+		/// Sender's network clock when the states were taken. (See NetManager.ClockToTick)
+		/// </summary>
+		ushort	tick;
+	}
+}
@@ -11,6 +11,23 @@
 		int syncType;
 
 		[Optional]
-		float[] syncedVariables;
+		byte[] syncedVariables;
+
+		[Optional]
+		Vector3Message velocity;
+
+		[Optional]
+		Vector3Message angularVelocity;
+
+		/// <summary>
+		/// Shared clock time of the ownership claim. (SetOwner and ForceSetOwner only)
+		/// </summary>
+		[Optional]
+		ulong claimTime;
+
+		/// <summary>
+		/// Sender's network clock when the state was taken. (See NetManager.ClockToTick)
+		/// </summary>
+		ushort tick;
 	}
 }
@@ -4,5 +4,17 @@
 
 		int objectID;
 		bool accepted;
+
+		/// <summary>
+		/// Claim of the current owner. (Sent when the claim was rejected)
+		/// </summary>
+		[Optional]
+		ulong claimOwner;
+
+		[Optional]
+		ulong claimTime;
+
+		[Optional]
+		bool forceClaim;
 	}
 }
@@ -12,5 +12,10 @@ namespace MSCMPMessages.Messages {
 
 		[Optional]
 		PickedUpSync		 pickedUpData;
+
+		/// <summary>
+		/// Sender's network clock when the state was taken. (See NetManager.ClockToTick)
+		/// </summary>
+		ushort				tick;
 	}
 }
@@ -0,0 +1,22 @@
+﻿namespace MSCMPMessages.Messages {
+	[NetMessageDesc(MessageIds.WorldStateChunk)]
+	class WorldStateChunkMessage {
+		/// <summary>
+		/// Id of the transfer the chunk belongs to. (Chunks of the other transfers are dropped)
+		/// </summary>
+		byte	stateId;
+
+		ushort	index;
+		ushort	count;
+
+		/// <summary>
+		/// Size of the serialized FullWorldSyncMessage once inflated or 0 if the data is not compressed.
+		/// </summary>
+		int		uncompressedSize;
+
+		/// <summary>
+		/// Part of the serialized FullWorldSyncMessage. (See WorldStateEncoder)
+		/// </summary>
+		byte[]	data;
+	}
+}
@@ -0,0 +1,198 @@
+using System;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Threading;
+using MSCMP.Network;
+
+namespace MSCMPReplay {
+	/// <summary>
+	/// Offline replay of the network captures created by the client. (see NetCapture)
+	/// </summary>
+	class Program {
+
+		/// <summary>
+		/// The protocol id every MSCMP packet starts with. (Must match NetManager.PROTOCOL_ID)
+		/// </summary>
+		const uint PROTOCOL_ID = 0x6d73636d;
+
+		/// <summary>
+		/// Size of the packet header. (protocol id + message id)
+		/// </summary>
+		const int PACKET_HEADER_SIZE = 5;
+
+		/// <summary>
+		/// The report the stub handlers are reporting to.
+		/// </summary>
+		static ReplayReport report = new ReplayReport();
+
+		static int Main(string[] args) {
+			string capturePath = null;
+			double speed = 0.0;
+			bool replayIncoming = true;
+			bool replayOutgoing = true;
+
+			for (int i = 0; i < args.Length; ++i) {
+				switch (args[i]) {
+					case "--speed": {
+						if (i + 1 >= args.Length || !double.TryParse(args[++i], System.Globalization.NumberStyles.Float, System.Globalization.CultureInfo.InvariantCulture, out speed) || speed < 0.0) {
+							return PrintUsage();
+						}
+						break;
+					}
+
+					case "--direction": {
+						if (i + 1 >= args.Length) {
+							return PrintUsage();
+						}
+						string direction = args[++i];
+						replayIncoming = direction == "in" || direction == "both";
+						replayOutgoing = direction == "out" || direction == "both";
+						if (!replayIncoming && !replayOutgoing) {
+							return PrintUsage();
+						}
+						break;
+					}
+
+					case "--verbose": {
+						MSCMP.Logger.Verbose = true;
+						break;
+					}
+
+					default: {
+						if (capturePath != null || args[i].StartsWith("--")) {
+							return PrintUsage();
+						}
+						capturePath = args[i];
+						break;
+					}
+				}
+			}
+
+			if (capturePath == null) {
+				return PrintUsage();
+			}
+
+			var netManager = new NetManager();
+			var messageHandler = new NetMessageHandler(netManager);
+			int boundMessages = BindStubHandlers(messageHandler);
+
+			try {
+				using (var stream = new FileStream(capturePath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite)) {
+					DateTime startTime;
+					BinaryReader reader = NetCapture.OpenForReading(stream, out startTime);
+					Console.WriteLine($"Replaying {capturePath} captured at {startTime.ToLocalTime()} ({(speed > 0.0 ? $"{speed}x speed" : "as fast as possible")}, {boundMessages} message types)");
+
+					Replay(reader, messageHandler, speed, replayIncoming, replayOutgoing);
+				}
+			}
+			catch (Exception e) {
+				Console.WriteLine($"Failed to replay capture: {e.Message}");
+				return 1;
+			}
+
+			Console.WriteLine();
+			report.Print(netManager.Statistics);
+			if (MSCMP.Logger.MessagesLogged > 0) {
+				Console.WriteLine();
+				Console.WriteLine($"{MSCMP.Logger.MessagesLogged} messages were logged by the message handler. (use --verbose to print them)");
+			}
+			return 0;
+		}
+
+		/// <summary>
+		/// Print usage of the tool.
+		/// </summary>
+		/// <returns>Exit code.</returns>
+		static int PrintUsage() {
+			Console.WriteLine("Usage: MSCMPReplay <capture.mscap> [--speed <factor>] [--direction in|out|both] [--verbose]");
+			Console.WriteLine("  --speed      Replay speed, 1 is real time, 0 (default) replays as fast as possible.");
+			Console.WriteLine("  --direction  Which captured packets to replay. (default both)");
+			Console.WriteLine("  --verbose    Print messages logged by the message handler.");
+			return 1;
+		}
+
+		/// <summary>
+		/// Replay all records from the capture.
+		/// </summary>
+		/// <param name="reader">The capture reader.</param>
+		/// <param name="messageHandler">The message handler to feed messages to.</param>
+		/// <param name="speed">Replay speed factor. (0 means as fast as possible)</param>
+		/// <param name="replayIncoming">Should incoming packets be replayed?</param>
+		/// <param name="replayOutgoing">Should outgoing packets be replayed?</param>
+		static void Replay(BinaryReader reader, NetMessageHandler messageHandler, double speed, bool replayIncoming, bool replayOutgoing) {
+			var clock = Stopwatch.StartNew();
+			var sender = new Steamworks.CSteamID(0);
+
+			NetCapture.Record record;
+			while ((record = NetCapture.ReadRecord(reader)) != null) {
+				report.DurationMs = record.time;
+
+				bool incoming = record.direction == NetCapture.Direction.Incoming;
+				if ((incoming && !replayIncoming) || (!incoming && !replayOutgoing)) {
+					continue;
+				}
+
+				if (speed > 0.0) {
+					long waitMs = (long)(record.time / speed) - clock.ElapsedMilliseconds;
+					if (waitMs > 0) {
+						Thread.Sleep((int)waitMs);
+					}
+				}
+
+				if (record.data.Length < PACKET_HEADER_SIZE || BitConverter.ToUInt32(record.data, 0) != PROTOCOL_ID) {
+					report.InvalidPackets++;
+					continue;
+				}
+
+				byte messageId = record.data[4];
+				var entry = report.GetEntry(record.direction, messageId);
+
+				var messageReader = new BinaryReader(new MemoryStream(record.data, PACKET_HEADER_SIZE, record.data.Length - PACKET_HEADER_SIZE));
+
+				report.Current = entry;
+				long start = Stopwatch.GetTimestamp();
+				messageHandler.ProcessMessage(messageId, sender, messageReader);
+				long handlerTicks = Stopwatch.GetTimestamp() - start;
+				report.Current = null;
+
+				report.Record(entry, record.data.Length, handlerTicks);
+			}
+		}
+
+		/// <summary>
+		/// Bind stub handler for every generated network message.
+		/// </summary>
+		/// <param name="messageHandler">The message handler to bind stubs to.</param>
+		/// <returns>Amount of bound message types.</returns>
+		static int BindStubHandlers(NetMessageHandler messageHandler) {
+			MethodInfo bindMethod = typeof(NetMessageHandler).GetMethod("BindMessageHandler");
+			MethodInfo stubMethod = typeof(Program).GetMethod("StubHandler", BindingFlags.NonPublic | BindingFlags.Static);
+
+			int bound = 0;
+			foreach (Type type in typeof(INetMessage).Assembly.GetTypes()) {
+				if (type.Namespace != "MSCMP.Network.Messages" || !type.IsClass || !typeof(INetMessage).IsAssignableFrom(type)) {
+					continue;
+				}
+
+				Type handlerType = typeof(NetMessageHandler.MessageHandler<>).MakeGenericType(type);
+				Delegate handler = Delegate.CreateDelegate(handlerType, stubMethod.MakeGenericMethod(type));
+				bindMethod.MakeGenericMethod(type).Invoke(messageHandler, new object[] { handler });
+				bound++;
+			}
+			return bound;
+		}
+
+		/// <summary>
+		/// Stub handler of the network message. Only reports that message was successfully decoded.
+		/// </summary>
+		/// <typeparam name="T">The type of the message.</typeparam>
+		/// <param name="sender">The sender of the message.</param>
+		/// <param name="message">The decoded message.</param>
+		static void StubHandler<T>(Steamworks.CSteamID sender, T message) where T : INetMessage {
+			if (report.Current != null) {
+				report.Current.handled++;
+			}
+		}
+	}
+}
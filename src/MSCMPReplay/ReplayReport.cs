@@ -0,0 +1,143 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using MSCMP.Network;
+
+namespace MSCMPReplay {
+	/// <summary>
+	/// Statistics of the replayed packets grouped by direction and message type.
+	/// </summary>
+	class ReplayReport {
+
+		/// <summary>
+		/// Upper bounds (exclusive) of the packet size histogram buckets. The last bucket contains everything bigger.
+		/// </summary>
+		static readonly int[] SIZE_BUCKETS = { 16, 32, 64, 128, 256, 512, 1024, 4096 };
+
+		/// <summary>
+		/// Statistics of single message type in single direction.
+		/// </summary>
+		public class Entry {
+			public NetCapture.Direction direction;
+			public byte messageId;
+			public long count = 0;
+			public long handled = 0;
+			public long bytes = 0;
+			public int minSize = int.MaxValue;
+			public int maxSize = 0;
+			public long[] sizeHistogram = new long[SIZE_BUCKETS.Length + 1];
+			public long handlerTicks = 0;
+			public long maxHandlerTicks = 0;
+		}
+
+		/// <summary>
+		/// Entries indexed by direction * 256 + message id.
+		/// </summary>
+		Entry[] entries = new Entry[2 * 256];
+
+		/// <summary>
+		/// Packets which could not be decoded at all. (Too short or with wrong protocol id)
+		/// </summary>
+		public long InvalidPackets = 0;
+
+		/// <summary>
+		/// Capture duration in milliseconds.
+		/// </summary>
+		public uint DurationMs = 0;
+
+		/// <summary>
+		/// The entry receiving handler callbacks for the packet being currently replayed.
+		/// </summary>
+		public Entry Current = null;
+
+		/// <summary>
+		/// Get entry for the given direction and message.
+		/// </summary>
+		/// <param name="direction">The direction.</param>
+		/// <param name="messageId">The message id.</param>
+		/// <returns>The entry.</returns>
+		public Entry GetEntry(NetCapture.Direction direction, byte messageId) {
+			int index = (int)direction * 256 + messageId;
+			if (entries[index] == null) {
+				var entry = new Entry();
+				entry.direction = direction;
+				entry.messageId = messageId;
+				entries[index] = entry;
+			}
+			return entries[index];
+		}
+
+		/// <summary>
+		/// Record replayed packet.
+		/// </summary>
+		/// <param name="entry">The entry of the packet.</param>
+		/// <param name="size">Size of the packet in bytes.</param>
+		/// <param name="handlerTicks">Time spent in message handler in stopwatch ticks.</param>
+		public void Record(Entry entry, int size, long handlerTicks) {
+			entry.count++;
+			entry.bytes += size;
+			entry.minSize = Math.Min(entry.minSize, size);
+			entry.maxSize = Math.Max(entry.maxSize, size);
+
+			int bucket = 0;
+			while (bucket < SIZE_BUCKETS.Length && size >= SIZE_BUCKETS[bucket]) {
+				++bucket;
+			}
+			entry.sizeHistogram[bucket]++;
+
+			entry.handlerTicks += handlerTicks;
+			entry.maxHandlerTicks = Math.Max(entry.maxHandlerTicks, handlerTicks);
+		}
+
+		/// <summary>
+		/// Convert stopwatch ticks to microseconds.
+		/// </summary>
+		/// <param name="ticks">The ticks.</param>
+		/// <returns>Microseconds.</returns>
+		static double ToMicroseconds(double ticks) {
+			return ticks * 1000000.0 / Stopwatch.Frequency;
+		}
+
+		/// <summary>
+		/// Print report to the console.
+		/// </summary>
+		/// <param name="statistics">Statistics object containing message names.</param>
+		public void Print(NetStatistics statistics) {
+			double seconds = Math.Max(DurationMs / 1000.0, 0.001);
+			Console.WriteLine($"Capture duration: {seconds:0.00} s, invalid packets: {InvalidPackets}");
+			Console.WriteLine();
+
+			Console.WriteLine($"{"dir",-4}{"message",-24}{"count",9}{"handled",9}{"rate/s",9}{"bytes",11}{"B/s",9}{"avg B",7}{"min B",7}{"max B",7}{"avg us",9}{"max us",9}");
+			foreach (Entry entry in entries) {
+				if (entry == null) {
+					continue;
+				}
+
+				string direction = entry.direction == NetCapture.Direction.Incoming ? "in" : "out";
+				Console.WriteLine($"{direction,-4}{statistics.GetMessageName(entry.messageId),-24}{entry.count,9}{entry.handled,9}{entry.count / seconds,9:0.0}{entry.bytes,11}{entry.bytes / seconds,9:0}{(double)entry.bytes / entry.count,7:0}{entry.minSize,7}{entry.maxSize,7}{ToMicroseconds((double)entry.handlerTicks / entry.count),9:0.0}{ToMicroseconds(entry.maxHandlerTicks),9:0.0}");
+			}
+
+			Console.WriteLine();
+			Console.WriteLine("Size histogram (packets per size bucket in bytes):");
+
+			string header = $"{"dir",-4}{"message",-24}";
+			for (int i = 0; i <= SIZE_BUCKETS.Length; ++i) {
+				string label = i < SIZE_BUCKETS.Length ? $"<{SIZE_BUCKETS[i]}" : $">={SIZE_BUCKETS[SIZE_BUCKETS.Length - 1]}";
+				header += $"{label,8}";
+			}
+			Console.WriteLine(header);
+
+			foreach (Entry entry in entries) {
+				if (entry == null) {
+					continue;
+				}
+
+				string line = $"{(entry.direction == NetCapture.Direction.Incoming ? "in" : "out"),-4}{statistics.GetMessageName(entry.messageId),-24}";
+				foreach (long bucketCount in entry.sizeHistogram) {
+					line += $"{bucketCount,8}";
+				}
+				Console.WriteLine(line);
+			}
+		}
+	}
+}
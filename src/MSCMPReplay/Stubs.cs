@@ -0,0 +1,92 @@
+using System;
+using System.Collections.Generic;
+
+// Minimal stand-ins for the game side types used by the network files linked from MSCMPClient.
+// They allow decoding messages and running them through NetMessageHandler without Unity and Steam.
+
+namespace Steamworks {
+	/// <summary>
+	/// Steam id stub.
+	/// </summary>
+	public struct CSteamID {
+		public ulong m_SteamID;
+
+		public static readonly CSteamID Nil = new CSteamID();
+
+		public CSteamID(ulong steamId) {
+			m_SteamID = steamId;
+		}
+
+		public override string ToString() {
+			return m_SteamID.ToString();
+		}
+	}
+}
+
+namespace MSCMP {
+	/// <summary>
+	/// Logger stub - counts errors reported by the linked code and prints them when verbose.
+	/// </summary>
+	static class Logger {
+		/// <summary>
+		/// Should log messages be printed?
+		/// </summary>
+		public static bool Verbose = false;
+
+		/// <summary>
+		/// How many messages were logged.
+		/// </summary>
+		public static int MessagesLogged = 0;
+
+		public static void Log(string message) {
+			MessagesLogged++;
+			if (Verbose) {
+				Console.WriteLine(message);
+			}
+		}
+
+		public static void Warning(string message) {
+			Log("[WARN] " + message);
+		}
+
+		public static void Error(string message) {
+			Log("[ERROR] " + message);
+		}
+
+		public static void Debug(string message) {
+			Log("[DEBUG] " + message);
+		}
+	}
+}
+
+namespace MSCMP.Network {
+	/// <summary>
+	/// Network statistics stub - only keeps message names registered by the message handler.
+	/// </summary>
+	class NetStatistics {
+		Dictionary<int, string> messageNames = new Dictionary<int, string>();
+
+		public void RegisterMessageName(int messageId, string name) {
+			messageNames[messageId] = name;
+		}
+
+		public string GetMessageName(int messageId) {
+			string name;
+			if (messageNames.TryGetValue(messageId, out name)) {
+				return name;
+			}
+			return messageId.ToString();
+		}
+	}
+
+	/// <summary>
+	/// Network manager stub.
+	/// </summary>
+	class NetManager {
+		NetStatistics statistics = new NetStatistics();
+
+		public NetStatistics Statistics {
+			get { return statistics; }
+		}
+	}
+}